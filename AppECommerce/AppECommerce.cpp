@@ -1,16 +1,23 @@
+#include <filesystem>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <thread>
 #include <vector>
 #include <format>
 
+#include "CoarseClock.h"
 #include "ProductService.h"
 #include "FakeDatabase.h"
 #include "ProductCache.h"
 #include "Logger.h"
+#include "Metrics.h"
 
-void simulateProductFetch(const std::shared_ptr<ProductService>& productService, uint64_t productId) {
-    auto product = productService->getProductDetails(productId);
+constexpr uint64_t REQUEST_COUNT = 800;
+constexpr size_t CLIENT_COUNT = 8;
+constexpr const char* CACHE_SNAPSHOT = "AppCache.snapshot";
+
+void printProduct(const std::shared_ptr<const Product>& product) {
     if (product) {
         std::cout << std::format(
             "Product ID: {}\n"
@@ -26,20 +33,60 @@ void simulateProductFetch(const std::shared_ptr<ProductService>& productService,
     }
 }
 
+// Each client issues its share of the requests without waiting on any of them,
+// then collects the results; only the service's executor talks to the database.
+void runClient(const std::shared_ptr<ProductService>& productService, size_t client) {
+    std::vector<std::shared_future<std::shared_ptr<const Product>>> pending;
+    for (uint64_t productId = client + 1; productId <= REQUEST_COUNT; productId += CLIENT_COUNT) {
+        pending.push_back(productService->getProductDetailsAsync(productId));
+    }
+
+    for (auto& product : pending) {
+        try {
+            printProduct(product.get());
+        }
+        catch (const std::exception& e) {
+            std::cout << std::format("Request failed: {}\n", e.what());
+        }
+    }
+}
+
 int main() {
     Logger::initialize("AppOutput.log");
     Logger::setLogLevel(LogLevel::INFO);
+    Logger::enableAsync();
+    // Cache timestamps and expiry checks read the ticker instead of steady_clock
+    CoarseClock::start();
 
     auto cache = std::make_shared<ProductCache>(3);
+    // Start with the products that were hot when the previous run shut down
+    if (std::filesystem::exists(CACHE_SNAPSHOT)) {
+        try {
+            std::cout << std::format("Restored {} products from {}\n", cache->loadSnapshot(CACHE_SNAPSHOT), CACHE_SNAPSHOT);
+        }
+        catch (const std::exception& e) {
+            std::cout << std::format("Ignoring cache snapshot: {}\n", e.what());
+        }
+    }
     auto database = std::make_shared<FakeDatabase>();
-    auto productService = std::make_shared<ProductService>(cache, database);
+    auto productService = std::make_shared<ProductService>(cache, database,
+        ExecutorOptions{ 4, 256, ExecutorOverflowPolicy::BLOCK });
 
-    std::vector<std::jthread> threads;
-
-    // Simulate product fetches in parallel using multiple threads
-    for (uint64_t i = 1; i <= 800; ++i) {
-        threads.emplace_back(simulateProductFetch, productService, i);
+    {
+        // A fixed pool of clients instead of one thread per request
+        std::vector<std::jthread> clients;
+        for (size_t client = 0; client < CLIENT_COUNT; ++client) {
+            clients.emplace_back(runClient, productService, client);
+        }
     }
 
+    cache->saveSnapshot(CACHE_SNAPSHOT);
+    PrometheusExporter::writeToFile("AppMetrics.prom",
+        PrometheusExporter::format("product_cache", cache->getMetrics()) +
+        PrometheusExporter::format("product_service", productService->getMetrics()));
+
+    // All client threads have joined; write out whatever is still queued
+    Logger::shutdown();
+    CoarseClock::stop();
     return 0;
 }
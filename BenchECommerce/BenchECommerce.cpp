@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include "CoarseClock.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    Logger::initialize("BenchOutput.log");
+    // Keep the log file out of the measurements; only failures are written.
+    Logger::setLogLevel(LogLevel::ERROR);
+    // Measure the caches with the clock the app runs them with.
+    CoarseClock::start();
+
+    // Results are always written as JSON too, so runs can be compared with
+    // Google Benchmark's tools/compare.py. An explicit --benchmark_out wins.
+    std::vector<char*> args(argv, argv + argc);
+    const bool hasOutput = std::ranges::any_of(args, [](std::string_view arg) { return arg.starts_with("--benchmark_out="); });
+    char defaultOutput[] = "--benchmark_out=BenchResults.json";
+    char defaultFormat[] = "--benchmark_out_format=json";
+    if (!hasOutput) {
+        args.push_back(defaultOutput);
+        args.push_back(defaultFormat);
+    }
+    argc = static_cast<int>(args.size());
+    args.push_back(nullptr);
+
+    ::benchmark::Initialize(&argc, args.data());
+    if (::benchmark::ReportUnrecognizedArguments(argc, args.data())) {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    CoarseClock::stop();
+    return 0;
+}
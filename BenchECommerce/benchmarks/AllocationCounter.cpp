@@ -0,0 +1,34 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> gAllocations{ 0 };
+    std::atomic<uint64_t> gAllocatedBytes{ 0 };
+
+    void* countedAllocate(std::size_t size) {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+        gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+uint64_t AllocationCounter::count() noexcept {
+    return gAllocations.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::bytes() noexcept {
+    return gAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
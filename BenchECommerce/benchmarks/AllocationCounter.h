@@ -0,0 +1,13 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Process-wide count of global operator new calls, used to report allocations per operation.
+namespace AllocationCounter {
+    [[nodiscard]] uint64_t count() noexcept;
+    // Total bytes requested from operator new.
+    [[nodiscard]] uint64_t bytes() noexcept;
+}
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include "FakeDatabase.h"
+#include "ProductCache.h"
+#include "ProductService.h"
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr size_t SNAPSHOT_PRODUCTS = 1'000'000;
+
+    std::unique_ptr<ProductCache> makeFullCache() {
+        auto cache = std::make_unique<ProductCache>(SNAPSHOT_PRODUCTS);
+        FakeDatabase::generateProducts(SNAPSHOT_PRODUCTS, [&cache](const FakeDatabase::GeneratedProduct& product) {
+            cache->putShared(product.id, std::make_shared<const Product>(
+                product.id, product.category, product.name, product.description, product.thumbnail));
+            });
+        return cache;
+    }
+
+    // Written once from a full 1M-product cache and reused by every restore.
+    const std::filesystem::path& sharedSnapshot() {
+        static const auto path = [] {
+            auto snapshotPath = std::filesystem::temp_directory_path() / "BenchCache.snapshot";
+            makeFullCache()->saveSnapshot(snapshotPath);
+            return snapshotPath;
+        }();
+        return path;
+    }
+
+    void loaderThreads(benchmark::internal::Benchmark* benchmark) {
+        for (unsigned threads = 1; threads < std::thread::hardware_concurrency(); threads *= 2) {
+            benchmark->Arg(threads);
+        }
+        benchmark->Arg(std::max(1u, std::thread::hardware_concurrency()));
+    }
+}
+
+static void BM_ProductCache_SaveSnapshot(benchmark::State& state) {
+    const auto cache = makeFullCache();
+    const auto path = std::filesystem::temp_directory_path() / "BenchCacheSave.snapshot";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache->saveSnapshot(path));
+    }
+    state.SetItemsProcessed(state.iterations() * SNAPSHOT_PRODUCTS);
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_ProductCache_SaveSnapshot)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+// Restoring 1M products into an empty cache with the given number of loader threads.
+static void BM_ProductCache_LoadSnapshot(benchmark::State& state) {
+    const auto& path = sharedSnapshot();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto cache = std::make_unique<ProductCache>(SNAPSHOT_PRODUCTS);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(cache->loadSnapshot(path, static_cast<size_t>(state.range(0))));
+
+        state.PauseTiming();
+        cache.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * SNAPSHOT_PRODUCTS);
+}
+BENCHMARK(BM_ProductCache_LoadSnapshot)->Apply(loaderThreads)->Unit(benchmark::kMillisecond)->Iterations(3)->UseRealTime();
+
+// The alternative to a snapshot: prefetching the same 1M hot IDs from the
+// database through ProductService::warmUp on four executor workers.
+static void BM_ProductService_WarmUp(benchmark::State& state) {
+    static const auto database = std::make_shared<FakeDatabase>(SNAPSHOT_PRODUCTS);
+    std::vector<uint64_t> hotIds(SNAPSHOT_PRODUCTS);
+    std::iota(hotIds.begin(), hotIds.end(), uint64_t{ 1 });
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto service = std::make_unique<ProductService>(std::make_shared<ProductCache>(SNAPSHOT_PRODUCTS), database,
+            ExecutorOptions{ 4, 1024, ExecutorOverflowPolicy::BLOCK });
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(service->warmUp(hotIds));
+
+        state.PauseTiming();
+        service.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * SNAPSHOT_PRODUCTS);
+}
+BENCHMARK(BM_ProductService_WarmUp)->Unit(benchmark::kMillisecond)->Iterations(3)->UseRealTime();
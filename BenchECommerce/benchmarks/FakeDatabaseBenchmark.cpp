@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include "FakeDatabase.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+    // Only one catalog is kept at a time: 10M products take a few GB.
+    FakeDatabase& sharedDatabase(size_t productCount) {
+        static std::mutex databaseMutex;
+        static std::unique_ptr<FakeDatabase> database;
+        static size_t databaseProducts = 0;
+
+        std::scoped_lock lock(databaseMutex);
+        if (!database || databaseProducts != productCount) {
+            database.reset();
+            database = std::make_unique<FakeDatabase>(productCount);
+            databaseProducts = productCount;
+        }
+        return *database;
+    }
+
+    void catalogSizes(benchmark::internal::Benchmark* benchmark) {
+        benchmark->Arg(3'000)->Arg(1'000'000)->Arg(10'000'000);
+    }
+}
+
+// Answered from the category index, so the cost should not grow with the catalog.
+static void BM_FakeDatabase_FetchProductCountByCategory(benchmark::State& state) {
+    auto& database = sharedDatabase(static_cast<size_t>(state.range(0)));
+    uint32_t category = 100 + static_cast<uint32_t>(state.thread_index()) % 3;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(database.fetchProductCountByCategory(category));
+        category = category == 102 ? 100 : category + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FakeDatabase_FetchProductCountByCategory)->Apply(catalogSizes)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+// One listing page of 20 products at offsets spread over the whole category.
+static void BM_FakeDatabase_FetchProductsByCategory(benchmark::State& state) {
+    constexpr size_t PAGE_SIZE = 20;
+    const auto productCount = static_cast<size_t>(state.range(0));
+    auto& database = sharedDatabase(productCount);
+    const size_t pages = std::max<size_t>(1, productCount / 3 / PAGE_SIZE);
+
+    size_t page = static_cast<size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(database.fetchProductsByCategory(101, (page % pages) * PAGE_SIZE, PAGE_SIZE));
+        page = page * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    state.SetItemsProcessed(state.iterations() * PAGE_SIZE);
+}
+BENCHMARK(BM_FakeDatabase_FetchProductsByCategory)->Apply(catalogSizes)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+#include "LruCache.h"
+#include "Workload.h"
+#include <algorithm>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr uint64_t CACHED_KEYS = 4096;
+    // Zipfian keys over four times the capacity, so runs see hits, misses and evictions.
+    constexpr uint64_t KEY_SPACE = CACHED_KEYS * 4;
+
+    // Price-sized values: the cost measured is the cache's own.
+    template <typename Policy, typename LockPolicy>
+    using PriceCache = LruCache<uint64_t, uint64_t, std::hash<uint64_t>, Policy, LockPolicy>;
+
+    const KeyTrace& zipfianTrace() {
+        static const KeyTrace trace(KeyDistribution::ZIPFIAN, KEY_SPACE);
+        return trace;
+    }
+
+    // Read-through on every key: a get, and a put after a miss.
+    template <typename Cache>
+    void runReadThrough(benchmark::State& state, Cache& cache) {
+        const auto& trace = zipfianTrace();
+        size_t position = trace.threadOffset(state.thread_index());
+        for (auto _ : state) {
+            const uint64_t key = trace.at(position++);
+            if (auto value = cache.get(key)) {
+                benchmark::DoNotOptimize(*value);
+            }
+            else {
+                cache.put(key, key * 3);
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // How a request's SKU reaches the cache and, on a miss, the catalog index.
+    enum class SkuKeying {
+        COPY,         // std::string keys built from the request's view, hashed by every layer
+        TRANSPARENT,  // the view itself, still hashed by every layer
+        PREHASHED     // the view hashed once, that hash reused by every layer
+    };
+
+    // SKUs past the small-string buffer, as real ones tend to be.
+    const std::vector<std::string>& skus() {
+        static const std::vector<std::string> values = [] {
+            std::vector<std::string> result;
+            result.reserve(KEY_SPACE);
+            for (uint64_t key = 0; key < KEY_SPACE; ++key) {
+                result.push_back(std::format("SKU-{:08}-EU-STANDARD", key));
+            }
+            return result;
+            }();
+        return values;
+    }
+
+    template <SkuKeying Keying>
+    using SkuHash = std::conditional_t<Keying == SkuKeying::COPY, std::hash<std::string>, StringHash>;
+
+    template <typename Policy, typename LockPolicy>
+    std::unique_ptr<PriceCache<Policy, LockPolicy>> sharedCache;
+
+    template <typename Policy, typename LockPolicy>
+    void setUpSharedCache(const benchmark::State&) {
+        sharedCache<Policy, LockPolicy> = std::make_unique<PriceCache<Policy, LockPolicy>>(CACHED_KEYS);
+    }
+
+    template <typename Policy, typename LockPolicy>
+    void tearDownSharedCache(const benchmark::State&) {
+        sharedCache<Policy, LockPolicy>.reset();
+    }
+}
+
+// One thread, each eviction and lock policy.
+template <typename Policy, typename LockPolicy>
+static void BM_LruCache_ReadThrough(benchmark::State& state) {
+    PriceCache<Policy, LockPolicy> cache(CACHED_KEYS);
+    runReadThrough(state, cache);
+    const auto metrics = cache.getMetrics();
+    state.counters["hit_ratio"] = benchmark::Counter(static_cast<double>(metrics.hits) / static_cast<double>(metrics.hits + metrics.misses));
+}
+BENCHMARK_TEMPLATE(BM_LruCache_ReadThrough, LruEviction, NoLocking);
+BENCHMARK_TEMPLATE(BM_LruCache_ReadThrough, LruEviction, MutexLocking);
+BENCHMARK_TEMPLATE(BM_LruCache_ReadThrough, LruEviction, ShardedLocking<16>);
+BENCHMARK_TEMPLATE(BM_LruCache_ReadThrough, FifoEviction, NoLocking);
+BENCHMARK_TEMPLATE(BM_LruCache_ReadThrough, FifoEviction, MutexLocking);
+BENCHMARK_TEMPLATE(BM_LruCache_ReadThrough, FifoEviction, ShardedLocking<16>);
+
+// One cache shared by 1 to N threads, for the policies that lock.
+template <typename Policy, typename LockPolicy>
+static void BM_LruCache_ReadThrough_Shared(benchmark::State& state) {
+    runReadThrough(state, *sharedCache<Policy, LockPolicy>);
+}
+#define SHARED_CACHE_BENCHMARK(Policy, LockPolicy) \
+    BENCHMARK_TEMPLATE(BM_LruCache_ReadThrough_Shared, Policy, LockPolicy) \
+        ->Setup(setUpSharedCache<Policy, LockPolicy>)->Teardown(tearDownSharedCache<Policy, LockPolicy>) \
+        ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime()
+SHARED_CACHE_BENCHMARK(LruEviction, MutexLocking);
+SHARED_CACHE_BENCHMARK(LruEviction, ShardedLocking<16>);
+SHARED_CACHE_BENCHMARK(FifoEviction, MutexLocking);
+SHARED_CACHE_BENCHMARK(FifoEviction, ShardedLocking<16>);
+
+// Read-through by SKU across two layers, the cache and a catalog index, with
+// the SKU arriving as a view into a request. Sharded, so the hash also picks
+// the shard.
+template <SkuKeying Keying>
+static void BM_LruCache_SkuReadThrough(benchmark::State& state) {
+    using Hash = SkuHash<Keying>;
+    LruCache<std::string, uint64_t, Hash, LruEviction, ShardedLocking<16>> cache(CACHED_KEYS);
+    std::unordered_map<std::string, uint64_t, PrehashedHash<Hash>, PrehashedEqual> catalog;
+    for (uint64_t key = 0; key < KEY_SPACE; ++key) {
+        catalog.emplace(skus()[key], key * 3);
+    }
+
+    const auto& trace = zipfianTrace();
+    size_t position = 0;
+    for (auto _ : state) {
+        const std::string_view sku = skus()[trace.at(position++)];
+        const auto readThrough = [&](const auto& key) {
+            if (auto value = cache.get(key)) {
+                benchmark::DoNotOptimize(*value);
+            }
+            else if (auto it = catalog.find(key); it != catalog.end()) {
+                cache.put(std::string(sku), it->second);
+            }
+        };
+        if constexpr (Keying == SkuKeying::COPY) {
+            readThrough(std::string(sku));
+        }
+        else if constexpr (Keying == SkuKeying::TRANSPARENT) {
+            readThrough(sku);
+        }
+        else {
+            readThrough(cache.prehash(sku));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LruCache_SkuReadThrough, SkuKeying::COPY);
+BENCHMARK_TEMPLATE(BM_LruCache_SkuReadThrough, SkuKeying::TRANSPARENT);
+BENCHMARK_TEMPLATE(BM_LruCache_SkuReadThrough, SkuKeying::PREHASHED);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include "FakeDatabase.h"
+#include "MappedProductDatabase.h"
+#include "MappedProductWriter.h"
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace {
+    // Stores are generated once per size into the temp directory and reused by
+    // every benchmark; 10M products take a little over 1 GB on disk.
+    const std::filesystem::path& sharedStore(size_t productCount) {
+        static std::mutex storesMutex;
+        static std::map<size_t, std::filesystem::path> stores;
+
+        std::scoped_lock lock(storesMutex);
+        auto [it, inserted] = stores.try_emplace(productCount);
+        if (inserted) {
+            it->second = std::filesystem::temp_directory_path() / ("BenchProducts_" + std::to_string(productCount) + ".db");
+            MappedProductWriter writer(it->second);
+            FakeDatabase::generateProducts(productCount, [&writer](const FakeDatabase::GeneratedProduct& product) {
+                writer.add(product.id, product.category, product.name, product.description, product.thumbnail);
+                });
+            writer.finish();
+        }
+        return it->second;
+    }
+
+    void catalogSizes(benchmark::internal::Benchmark* benchmark) {
+        benchmark->Arg(3'000)->Arg(1'000'000)->Arg(10'000'000);
+    }
+
+    uint64_t nextProductId(uint64_t& state, size_t productCount) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (state >> 33) % productCount + 1;
+    }
+}
+
+// Opening only maps the file and checks the header, so this should not grow
+// with the catalog, unlike constructing a FakeDatabase of the same size.
+static void BM_MappedProductDatabase_Open(benchmark::State& state) {
+    const auto& path = sharedStore(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        MappedProductDatabase database(path);
+        benchmark::DoNotOptimize(database.getProductCount());
+    }
+}
+BENCHMARK(BM_MappedProductDatabase_Open)->Apply(catalogSizes);
+
+// Random lookups once every page of the store is resident.
+static void BM_MappedProductDatabase_LookupWarm(benchmark::State& state) {
+    const auto productCount = static_cast<size_t>(state.range(0));
+    MappedProductDatabase database(sharedStore(productCount));
+    for (uint64_t productId = 1; productId <= productCount; ++productId) {
+        benchmark::DoNotOptimize(database.fetchProductDetails(productId));
+    }
+
+    uint64_t random = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(database.fetchProductDetails(nextProductId(random, productCount)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MappedProductDatabase_LookupWarm)->Apply(catalogSizes);
+
+// Random lookups with the store evicted before each one, so the index probes
+// and the record fault their pages in again. Where the OS lets the page cache
+// be dropped (POSIX) this includes the read from disk; on Windows the pages
+// usually come back from the standby list.
+static void BM_MappedProductDatabase_LookupCold(benchmark::State& state) {
+    const auto productCount = static_cast<size_t>(state.range(0));
+    MappedProductDatabase database(sharedStore(productCount));
+
+    uint64_t random = 1;
+    for (auto _ : state) {
+        state.PauseTiming();
+        database.evict();
+        const uint64_t productId = nextProductId(random, productCount);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(database.fetchProductDetails(productId));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MappedProductDatabase_LookupCold)->Apply(catalogSizes)->Iterations(2'000);
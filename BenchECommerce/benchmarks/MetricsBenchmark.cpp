@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include "Metrics.h"
+#include "ProductCache.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+    constexpr uint64_t CACHED_PRODUCTS = 1024;
+
+    ProductCache& warmCache() {
+        static auto cache = [] {
+            auto productCache = std::make_shared<ProductCache>(CACHED_PRODUCTS);
+            for (uint64_t i = 0; i < CACHED_PRODUCTS; ++i) {
+                productCache->put(i, Product(i, 100, "Product " + std::to_string(i), "Description of Product " + std::to_string(i), {}));
+            }
+            return productCache;
+        }();
+        return *cache;
+    }
+
+    // Runs the same cache hit loop with recording switched on or off, so the
+    // difference between the two runs is the cost of the metrics.
+    void runCacheHits(benchmark::State& state, bool metricsEnabled) {
+        if (state.thread_index() == 0) {
+            Metrics::setEnabled(metricsEnabled);
+        }
+        auto& cache = warmCache();
+        uint64_t productId = static_cast<uint64_t>(state.thread_index()) * 131;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(cache.getShared(productId++ % CACHED_PRODUCTS));
+        }
+        state.SetItemsProcessed(state.iterations());
+        if (state.thread_index() == 0) {
+            Metrics::setEnabled(true);
+        }
+    }
+}
+
+static void BM_Metrics_ProductCacheHit_Disabled(benchmark::State& state) {
+    runCacheHits(state, false);
+}
+BENCHMARK(BM_Metrics_ProductCacheHit_Disabled)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_Metrics_ProductCacheHit_Enabled(benchmark::State& state) {
+    runCacheHits(state, true);
+}
+BENCHMARK(BM_Metrics_ProductCacheHit_Enabled)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_Metrics_ShardedCounterIncrement(benchmark::State& state) {
+    static ShardedCounter counter;
+    for (auto _ : state) {
+        counter.increment();
+    }
+    benchmark::DoNotOptimize(counter.load());
+}
+BENCHMARK(BM_Metrics_ShardedCounterIncrement)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_Metrics_ScopedLatency(benchmark::State& state) {
+    static LatencyHistogram histogram;
+    for (auto _ : state) {
+        ScopedLatency latency(histogram);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Metrics_ScopedLatency)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include "NumaProductCache.h"
+#include "NumaTopology.h"
+#include "ProductCache.h"
+#include "Workload.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Enough products that their nodes, list links and map slots do not fit in
+    // the last-level cache, so hits are served from memory.
+    constexpr uint64_t CACHED_PRODUCTS = 200'000;
+
+    const NumaTopology& topology() {
+        static const NumaTopology detected = NumaTopology::detect();
+        return detected;
+    }
+
+    std::vector<uint32_t> allCpus() {
+        std::vector<uint32_t> cpus;
+        for (size_t node = 0; node < topology().getNodeCount(); ++node) {
+            cpus.insert(cpus.end(), topology().getCpus(node).begin(), topology().getCpus(node).end());
+        }
+        return cpus;
+    }
+
+    Product makeProduct(uint64_t productId) {
+        return Product(productId, 100, "Product " + std::to_string(productId), "Description of product " + std::to_string(productId),
+            std::vector<std::byte>(64, std::byte{ 'T' }));
+    }
+
+    // Every pair of reader and memory node; a single-node machine only has the local pair.
+    void nodePairs(benchmark::internal::Benchmark* benchmark) {
+        const auto nodes = static_cast<int64_t>(topology().getNodeCount());
+        for (int64_t readerNode = 0; readerNode < nodes; ++readerNode) {
+            for (int64_t memoryNode = 0; memoryNode < nodes; ++memoryNode) {
+                benchmark->Args({ readerNode, memoryNode });
+            }
+        }
+    }
+
+    // Restores the calling thread's affinity when a benchmark that pinned it ends.
+    struct ScopedPin {
+        explicit ScopedPin(size_t node) {
+            NumaTopology::pinCurrentThread(topology().getCpus(node));
+        }
+        ~ScopedPin() {
+            NumaTopology::pinCurrentThread(allCpus());
+        }
+    };
+
+    std::unique_ptr<ICache<uint64_t, Product>> sharedCache;
+
+    void setUpSharedCache(const benchmark::State& state) {
+        if (state.range(0) == 0) {
+            sharedCache = std::make_unique<ProductCache>(CACHED_PRODUCTS);
+        }
+        else {
+            sharedCache = std::make_unique<NumaProductCache>(CACHED_PRODUCTS, topology());
+        }
+        std::jthread([] {
+            NumaTopology::pinCurrentThread(topology().getCpus(0));
+            for (uint64_t productId = 0; productId < CACHED_PRODUCTS; ++productId) {
+                sharedCache->put(productId, makeProduct(productId));
+            }
+            }).join();
+    }
+
+    void tearDownSharedCache(const benchmark::State&) {
+        sharedCache.reset();
+    }
+}
+
+// Hits on a ProductCache filled by a thread pinned to the memory node, read by
+// the benchmark thread pinned to the reader node; local when the two match.
+static void BM_Numa_HitLatency(benchmark::State& state) {
+    const auto readerNode = static_cast<size_t>(state.range(0));
+    const auto memoryNode = static_cast<size_t>(state.range(1));
+
+    ProductCache cache(CACHED_PRODUCTS);
+    std::jthread([&cache, memoryNode] {
+        NumaTopology::pinCurrentThread(topology().getCpus(memoryNode));
+        for (uint64_t productId = 0; productId < CACHED_PRODUCTS; ++productId) {
+            cache.put(productId, makeProduct(productId));
+        }
+        }).join();
+
+    ScopedPin pin(readerNode);
+    const KeyTrace trace(KeyDistribution::UNIFORM, CACHED_PRODUCTS);
+    size_t position = 0;
+    for (auto _ : state) {
+        auto product = cache.getShared(trace.at(position++));
+        benchmark::DoNotOptimize(product->getName().front());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["local"] = benchmark::Counter(readerNode == memoryNode ? 1.0 : 0.0);
+    state.counters["nodes"] = benchmark::Counter(static_cast<double>(topology().getNodeCount()));
+}
+BENCHMARK(BM_Numa_HitLatency)->Apply(nodePairs)->ArgNames({ "reader_node", "memory_node" });
+
+// Threads spread round-robin over the nodes, each pinned, reading one shared
+// cache filled from node 0: argument 0 is a single ProductCache, 1 a
+// NumaProductCache whose replicas fill themselves on the first remote hit.
+static void BM_Numa_SharedCacheHits(benchmark::State& state) {
+    auto& cache = *sharedCache;
+    ScopedPin pin(static_cast<size_t>(state.thread_index()) % topology().getNodeCount());
+    const KeyTrace trace(KeyDistribution::ZIPFIAN, CACHED_PRODUCTS);
+    size_t position = trace.threadOffset(state.thread_index());
+    for (auto _ : state) {
+        auto product = cache.getShared(trace.at(position++));
+        benchmark::DoNotOptimize(product->getName().front());
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (const auto* numaCache = dynamic_cast<const NumaProductCache*>(&cache); numaCache && state.thread_index() == 0) {
+        state.counters["remote_hits"] = benchmark::Counter(static_cast<double>(numaCache->getRemoteHitCount()));
+    }
+}
+BENCHMARK(BM_Numa_SharedCacheHits)
+    ->Arg(0)->Arg(1)->ArgName("replicated")
+    ->Setup(setUpSharedCache)->Teardown(tearDownSharedCache)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include "AllocationCounter.h"
+#include "FakeDatabase.h"
+#include "Product.h"
+#include <string>
+#include <vector>
+
+namespace {
+    // Field sizes of a typical catalog entry, and of one with a real image.
+    constexpr size_t SMALL_THUMBNAIL = 3;
+    constexpr size_t LARGE_THUMBNAIL = 16 * 1024;
+
+    Product makeProduct(uint64_t productId, size_t thumbnailSize) {
+        return Product(productId, 100, "Product " + std::to_string(productId),
+            "Description of Product " + std::to_string(productId), std::vector<std::byte>(thumbnailSize));
+    }
+
+    void reportAllocations(benchmark::State& state, uint64_t allocationsBefore, uint64_t bytesBefore) {
+        const auto iterations = static_cast<double>(state.iterations());
+        state.counters["allocs_per_op"] = benchmark::Counter(static_cast<double>(AllocationCounter::count() - allocationsBefore) / iterations);
+        state.counters["heap_bytes_per_op"] = benchmark::Counter(static_cast<double>(AllocationCounter::bytes() - bytesBefore) / iterations);
+    }
+}
+
+// Argument: thumbnail size in bytes.
+static void BM_Product_Copy(benchmark::State& state) {
+    const Product source = makeProduct(42, static_cast<size_t>(state.range(0)));
+    const uint64_t allocationsBefore = AllocationCounter::count();
+    const uint64_t bytesBefore = AllocationCounter::bytes();
+    for (auto _ : state) {
+        Product copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+    reportAllocations(state, allocationsBefore, bytesBefore);
+    state.counters["footprint_bytes"] = benchmark::Counter(static_cast<double>(source.getMemoryFootprint()));
+}
+BENCHMARK(BM_Product_Copy)->Arg(SMALL_THUMBNAIL)->Arg(LARGE_THUMBNAIL);
+
+// Building the database covers product construction for its whole catalog.
+static void BM_FakeDatabase_Construct(benchmark::State& state) {
+    const uint64_t allocationsBefore = AllocationCounter::count();
+    const uint64_t bytesBefore = AllocationCounter::bytes();
+    for (auto _ : state) {
+        FakeDatabase database;
+        benchmark::DoNotOptimize(database);
+    }
+    reportAllocations(state, allocationsBefore, bytesBefore);
+}
+BENCHMARK(BM_FakeDatabase_Construct)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,269 @@
+#include <benchmark/benchmark.h>
+#include "AllocationCounter.h"
+#include "ClockProductCache.h"
+#include "ProductCache.h"
+#include "ShardedProductCache.h"
+#include "SlabProductCache.h"
+#include "TinyLfuProductCache.h"
+#include "Workload.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr uint64_t CACHED_PRODUCTS = 4096;
+
+    Product makeProduct(uint64_t productId) {
+        return Product(productId, 100 + static_cast<uint32_t>(productId % 3),
+            "Product " + std::to_string(productId), "Description of Product " + std::to_string(productId),
+            std::vector{ std::byte{ 'A' }, std::byte{ 'B' }, std::byte{ 'C' } });
+    }
+
+    template <typename Cache>
+    std::shared_ptr<Cache> makeWarmCache(std::shared_ptr<Cache> cache) {
+        for (uint64_t i = 0; i < CACHED_PRODUCTS; ++i) {
+            cache->put(i, makeProduct(i));
+        }
+        return cache;
+    }
+
+    // Shared by every thread of a run; built once so all threads hit a warm cache.
+    ProductCache& singleLockCache() {
+        static auto cache = makeWarmCache(std::make_shared<ProductCache>(CACHED_PRODUCTS));
+        return *cache;
+    }
+
+    ShardedProductCache& shardedCache() {
+        static auto cache = makeWarmCache(std::make_shared<ShardedProductCache>(CACHED_PRODUCTS * 2));
+        return *cache;
+    }
+
+    ShardedProductCache& shardedClockCache() {
+        static auto cache = makeWarmCache(std::make_shared<ShardedProductCache>(CACHED_PRODUCTS * 2,
+            ShardedProductCache::defaultShardCount(), EvictionMode::CLOCK));
+        return *cache;
+    }
+
+    ClockProductCache& clockCache() {
+        static auto cache = makeWarmCache(std::make_shared<ClockProductCache>(CACHED_PRODUCTS));
+        return *cache;
+    }
+
+    SlabProductCache& slabCache() {
+        static auto cache = makeWarmCache(std::make_shared<SlabProductCache>(CACHED_PRODUCTS));
+        return *cache;
+    }
+
+    template <typename Cache>
+    void runHits(benchmark::State& state, Cache& cache) {
+        // Each thread walks the key space from a different offset to avoid lockstep access.
+        uint64_t productId = static_cast<uint64_t>(state.thread_index()) * 7919;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(cache.get(productId % CACHED_PRODUCTS));
+            ++productId;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Workload runs use a key space four times the capacity, so the cache sees
+    // misses and evictions as well as hits.
+    constexpr uint64_t KEY_SPACE_FACTOR = 4;
+    constexpr size_t PRODUCT_POOL = 256;
+
+    // Values inserted by the workload runs are shared handles built up front,
+    // so put measures the cache rather than constructing products.
+    const std::vector<std::shared_ptr<const Product>>& productPool() {
+        static const auto pool = [] {
+            std::vector<std::shared_ptr<const Product>> products;
+            products.reserve(PRODUCT_POOL);
+            for (uint64_t i = 0; i < PRODUCT_POOL; ++i) {
+                products.push_back(std::make_shared<const Product>(makeProduct(i)));
+            }
+            return products;
+        }();
+        return pool;
+    }
+
+    struct CacheWorkload {
+        std::unique_ptr<ProductCache> cache;
+        std::unique_ptr<KeyTrace> trace;
+    };
+    CacheWorkload workload;
+
+    // Arguments: { distribution, capacity }. The cache starts full so the run measures steady state.
+    void setUpCacheWorkload(const benchmark::State& state) {
+        const auto distribution = static_cast<KeyDistribution>(state.range(0));
+        const auto capacity = static_cast<uint64_t>(state.range(1));
+        const auto& pool = productPool();
+
+        workload.cache = std::make_unique<ProductCache>(capacity);
+        for (uint64_t i = 0; i < capacity; ++i) {
+            workload.cache->putShared(i, pool[i % PRODUCT_POOL]);
+        }
+        workload.trace = std::make_unique<KeyTrace>(distribution, capacity * KEY_SPACE_FACTOR);
+    }
+
+    void tearDownCacheWorkload(const benchmark::State&) {
+        workload = {};
+    }
+
+    std::unique_ptr<ICache<uint64_t, Product>> makePolicyCache(EvictionMode evictionMode, size_t capacity) {
+        switch (evictionMode) {
+        case EvictionMode::CLOCK:    return std::make_unique<ClockProductCache>(capacity);
+        case EvictionMode::TINY_LFU: return std::make_unique<TinyLfuProductCache>(capacity);
+        default:                     return std::make_unique<ProductCache>(capacity);
+        }
+    }
+
+    std::string_view evictionModeName(EvictionMode evictionMode) noexcept {
+        switch (evictionMode) {
+        case EvictionMode::CLOCK:    return "clock";
+        case EvictionMode::TINY_LFU: return "tinylfu";
+        default:                     return "lru";
+        }
+    }
+}
+
+static void BM_ProductCache_GetHit(benchmark::State& state) {
+    runHits(state, singleLockCache());
+}
+BENCHMARK(BM_ProductCache_GetHit)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_SlabProductCache_GetHit(benchmark::State& state) {
+    runHits(state, slabCache());
+}
+BENCHMARK(BM_SlabProductCache_GetHit)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_ShardedProductCache_GetHit(benchmark::State& state) {
+    runHits(state, shardedCache());
+}
+BENCHMARK(BM_ShardedProductCache_GetHit)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_ClockProductCache_GetHit(benchmark::State& state) {
+    runHits(state, clockCache());
+}
+BENCHMARK(BM_ClockProductCache_GetHit)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_ShardedClockProductCache_GetHit(benchmark::State& state) {
+    runHits(state, shardedClockCache());
+}
+BENCHMARK(BM_ShardedClockProductCache_GetHit)->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+// Read-through access: a miss inserts the product, as ProductService does.
+static void BM_ProductCache_Get(benchmark::State& state) {
+    state.SetLabel(std::string(distributionName(static_cast<KeyDistribution>(state.range(0)))));
+    auto& cache = *workload.cache;
+    const auto& trace = *workload.trace;
+    const auto& pool = productPool();
+
+    size_t position = trace.threadOffset(state.thread_index());
+    int64_t hits = 0;
+    for (auto _ : state) {
+        const uint64_t productId = trace.at(position++);
+        if (auto product = cache.getShared(productId)) {
+            benchmark::DoNotOptimize(product);
+            ++hits;
+        }
+        else {
+            cache.putShared(productId, pool[productId % PRODUCT_POOL]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_ratio"] = benchmark::Counter(static_cast<double>(hits) / static_cast<double>(state.iterations()),
+        benchmark::Counter::kAvgThreads);
+}
+BENCHMARK(BM_ProductCache_Get)
+    ->ArgsProduct({ { static_cast<int64_t>(KeyDistribution::UNIFORM), static_cast<int64_t>(KeyDistribution::ZIPFIAN),
+                      static_cast<int64_t>(KeyDistribution::SCAN) },
+                    { 256, 4096, 65536 } })
+    ->ArgNames({ "distribution", "capacity" })
+    ->Setup(setUpCacheWorkload)->Teardown(tearDownCacheWorkload)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+static void BM_ProductCache_Put(benchmark::State& state) {
+    state.SetLabel(std::string(distributionName(static_cast<KeyDistribution>(state.range(0)))));
+    auto& cache = *workload.cache;
+    const auto& trace = *workload.trace;
+    const auto& pool = productPool();
+
+    size_t position = trace.threadOffset(state.thread_index());
+    for (auto _ : state) {
+        const uint64_t productId = trace.at(position++);
+        cache.putShared(productId, pool[productId % PRODUCT_POOL]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProductCache_Put)
+    ->ArgsProduct({ { static_cast<int64_t>(KeyDistribution::UNIFORM), static_cast<int64_t>(KeyDistribution::ZIPFIAN),
+                      static_cast<int64_t>(KeyDistribution::SCAN) },
+                    { 256, 4096, 65536 } })
+    ->ArgNames({ "distribution", "capacity" })
+    ->Setup(setUpCacheWorkload)->Teardown(tearDownCacheWorkload)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+
+// Hit ratio of each eviction policy replaying the same read-through trace.
+// Arguments: { policy, distribution, capacity }. The cache starts empty and the
+// trace is replayed once untimed, so hit_ratio reflects the policy's steady state.
+static void BM_EvictionPolicy_HitRatio(benchmark::State& state) {
+    const auto evictionMode = static_cast<EvictionMode>(state.range(0));
+    const auto distribution = static_cast<KeyDistribution>(state.range(1));
+    const auto capacity = static_cast<uint64_t>(state.range(2));
+    state.SetLabel(std::string(evictionModeName(evictionMode)) + "/" + std::string(distributionName(distribution)));
+
+    auto cache = makePolicyCache(evictionMode, capacity);
+    const KeyTrace trace(distribution, capacity * KEY_SPACE_FACTOR);
+    const auto& pool = productPool();
+
+    auto access = [&](uint64_t productId) {
+        if (auto product = cache->getShared(productId)) {
+            benchmark::DoNotOptimize(product);
+            return true;
+        }
+        cache->putShared(productId, pool[productId % PRODUCT_POOL]);
+        return false;
+    };
+
+    for (size_t position = 0; position < trace.getLength(); ++position) {
+        access(trace.at(position));
+    }
+
+    size_t position = 0;
+    int64_t hits = 0;
+    for (auto _ : state) {
+        hits += access(trace.at(position++)) ? 1 : 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_ratio"] = benchmark::Counter(static_cast<double>(hits) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_EvictionPolicy_HitRatio)
+    ->ArgsProduct({ { static_cast<int64_t>(EvictionMode::LRU), static_cast<int64_t>(EvictionMode::CLOCK),
+                      static_cast<int64_t>(EvictionMode::TINY_LFU) },
+                    { static_cast<int64_t>(KeyDistribution::ZIPFIAN), static_cast<int64_t>(KeyDistribution::SCAN) },
+                    { 256, 4096, 65536 } })
+    ->ArgNames({ "policy", "distribution", "capacity" });
+
+// Every put misses and evicts. Reports heap allocations per put, which the slab
+// layout brings to zero once the cache is full. Argument: capacity.
+template <typename Cache>
+static void BM_Churn_Put(benchmark::State& state) {
+    const auto capacity = static_cast<uint64_t>(state.range(0));
+    const auto& pool = productPool();
+    Cache cache(capacity);
+    for (uint64_t i = 0; i < capacity; ++i) {
+        cache.putShared(i, pool[i % PRODUCT_POOL]);
+    }
+
+    uint64_t productId = capacity;
+    const uint64_t allocationsBefore = AllocationCounter::count();
+    for (auto _ : state) {
+        cache.putShared(productId, pool[productId % PRODUCT_POOL]);
+        ++productId;
+    }
+    const auto allocations = static_cast<double>(AllocationCounter::count() - allocationsBefore);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs_per_put"] = benchmark::Counter(allocations / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_Churn_Put<ProductCache>)->Arg(4096)->Arg(65536);
+BENCHMARK(BM_Churn_Put<SlabProductCache>)->Arg(4096)->Arg(65536);
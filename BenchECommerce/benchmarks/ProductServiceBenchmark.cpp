@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+#include "AllocationCounter.h"
+#include "FakeDatabase.h"
+#include "ProductCache.h"
+#include "ProductService.h"
+#include "Workload.h"
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr uint64_t CACHED_PRODUCTS = 1024;
+
+    // Warm service whose cache holds every product the benchmarks request.
+    ProductService& warmService() {
+        static auto service = [] {
+            auto cache = std::make_shared<ProductCache>(CACHED_PRODUCTS);
+            auto database = std::make_shared<FakeDatabase>();
+            auto productService = std::make_shared<ProductService>(cache, database);
+            for (uint64_t i = 1; i <= CACHED_PRODUCTS; ++i) {
+                benchmark::DoNotOptimize(productService->getProductDetailsShared(i));
+            }
+            return productService;
+        }();
+        return *service;
+    }
+
+    constexpr size_t PAGE_SIZE = 200;
+
+    std::shared_ptr<FakeDatabase> sharedDatabase() {
+        static auto database = std::make_shared<FakeDatabase>();
+        return database;
+    }
+
+    // Every iteration renders one page against a fresh, empty cache so all products miss.
+    template <typename RenderPage>
+    void runColdPages(benchmark::State& state, RenderPage renderPage) {
+        std::vector<uint64_t> productIds(PAGE_SIZE);
+        std::iota(productIds.begin(), productIds.end(), uint64_t{ 1 });
+        auto database = sharedDatabase();
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            ProductService service{ std::make_shared<ProductCache>(PAGE_SIZE), database };
+            state.ResumeTiming();
+
+            renderPage(service, productIds);
+        }
+        state.SetItemsProcessed(state.iterations() * PAGE_SIZE);
+    }
+
+    template <typename Fetch>
+    void runHits(benchmark::State& state, Fetch fetch) {
+        uint64_t productId = 0;
+        const uint64_t allocationsBefore = AllocationCounter::count();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(fetch(productId % CACHED_PRODUCTS + 1));
+            ++productId;
+        }
+        const auto allocations = static_cast<double>(AllocationCounter::count() - allocationsBefore);
+        state.counters["allocs_per_hit"] = benchmark::Counter(allocations / static_cast<double>(state.iterations()));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Number of products FakeDatabase is populated with (IDs 1..3000).
+    constexpr uint64_t DATABASE_PRODUCTS = 3000;
+
+    struct HitRatioWorkload {
+        std::unique_ptr<ProductService> service;
+        std::unique_ptr<KeyTrace> trace;
+        ServiceMetricsSnapshot before;
+    };
+    HitRatioWorkload hitRatioWorkload;
+
+    // Argument: target hit ratio in percent. Uniform requests over every product
+    // against an LRU cache holding that share of the catalog hit it at that ratio.
+    void setUpHitRatioWorkload(const benchmark::State& state) {
+        const auto capacity = std::max<uint64_t>(1, DATABASE_PRODUCTS * static_cast<uint64_t>(state.range(0)) / 100);
+        hitRatioWorkload.service = std::make_unique<ProductService>(std::make_shared<ProductCache>(capacity), sharedDatabase());
+        for (uint64_t productId = 1; productId <= capacity; ++productId) {
+            benchmark::DoNotOptimize(hitRatioWorkload.service->getProductDetailsShared(productId));
+        }
+        hitRatioWorkload.trace = std::make_unique<KeyTrace>(KeyDistribution::UNIFORM, DATABASE_PRODUCTS);
+        hitRatioWorkload.before = hitRatioWorkload.service->getMetrics();
+    }
+
+    void tearDownHitRatioWorkload(const benchmark::State&) {
+        hitRatioWorkload = {};
+    }
+}
+
+static void BM_ProductService_GetProductDetails_Hit(benchmark::State& state) {
+    auto& service = warmService();
+    runHits(state, [&service](uint64_t productId) { return service.getProductDetails(productId); });
+}
+BENCHMARK(BM_ProductService_GetProductDetails_Hit);
+
+static void BM_ProductService_GetProductDetailsShared_Hit(benchmark::State& state) {
+    auto& service = warmService();
+    runHits(state, [&service](uint64_t productId) { return service.getProductDetailsShared(productId); });
+}
+BENCHMARK(BM_ProductService_GetProductDetailsShared_Hit);
+
+static void BM_ProductService_Page_PerItemLoop(benchmark::State& state) {
+    runColdPages(state, [](const ProductService& service, const std::vector<uint64_t>& productIds) {
+        for (uint64_t productId : productIds) {
+            benchmark::DoNotOptimize(service.getProductDetailsShared(productId));
+        }
+    });
+}
+BENCHMARK(BM_ProductService_Page_PerItemLoop);
+
+static void BM_ProductService_Page_GetMany(benchmark::State& state) {
+    runColdPages(state, [](const ProductService& service, const std::vector<uint64_t>& productIds) {
+        benchmark::DoNotOptimize(service.getMany(productIds));
+    });
+}
+BENCHMARK(BM_ProductService_Page_GetMany);
+
+static void BM_ProductService_GetProductDetails_HitRatio(benchmark::State& state) {
+    const auto& service = *hitRatioWorkload.service;
+    const auto& trace = *hitRatioWorkload.trace;
+
+    size_t position = trace.threadOffset(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(service.getProductDetails(trace.at(position++) + 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    // Every thread has left the timed loop here, so the service counters are final.
+    if (state.thread_index() == 0) {
+        const auto after = service.getMetrics();
+        const auto requests = after.requests - hitRatioWorkload.before.requests;
+        const auto hits = after.cacheHits - hitRatioWorkload.before.cacheHits;
+        state.counters["hit_ratio"] = benchmark::Counter(requests == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(requests));
+    }
+}
+BENCHMARK(BM_ProductService_GetProductDetails_HitRatio)
+    ->Arg(10)->Arg(50)->Arg(90)->Arg(99)->Arg(100)->ArgName("hit_percent")
+    ->Setup(setUpHitRatioWorkload)->Teardown(tearDownHitRatioWorkload)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
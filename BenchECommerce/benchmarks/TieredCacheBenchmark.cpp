@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include "FakeDatabase.h"
+#include "Metrics.h"
+#include "ProductCache.h"
+#include "ProductService.h"
+#include "TieredProductCache.h"
+#include "Workload.h"
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr uint64_t CATALOG_PRODUCTS = 100'000;
+    // Memory both configurations get; about a tenth of the catalog fits.
+    constexpr size_t MEMORY_BUDGET_BYTES = 2 * 1024 * 1024;
+    constexpr size_t WARM_UP_REQUESTS = 50'000;
+    constexpr auto DATABASE_LATENCY = std::chrono::microseconds(50);
+    constexpr uint32_t DEFAULT_LATENCY_SAMPLE_RATE = 16;
+
+    // FakeDatabase with a round trip's worth of latency on every product fetch.
+    class RemoteDatabase : public IDatabase {
+    public:
+        explicit RemoteDatabase(std::shared_ptr<IDatabase> database) : mDatabase{ std::move(database) } {}
+
+        std::optional<Product> fetchProductDetails(uint64_t productId) override {
+            std::this_thread::sleep_for(DATABASE_LATENCY);
+            return mDatabase->fetchProductDetails(productId);
+        }
+
+        size_t fetchProductCountByCategory(uint32_t categoryId) override {
+            return mDatabase->fetchProductCountByCategory(categoryId);
+        }
+
+        std::vector<Product> fetchProductsByCategory(uint32_t categoryId, size_t offset, size_t limit) override {
+            return mDatabase->fetchProductsByCategory(categoryId, offset, limit);
+        }
+
+    private:
+        std::shared_ptr<IDatabase> mDatabase;
+    };
+
+    enum class CacheTiers : int64_t { MEMORY_ONLY, MEMORY_AND_DISK };
+
+    struct TieredWorkload {
+        std::shared_ptr<TieredProductCache> tieredCache;
+        std::unique_ptr<ProductService> service;
+        std::unique_ptr<KeyTrace> trace;
+        ServiceMetricsSnapshot before;
+    };
+    TieredWorkload tieredWorkload;
+
+    // Zipfian requests over a catalog ten times larger than memory, replayed
+    // once untimed so both tiers are warm when measurement starts.
+    void setUpTieredWorkload(const benchmark::State& state) {
+        // Every request is timed: sampling one call in N per thread aliases with
+        // the fixed number of timed cache calls a request makes.
+        Metrics::setLatencySampleRate(1);
+        static const auto database = std::make_shared<RemoteDatabase>(std::make_shared<FakeDatabase>(CATALOG_PRODUCTS));
+
+        auto memoryTier = std::make_unique<ProductCache>(CacheMemoryBudget{ MEMORY_BUDGET_BYTES });
+        std::shared_ptr<ICache<uint64_t, Product>> cache;
+        if (static_cast<CacheTiers>(state.range(0)) == CacheTiers::MEMORY_AND_DISK) {
+            tieredWorkload.tieredCache = std::make_shared<TieredProductCache>(std::move(memoryTier), LogStoreOptions{});
+            cache = tieredWorkload.tieredCache;
+        }
+        else {
+            cache = std::move(memoryTier);
+        }
+
+        tieredWorkload.service = std::make_unique<ProductService>(cache, database);
+        tieredWorkload.trace = std::make_unique<KeyTrace>(KeyDistribution::ZIPFIAN, CATALOG_PRODUCTS);
+        for (size_t position = 0; position < WARM_UP_REQUESTS; ++position) {
+            benchmark::DoNotOptimize(tieredWorkload.service->getProductDetailsShared(tieredWorkload.trace->at(position) + 1));
+        }
+        if (tieredWorkload.tieredCache) {
+            tieredWorkload.tieredCache->flush();
+        }
+        tieredWorkload.before = tieredWorkload.service->getMetrics();
+    }
+
+    void tearDownTieredWorkload(const benchmark::State&) {
+        tieredWorkload = {};
+        Metrics::setLatencySampleRate(DEFAULT_LATENCY_SAMPLE_RATE);
+    }
+
+    // Latency histogram of the requests made since `before`.
+    LatencyHistogram::Snapshot latencySince(const LatencyHistogram::Snapshot& before, LatencyHistogram::Snapshot after) {
+        after.count -= before.count;
+        after.sumNanos -= before.sumNanos;
+        for (size_t bucket = 0; bucket < after.buckets.size(); ++bucket) {
+            after.buckets[bucket] -= before.buckets[bucket];
+        }
+        return after;
+    }
+}
+
+// Argument 0 serves misses from the database alone, 1 checks the disk tier first.
+static void BM_ProductService_CacheTiers(benchmark::State& state) {
+    const auto& service = *tieredWorkload.service;
+    const auto& trace = *tieredWorkload.trace;
+
+    size_t position = WARM_UP_REQUESTS;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(service.getProductDetailsShared(trace.at(position++) + 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    const auto after = service.getMetrics();
+    const auto requests = static_cast<double>(after.requests - tieredWorkload.before.requests);
+    const auto fetches = static_cast<double>(after.databaseFetches - tieredWorkload.before.databaseFetches);
+    const auto latency = latencySince(tieredWorkload.before.requestLatency, after.requestLatency);
+    state.counters["db_fetches_per_request"] = benchmark::Counter(requests == 0 ? 0.0 : fetches / requests);
+    state.counters["p50_us"] = benchmark::Counter(static_cast<double>(latency.percentile(0.50)) / 1000.0);
+    state.counters["p90_us"] = benchmark::Counter(static_cast<double>(latency.percentile(0.90)) / 1000.0);
+    state.counters["p99_us"] = benchmark::Counter(static_cast<double>(latency.percentile(0.99)) / 1000.0);
+    if (tieredWorkload.tieredCache) {
+        state.counters["disk_entries"] = benchmark::Counter(static_cast<double>(tieredWorkload.tieredCache->getDiskTierMetrics().entries));
+    }
+}
+BENCHMARK(BM_ProductService_CacheTiers)
+    ->Arg(static_cast<int64_t>(CacheTiers::MEMORY_ONLY))->Arg(static_cast<int64_t>(CacheTiers::MEMORY_AND_DISK))->ArgName("tiers")
+    ->Setup(setUpTieredWorkload)->Teardown(tearDownTieredWorkload)
+    ->Iterations(200'000)->UseRealTime();
@@ -0,0 +1,80 @@
+#include "Workload.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <random>
+
+namespace {
+    constexpr double ZIPF_EXPONENT = 0.99;
+    // A scan-heavy trace alternates blocks of hot lookups with blocks of a sweep.
+    constexpr size_t SCAN_BLOCK = 1024;
+
+    // Inverse-CDF sampler; the table is built once per trace, so sampling is a binary search.
+    class ZipfSampler {
+    public:
+        explicit ZipfSampler(uint64_t keySpace) : mCdf(keySpace) {
+            double sum = 0.0;
+            for (uint64_t rank = 0; rank < keySpace; ++rank) {
+                sum += 1.0 / std::pow(static_cast<double>(rank + 1), ZIPF_EXPONENT);
+                mCdf[rank] = sum;
+            }
+            for (double& value : mCdf) {
+                value /= sum;
+            }
+        }
+
+        uint64_t operator()(std::mt19937_64& random) const {
+            const double u = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+            const auto it = std::lower_bound(mCdf.begin(), mCdf.end(), u);
+            return static_cast<uint64_t>(std::min<ptrdiff_t>(it - mCdf.begin(), static_cast<ptrdiff_t>(mCdf.size()) - 1));
+        }
+
+    private:
+        std::vector<double> mCdf;
+    };
+}
+
+std::string_view distributionName(KeyDistribution distribution) noexcept {
+    switch (distribution) {
+    case KeyDistribution::UNIFORM: return "uniform";
+    case KeyDistribution::ZIPFIAN: return "zipfian";
+    case KeyDistribution::SCAN: return "scan";
+    }
+    return "unknown";
+}
+
+KeyTrace::KeyTrace(KeyDistribution distribution, uint64_t keySpace, size_t length, uint64_t seed)
+    : mKeys(std::bit_ceil(std::max<size_t>(length, 1)))
+    , mMask(mKeys.size() - 1)
+{
+    keySpace = std::max<uint64_t>(keySpace, 1);
+    std::mt19937_64 random{ seed };
+
+    switch (distribution) {
+    case KeyDistribution::UNIFORM: {
+        std::uniform_int_distribution<uint64_t> uniform(0, keySpace - 1);
+        std::ranges::generate(mKeys, [&] { return uniform(random); });
+        break;
+    }
+    case KeyDistribution::ZIPFIAN: {
+        ZipfSampler zipf(keySpace);
+        std::ranges::generate(mKeys, [&] { return zipf(random); });
+        break;
+    }
+    case KeyDistribution::SCAN: {
+        ZipfSampler zipf(keySpace);
+        uint64_t cursor = 0;
+        for (size_t i = 0; i < mKeys.size(); ++i) {
+            const bool inSweep = (i / SCAN_BLOCK) % 2 == 1;
+            mKeys[i] = inSweep ? cursor++ % keySpace : zipf(random);
+        }
+        break;
+    }
+    }
+}
+
+size_t KeyTrace::threadOffset(int threadIndex) const noexcept {
+    // Odd multiplier so offsets of neighbouring threads are spread across the whole trace.
+    return (static_cast<size_t>(threadIndex) * 0x9E3779B1u) & mMask;
+}
@@ -0,0 +1,35 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Key access patterns replayed by the cache and service benchmarks.
+enum class KeyDistribution : int64_t {
+    UNIFORM,  // Every key equally likely
+    ZIPFIAN,  // A few hot keys take most of the traffic (s = 0.99)
+    SCAN      // Zipfian lookups interleaved with sequential sweeps over the whole key space
+};
+
+[[nodiscard]] std::string_view distributionName(KeyDistribution distribution) noexcept;
+
+// Pre-generated sequence of keys in [0, keySpace), so generating keys stays out of the timed loop.
+// The length is a power of two; `at` wraps around and each thread starts at its own offset.
+class KeyTrace {
+public:
+    KeyTrace(KeyDistribution distribution, uint64_t keySpace, size_t length = size_t{ 1 } << 20, uint64_t seed = 42);
+
+    [[nodiscard]] uint64_t at(size_t position) const noexcept { return mKeys[position & mMask]; }
+    [[nodiscard]] size_t getLength() const noexcept { return mKeys.size(); }
+
+    // Offset that keeps concurrent threads from replaying the trace in lockstep.
+    [[nodiscard]] size_t threadOffset(int threadIndex) const noexcept;
+
+private:
+    std::vector<uint64_t> mKeys;
+    size_t mMask;
+};
+
+#endif // WORKLOAD_H
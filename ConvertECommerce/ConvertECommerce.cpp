@@ -0,0 +1,67 @@
+#include <charconv>
+#include <chrono>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+#include "FakeDatabase.h"
+#include "MappedProductDatabase.h"
+#include "MappedProductWriter.h"
+#include "Logger.h"
+
+constexpr uint64_t PROGRESS_INTERVAL = 1'000'000;
+
+// Writes the FakeDatabase catalog at any scale to a file MappedProductDatabase
+// can open:  ConvertECommerce <output file> [product count]
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: ConvertECommerce <output file> [product count]\n";
+        return 1;
+    }
+
+    size_t productCount = FakeDatabase::DEFAULT_PRODUCT_COUNT;
+    if (argc == 3) {
+        const std::string_view argument(argv[2]);
+        const auto [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), productCount);
+        if (error != std::errc{} || end != argument.data() + argument.size()) {
+            std::cerr << std::format("Invalid product count: {}\n", argument);
+            return 1;
+        }
+    }
+
+    Logger::initialize("ConvertOutput.log");
+    Logger::setLogLevel(LogLevel::INFO);
+
+    try {
+        const auto start = std::chrono::steady_clock::now();
+
+        MappedProductWriter writer(argv[1]);
+        FakeDatabase::generateProducts(productCount, [&writer, productCount](const FakeDatabase::GeneratedProduct& product) {
+            writer.add(product.id, product.category, product.name, product.description, product.thumbnail);
+            if (product.id % PROGRESS_INTERVAL == 0) {
+                std::cout << std::format("Written {} of {} products\n", product.id, productCount);
+            }
+            });
+        writer.finish();
+
+        // Reopening checks the result and shows that startup does not grow with the catalog.
+        const auto written = std::chrono::steady_clock::now();
+        MappedProductDatabase database(argv[1]);
+        const auto opened = std::chrono::steady_clock::now();
+
+        std::cout << std::format("Wrote {} products to {} in {} ms; reopened in {} us\n",
+            database.getProductCount(),
+            argv[1],
+            std::chrono::duration_cast<std::chrono::milliseconds>(written - start).count(),
+            std::chrono::duration_cast<std::chrono::microseconds>(opened - written).count());
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Conversion failed: {}\n", e.what());
+        Logger::shutdown();
+        return 1;
+    }
+
+    Logger::shutdown();
+    return 0;
+}
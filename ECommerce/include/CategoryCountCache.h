@@ -0,0 +1,35 @@
+#ifndef CATEGORY_COUNT_CACHE_H
+#define CATEGORY_COUNT_CACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <span>
+#include "ICache.h"
+#include "LruCache.h"
+#include "Metrics.h"
+
+// Small LRU cache of per-category product counts. Counts are meant to be
+// invalidated when a category's membership changes; the time to live bounds
+// how long one can stay wrong if such a notification is missed.
+class CategoryCountCache : public ICache<uint32_t, size_t> {
+public:
+    CategoryCountCache(size_t capacity, std::chrono::milliseconds ttl);
+    [[nodiscard]] std::optional<size_t> get(uint32_t categoryId) override;
+    void put(uint32_t categoryId, const size_t& count) override;
+    bool invalidate(uint32_t categoryId) override;
+    size_t invalidateMany(std::span<const uint32_t> categoryIds) override;
+    size_t invalidateIf(const std::function<bool(const uint32_t&, const size_t&)>& predicate) override;
+
+    // Applies to counts put from now on; zero keeps them until invalidated or evicted.
+    void setTimeToLive(std::chrono::milliseconds ttl) noexcept;
+
+    [[nodiscard]] size_t getSize() const;
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+
+private:
+    std::atomic<std::chrono::milliseconds> mTimeToLive;
+    LruCache<uint32_t, size_t> mCounts;
+};
+
+#endif // CATEGORY_COUNT_CACHE_H
@@ -0,0 +1,56 @@
+#ifndef CLOCK_PRODUCT_CACHE_H
+#define CLOCK_PRODUCT_CACHE_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "ICache.h"
+#include "Product.h"
+#include "Metrics.h"
+#include "StripedSharedMutex.h"
+
+// Approximate LRU using the CLOCK (second chance) algorithm. A hit only sets the
+// entry's reference bit, so get() runs under a shared lock and never reorders
+// anything; the clock hand clears bits and picks a victim on insertion. The
+// lock is striped per thread, so concurrent hits do not share a lock word.
+class ClockProductCache : public ICache<uint64_t, Product> {
+public:
+    explicit ClockProductCache(size_t capacity);
+    [[nodiscard]] std::optional<Product> get(uint64_t productId) override;
+    void put(uint64_t productId, const Product& product) override;
+    void put(uint64_t productId, Product&& product) override;
+    [[nodiscard]] std::shared_ptr<const Product> getShared(uint64_t productId) override;
+    void putShared(uint64_t productId, std::shared_ptr<const Product> product) override;
+    [[nodiscard]] std::vector<std::shared_ptr<const Product>> getMany(std::span<const uint64_t> productIds) override;
+    bool invalidate(uint64_t productId) override;
+    size_t invalidateMany(std::span<const uint64_t> productIds) override;
+    size_t invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) override;
+
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+
+private:
+    struct Slot {
+        uint64_t productId = 0;
+        std::shared_ptr<const Product> product;
+        std::atomic<bool> referenced{ false };
+    };
+
+    [[nodiscard]] size_t findVictim();
+    // Caller holds mCacheMutex exclusively.
+    void release(std::unordered_map<uint64_t, size_t>::iterator it);
+
+    size_t mCapacity;
+    size_t mHand = 0;
+    std::vector<Slot> mSlots;
+    std::unordered_map<uint64_t, size_t> mIndex;
+    // Empty slots, taken before the clock hand looks for a victim. Starts as every
+    // slot in reverse, so the slots fill in order.
+    std::vector<size_t> mFreeSlots;
+    CacheMetrics mMetrics;
+    mutable StripedSharedMutex mCacheMutex;
+};
+
+#endif // CLOCK_PRODUCT_CACHE_H
@@ -0,0 +1,46 @@
+#ifndef COARSE_CLOCK_H
+#define COARSE_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+// Millisecond-resolution steady time for expiry checks on the cache hot path.
+// While the ticker runs, now() is a relaxed atomic load of a value a background
+// thread refreshes every `resolution`; otherwise it falls back to steady_clock.
+// The ticker is process-wide and the executable owns it: main() calls start()
+// once before creating caches and stop() on the way out. Library code never
+// starts it, so tests stay on steady_clock or setTime() unless they opt in.
+class CoarseClock {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    [[nodiscard]] static time_point now() noexcept {
+        if (mode.load(std::memory_order_relaxed) == Mode::PRECISE) {
+            return std::chrono::steady_clock::now();
+        }
+        return time_point(std::chrono::steady_clock::duration(ticks.load(std::memory_order_relaxed)));
+    }
+
+    static void start(std::chrono::milliseconds resolution = std::chrono::milliseconds(1));
+    // Stops the ticker; now() reads steady_clock again.
+    static void stop();
+
+    // Stops the ticker and pins now() to `time` until start() or stop(); for tests.
+    static void setTime(time_point time);
+    static void advance(std::chrono::steady_clock::duration duration);
+
+private:
+    enum class Mode : uint8_t { PRECISE, TICKING, MANUAL };
+
+    static inline std::atomic<Mode> mode{ Mode::PRECISE };
+    static inline std::atomic<std::chrono::steady_clock::rep> ticks{ 0 };
+    static inline std::mutex controlMutex;
+    static inline std::jthread tickerThread;
+
+    // Caller holds controlMutex.
+    static void stopTicker();
+};
+
+#endif // COARSE_CLOCK_H
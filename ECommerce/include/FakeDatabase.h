@@ -2,20 +2,72 @@
 #define FAKE_DATABASE_H
 
 #include "IDatabase.h"
+#include "Product.h"
+#include "ProductArena.h"
 
+#include <functional>
 #include <unordered_map>
+#include <map>
+#include <mutex>
 #include <optional>
-
-class Product;
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <vector>
 
 class FakeDatabase : public IDatabase {
 public:
-    FakeDatabase();
+    static constexpr size_t DEFAULT_PRODUCT_COUNT = 3000;
+
+    // Fields of one generated product. The views point into buffers that are
+    // reused for the next product, so sinks copy what they keep.
+    struct GeneratedProduct {
+        uint64_t id;
+        uint32_t category;
+        std::string_view name;
+        std::string_view description;
+        std::span<const std::byte> thumbnail;
+    };
+
+    // Produces the catalog this class serves, in ascending ID order, without
+    // holding it in memory; offline tools use it to build larger stores.
+    static void generateProducts(size_t productCount, const std::function<void(const GeneratedProduct&)>& sink);
+
+    // Products get IDs 1..productCount and cycle through categories 100, 101 and 102.
+    explicit FakeDatabase(size_t productCount = DEFAULT_PRODUCT_COUNT);
     std::optional<Product> fetchProductDetails(uint64_t productId) override;
+    std::optional<Product> fetchProductDetails(const Prehashed<uint64_t>& productId) override;
+    // Both are served from the category index: a count is O(1), a page O(limit).
     size_t fetchProductCountByCategory(uint32_t categoryId) override;
+    std::vector<Product> fetchProductsByCategory(uint32_t categoryId, size_t offset, size_t limit) override;
+    std::vector<std::optional<Product>> fetchProductDetailsBatch(std::span<const uint64_t> productIds) override;
+
+    uint64_t subscribe(ChangeListener listener) override;
+    void unsubscribe(uint64_t subscriptionId) override;
+
+    // Simulated writes: each call changes the catalog, then notifies every
+    // listener of the whole batch once.
+    void updateProducts(std::span<const Product> products);
+    void removeProducts(std::span<const uint64_t> productIds);
 
 private:
-    std::unordered_map<uint64_t, Product> mProducts;
+    void notify(std::span<const ProductChange> changes);
+    // Caller holds mProductsMutex exclusively.
+    void indexProduct(uint32_t categoryId, uint64_t productId);
+    void unindexProduct(uint32_t categoryId, uint64_t productId);
+
+    // Declared first so it outlives the products whose fields it holds.
+    ProductArena mArena;
+    // Probed with a caller's Prehashed ID as well as a plain one.
+    std::unordered_map<uint64_t, Product, PrehashedHash<std::hash<uint64_t>>, PrehashedEqual> mProducts;
+    // Category ID to the IDs of its products, sorted so pages are stable.
+    std::unordered_map<uint32_t, std::vector<uint64_t>> mCategoryIndex;
+    mutable std::shared_mutex mProductsMutex;
+
+    // Listeners run under this lock, so unsubscribe() waits for a running one.
+    std::mutex mListenersMutex;
+    std::map<uint64_t, ChangeListener> mListeners;
+    uint64_t mNextSubscriptionId = 1;
 };
 
 #endif // FAKE_DATABASE_H
@@ -0,0 +1,51 @@
+#ifndef FLAT_PRODUCT_INDEX_H
+#define FLAT_PRODUCT_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing hash index from product ID to a 32-bit slot number, laid out
+// Swiss-table style: every slot has a control byte holding 7 bits of its hash,
+// and probing compares a group of sixteen control bytes at once (SSE2 where
+// available), so a lookup usually reads one control group and one slot.
+// Sized once for `capacity` keys and never reallocates; erased slots are
+// reclaimed by an in-place rehash once they crowd the table.
+// Not thread-safe; the owning cache serializes access.
+class FlatProductIndex {
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+    explicit FlatProductIndex(size_t capacity);
+
+    [[nodiscard]] uint32_t find(uint64_t productId) const noexcept;
+    // productId must not be present, and at most `capacity` keys may be stored.
+    void insert(uint64_t productId, uint32_t value);
+    void erase(uint64_t productId) noexcept;
+    void clear() noexcept;
+
+    [[nodiscard]] size_t getSize() const noexcept { return mSize; }
+    [[nodiscard]] size_t getSlotCount() const noexcept { return mControl.size(); }
+
+private:
+    static constexpr size_t GROUP_WIDTH = 16;
+
+    struct Slot {
+        uint64_t productId;
+        uint32_t value;
+    };
+
+    [[nodiscard]] size_t findSlot(uint64_t productId) const noexcept;
+    void rehash();
+
+    std::vector<int8_t> mControl;
+    std::vector<Slot> mSlots;
+    // Live entries are copied here during a rehash; reserved up front so it never allocates.
+    std::vector<Slot> mRehashScratch;
+    size_t mGroupMask;
+    size_t mMaxUsed;
+    size_t mSize = 0;
+    size_t mTombstones = 0;
+};
+
+#endif // FLAT_PRODUCT_INDEX_H
@@ -0,0 +1,40 @@
+#ifndef FREQUENCY_SKETCH_H
+#define FREQUENCY_SKETCH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Count-Min Sketch of recent access frequencies, used by TinyLfuProductCache to
+// decide whether a new product is worth admitting over an eviction victim.
+// Counters are 4 bits wide (saturating at 15), sixteen to a 64-bit word, and
+// every counter is halved after sampleSize increments so old popularity fades.
+// Not thread-safe; the owning cache serializes access.
+class FrequencySketch {
+public:
+    static constexpr uint32_t MAX_FREQUENCY = 15;
+
+    // Sized for roughly `capacity` distinct hot keys; sampleSize defaults to 10 * capacity.
+    explicit FrequencySketch(size_t capacity);
+
+    void increment(uint64_t key) noexcept;
+    [[nodiscard]] uint32_t frequency(uint64_t key) const noexcept;
+
+    [[nodiscard]] size_t getSampleSize() const noexcept { return mSampleSize; }
+
+private:
+    static constexpr size_t DEPTH = 4;
+    static constexpr size_t COUNTERS_PER_WORD = 16;
+
+    [[nodiscard]] std::array<size_t, DEPTH> counterIndexes(uint64_t key) const noexcept;
+    [[nodiscard]] uint32_t counterAt(size_t index) const noexcept;
+    void age() noexcept;
+
+    std::vector<uint64_t> mTable;
+    size_t mCounterMask;
+    size_t mSampleSize;
+    size_t mAdditions = 0;
+};
+
+#endif // FREQUENCY_SKETCH_H
@@ -1,7 +1,20 @@
 #ifndef ICACHE_H
 #define ICACHE_H
 
+#include <functional>
+#include <memory>
 #include <optional>
+#include <span>
+#include <vector>
+#include "CoarseClock.h"
+#include "Prehashed.h"
+
+// A cached value and the coarse-clock time it was stored; value is null on a miss.
+template <typename Value>
+struct TimedValue {
+    std::shared_ptr<const Value> value;
+    CoarseClock::time_point storedAt;
+};
 
 template <typename Key, typename Value>
 class ICache {
@@ -9,6 +22,64 @@ public:
     virtual ~ICache() = default;
     virtual std::optional<Value> get(Key key) = 0;
     virtual void put(Key key, const Value& value) = 0;
+    // Moves the value into the cache's shared storage instead of copying it.
+    virtual void put(Key key, Value&& value) {
+        putShared(key, std::make_shared<const Value>(std::move(value)));
+    }
+
+    // Shared, immutable handle to a cached value; nullptr on a miss. Caches that
+    // store values behind a shared_ptr override these so a hit does not copy.
+    virtual std::shared_ptr<const Value> getShared(Key key) {
+        if (auto value = get(key)) {
+            return std::make_shared<const Value>(std::move(*value));
+        }
+        return nullptr;
+    }
+
+    virtual void putShared(Key key, std::shared_ptr<const Value> value) {
+        put(key, *value);
+    }
+
+    // Lookup that also reports when the value was stored, so callers can judge
+    // its age. Caches that do not record it report every hit as stored now.
+    virtual TimedValue<Value> getTimed(Key key) {
+        return { getShared(key), CoarseClock::now() };
+    }
+
+    // Same lookup with the key's hash already computed by the caller, who hands
+    // it on to the database on a miss. Hash-indexed caches override this to
+    // probe with the carried hash instead of hashing the key again.
+    virtual TimedValue<Value> getTimed(const Prehashed<Key>& key) {
+        return getTimed(key.key);
+    }
+
+    // Removes the value cached for key; returns whether there was one.
+    virtual bool invalidate(Key key) = 0;
+
+    // Returns how many of `keys` were cached. Implementations override this to
+    // take their lock once for the whole batch.
+    virtual size_t invalidateMany(std::span<const Key> keys) {
+        size_t removed = 0;
+        for (const auto& key : keys) {
+            removed += invalidate(key) ? 1 : 0;
+        }
+        return removed;
+    }
+
+    // Removes every value for which predicate(key, value) holds, e.g. all products
+    // of one category, and returns how many. This visits every entry.
+    virtual size_t invalidateIf(const std::function<bool(const Key&, const Value&)>& predicate) = 0;
+
+    // One handle per key, in the same order; nullptr for misses. Implementations
+    // override this to resolve the whole batch under a single lock acquisition.
+    virtual std::vector<std::shared_ptr<const Value>> getMany(std::span<const Key> keys) {
+        std::vector<std::shared_ptr<const Value>> values;
+        values.reserve(keys.size());
+        for (const auto& key : keys) {
+            values.push_back(getShared(key));
+        }
+        return values;
+    }
 };
 
 #endif // ICACHE_H
@@ -1,15 +1,70 @@
 #ifndef IDATABASE_H
 #define IDATABASE_H
 
+#include "Prehashed.h"
 #include "Product.h"
 
+#include <cstdint>
+#include <functional>
 #include <optional>
+#include <span>
+#include <vector>
+
+// One product that changed in the database.
+struct ProductChange {
+    enum class Kind : uint8_t { ADDED, UPDATED, REMOVED };
+
+    uint64_t productId;
+    Kind kind;
+    // The product's category after the change; for a removal, the one it was in.
+    uint32_t categoryId;
+    // Differs from categoryId only when an update moved the product.
+    uint32_t previousCategoryId;
+
+    // Whether the change alters how many products some category holds.
+    [[nodiscard]] bool changesCategoryCounts() const noexcept {
+        return kind != Kind::UPDATED || categoryId != previousCategoryId;
+    }
+};
 
 class IDatabase {
 public:
+    // Receives the changes of one write, in order.
+    using ChangeListener = std::function<void(std::span<const ProductChange>)>;
+
     virtual ~IDatabase() = default;
     virtual std::optional<Product> fetchProductDetails(uint64_t productId) = 0;
+    // Lookup with the ID's hash computed once by the caller; hash-indexed
+    // backends override this to probe their index without rehashing.
+    virtual std::optional<Product> fetchProductDetails(const Prehashed<uint64_t>& productId) {
+        return fetchProductDetails(productId.key);
+    }
     virtual size_t fetchProductCountByCategory(uint32_t categoryId) = 0;
+    // Up to `limit` products of the category in ascending ID order, skipping the first `offset`.
+    virtual std::vector<Product> fetchProductsByCategory(uint32_t categoryId, size_t offset, size_t limit) = 0;
+
+    // One result per ID, in the same order. Backends override this to serve the
+    // whole batch in a single round trip.
+    virtual std::vector<std::optional<Product>> fetchProductDetailsBatch(std::span<const uint64_t> productIds) {
+        std::vector<std::optional<Product>> products;
+        products.reserve(productIds.size());
+        for (uint64_t productId : productIds) {
+            products.push_back(fetchProductDetails(productId));
+        }
+        return products;
+    }
+
+    // Registers `listener` for every later write; returns a subscription ID for
+    // unsubscribe. Backends without a change feed accept it and never call it.
+    virtual uint64_t subscribe(ChangeListener listener) {
+        (void)listener;
+        return 0;
+    }
+
+    // Once this returns, the listener is no longer running and will not be called again.
+    virtual void unsubscribe(uint64_t subscriptionId) {
+        (void)subscriptionId;
+    }
 };
 
 #endif // IDATABASE_H
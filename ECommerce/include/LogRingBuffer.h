@@ -0,0 +1,52 @@
+#ifndef LOG_RING_BUFFER_H
+#define LOG_RING_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+enum class LogLevel;
+enum class LogCategory;
+
+// Fixed-size log entry; messages longer than MAX_MESSAGE_LENGTH are truncated.
+struct LogRecord {
+    static constexpr size_t MAX_MESSAGE_LENGTH = 240;
+
+    std::chrono::system_clock::time_point time;
+    LogLevel level;
+    LogCategory category;
+    uint16_t length = 0;
+    std::array<char, MAX_MESSAGE_LENGTH> message{};
+
+    void setMessage(std::string_view text) noexcept;
+    [[nodiscard]] std::string_view getMessage() const noexcept;
+};
+
+// Bounded lock-free multi-producer queue (Vyukov's sequence-numbered ring).
+// Producers never take a lock; tryPush fails instead of blocking when full.
+// Only the logger's writer thread pops.
+class LogRingBuffer {
+public:
+    // capacity is rounded up to a power of two.
+    explicit LogRingBuffer(size_t capacity);
+
+    [[nodiscard]] bool tryPush(const LogRecord& record) noexcept;
+    [[nodiscard]] bool tryPop(LogRecord& record) noexcept;
+    [[nodiscard]] size_t getCapacity() const noexcept;
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    size_t mMask;
+    std::unique_ptr<Cell[]> mCells;
+    alignas(64) std::atomic<size_t> mEnqueuePosition{ 0 };
+    alignas(64) std::atomic<size_t> mDequeuePosition{ 0 };
+};
+
+#endif // LOG_RING_BUFFER_H
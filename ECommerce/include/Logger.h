@@ -8,6 +8,12 @@
 #include <chrono>
 #include <format>
 #include <filesystem>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <string_view>
+#include "LogRingBuffer.h"
 
 enum class LogLevel {
     INFO,
@@ -22,20 +28,130 @@ enum class LogCategory {
     GENERAL
 };
 
+// What an asynchronous producer does when the queue is full. Overflows are
+// counted under both policies.
+enum class LogOverflowPolicy {
+    DROP,   // discard the record and return immediately
+    BLOCK   // wait until the writer thread frees a slot
+};
+
+// Statements below this level are compiled out entirely by the LOG_* macros.
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL LogLevel::INFO
+#endif
+
 class Logger {
 public:
+    // Appends to `filename`; calling it again switches to another file.
     static void initialize(const std::string& filename);
     static void log(LogLevel level, LogCategory category, const std::string& message);
     static void setLogLevel(LogLevel level);
 
+    [[nodiscard]] static bool isEnabled(LogLevel level) noexcept {
+        return level >= currentLogLevel.load(std::memory_order_relaxed);
+    }
+
+    // Formats only when the level is enabled. In async mode the message is
+    // formatted straight into the queued record, without a temporary string.
+    // Prefer the LOG_* macros, which also skip evaluating the arguments.
+    template <typename... Args>
+    static void logFormat(LogLevel level, LogCategory category, std::format_string<Args...> format, Args&&... args) {
+        if (!isEnabled(level)) return;
+
+        if (AsyncProducer producer; producer) {
+            LogRecord record{ std::chrono::system_clock::now(), level, category };
+            auto result = std::format_to_n(record.message.data(), LogRecord::MAX_MESSAGE_LENGTH, format, std::forward<Args>(args)...);
+            record.length = static_cast<uint16_t>(std::min<size_t>(result.size, LogRecord::MAX_MESSAGE_LENGTH));
+            enqueue(record);
+            return;
+        }
+
+        writeSync(level, category, std::format(format, std::forward<Args>(args)...));
+    }
+
+    // Switches to asynchronous logging: log() only copies the message into a
+    // bounded lock-free queue and a background thread formats, batches and
+    // flushes it. Call after initialize() and before worker threads start.
+    static void enableAsync(size_t queueCapacity = 8192,
+        LogOverflowPolicy overflowPolicy = LogOverflowPolicy::DROP,
+        std::chrono::milliseconds flushInterval = std::chrono::milliseconds(100));
+    // Waits for producers still pushing, drains every queued record, flushes
+    // the file and stops the writer thread. Records logged afterwards are
+    // written synchronously, and enableAsync() may be called again.
+    static void shutdown();
+    [[nodiscard]] static uint64_t getOverflowCount() noexcept;
+
 private:
     static inline std::ofstream logFile;
-    static inline LogLevel currentLogLevel = LogLevel::INFO;
+    static inline std::atomic<LogLevel> currentLogLevel{ LogLevel::INFO };
     static inline std::mutex logMutex;
 
+    static inline std::atomic<bool> asyncEnabled{ false };
+    static inline LogOverflowPolicy asyncOverflowPolicy = LogOverflowPolicy::DROP;
+    static inline std::chrono::milliseconds asyncFlushInterval{ 100 };
+    static inline std::atomic<uint64_t> overflowCount{ 0 };
+    // Producers between seeing async mode enabled and finishing their push.
+    static inline std::atomic<uint32_t> asyncProducers{ 0 };
+    // Serializes enableAsync() and shutdown().
+    static inline std::mutex asyncControlMutex;
+    static inline std::unique_ptr<LogRingBuffer> asyncQueue;
+    // Declared last so it is joined before the queue and the file are destroyed.
+    static inline std::jthread writerThread;
+
+    // Registers the calling thread as a producer while async mode is enabled.
+    // shutdown() clears asyncEnabled and then waits for the count to reach
+    // zero, so a producer that tests true here pushes before the writer's last
+    // drain and never touches a queue enableAsync() has replaced.
+    class AsyncProducer {
+    public:
+        AsyncProducer() noexcept {
+            if (asyncEnabled.load(std::memory_order_acquire)) {
+                asyncProducers.fetch_add(1);
+                // Re-checked after registering; pairs with the store in shutdown().
+                mActive = asyncEnabled.load();
+                if (!mActive) {
+                    asyncProducers.fetch_sub(1, std::memory_order_release);
+                }
+            }
+        }
+        ~AsyncProducer() {
+            if (mActive) {
+                asyncProducers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+        AsyncProducer(const AsyncProducer&) = delete;
+        AsyncProducer& operator=(const AsyncProducer&) = delete;
+
+        explicit operator bool() const noexcept { return mActive; }
+
+    private:
+        bool mActive = false;
+    };
+
+    static void enqueue(const LogRecord& record);
+    static void writeSync(LogLevel level, LogCategory category, std::string_view message);
+    static void runWriter(std::stop_token stopToken);
+    static void writeRecord(std::string& batch, const LogRecord& record);
+
     static std::string getCurrentTime();
+    static std::string formatTime(std::chrono::system_clock::time_point time);
     static constexpr std::string_view logLevelToString(LogLevel level);
     static constexpr std::string_view logCategoryToString(LogCategory category);
 };
 
+// The level check happens before the format arguments are evaluated, so a
+// disabled statement costs one branch (or nothing below LOGGER_MIN_LEVEL).
+#define LOG_AT_LEVEL(level, category, ...)                          \
+    do {                                                            \
+        if constexpr ((level) >= LOGGER_MIN_LEVEL) {                \
+            if (Logger::isEnabled(level)) {                         \
+                Logger::logFormat((level), (category), __VA_ARGS__); \
+            }                                                       \
+        }                                                           \
+    } while (false)
+
+#define LOG_INFO(category, ...)    LOG_AT_LEVEL(LogLevel::INFO, category, __VA_ARGS__)
+#define LOG_WARNING(category, ...) LOG_AT_LEVEL(LogLevel::WARNING, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...)   LOG_AT_LEVEL(LogLevel::ERROR, category, __VA_ARGS__)
+
 #endif
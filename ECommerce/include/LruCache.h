@@ -0,0 +1,526 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "CoarseClock.h"
+#include "Metrics.h"
+#include "Prehashed.h"
+
+// Eviction policies: what a hit does to its entry's place in the list.
+struct LruEviction {
+    // A hit moves the entry to the hot end, so the coldest entry is the least recently used.
+    static constexpr bool PROMOTE_ON_HIT = true;
+};
+
+struct FifoEviction {
+    // Entries leave in insertion order and hits do not touch the list.
+    static constexpr bool PROMOTE_ON_HIT = false;
+};
+
+// Lock policies. NoLocking is for caches confined to one thread: its mutex
+// compiles away, so they pay nothing for locking.
+struct NoLocking {
+    struct Mutex {
+        void lock() noexcept {}
+        bool try_lock() noexcept { return true; }
+        void unlock() noexcept {}
+    };
+    static constexpr size_t SHARDS = 1;
+};
+
+struct MutexLocking {
+    using Mutex = std::mutex;
+    static constexpr size_t SHARDS = 1;
+};
+
+// Splits the cache into `Shards` independently locked lists. Recency and the
+// limits apply per shard, each getting ceil(limit / Shards); an entry heavier
+// than a shard's share of maxWeight is rejected.
+template <size_t Shards>
+struct ShardedLocking {
+    static_assert(std::has_single_bit(Shards), "Shard count must be a power of two.");
+    using Mutex = std::mutex;
+    static constexpr size_t SHARDS = Shards;
+};
+
+// Size accounting: SizeOf(key, value) is the weight an entry is charged
+// against LruLimits::maxWeight. CountEntries makes the weight an entry count.
+struct CountEntries {
+    template <typename Key, typename Value>
+    [[nodiscard]] constexpr size_t operator()(const Key&, const Value&) const noexcept {
+        return 1;
+    }
+};
+
+struct LruLimits {
+    size_t maxEntries = std::numeric_limits<size_t>::max();
+    size_t maxWeight = std::numeric_limits<size_t>::max();
+    // Heavier entries are rejected rather than flushing the cache to fit them; 0 means maxWeight.
+    size_t maxEntryWeight = 0;
+};
+
+// What LruCache's lookups accept for Key: a Prehashed key, a type a
+// transparent Hash probes with directly, or anything converting to Key, which
+// is converted once so the map only ever compares Keys.
+template <typename K, typename Key, typename Hash>
+concept LruLookupKey = IsPrehashed<K>::value || TransparentKeyFor<K, Key, Hash> || std::convertible_to<const K&, Key>;
+
+// Generic in-memory cache with a recency list and a hash index, configured at
+// compile time: Policy picks what a hit does, LockPolicy how (and whether) the
+// cache is locked and SizeOf what the limits count. Lookups accept the key, a
+// Prehashed key whose hash is reused for the shard and the map probe, or, with
+// a transparent Hash such as StringHash, any type it hashes, e.g. a
+// string_view into a std::string-keyed cache. Values are returned by
+// copy, so large values are best stored behind a shared_ptr, as ProductCache
+// does. Entries may carry a time to live; expired ones are dropped lazily, when
+// looked up or when a put needs room and they are at the cold end.
+template <typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Policy = LruEviction,
+    typename LockPolicy = MutexLocking,
+    typename SizeOf = CountEntries>
+class LruCache {
+    struct Entry {
+        Key key;
+        Value value;
+        size_t weight;
+        CoarseClock::time_point storedAt;
+        CoarseClock::time_point expiresAt;
+    };
+
+public:
+    // Receives each entry evicted to make room, with the shard lock held, so it
+    // must be quick and must not call back into the cache. Expired, rejected and
+    // invalidated entries are not reported.
+    using EvictionListener = std::function<void(const Key& key, const Value& value)>;
+
+    static constexpr size_t SHARDS = LockPolicy::SHARDS;
+    // Approximate memory per entry besides what the key and value own: the list
+    // node with its two links, and a hash map node (key, list iterator, next
+    // pointer, cached hash) plus its bucket slot.
+    static constexpr size_t ENTRY_OVERHEAD = sizeof(Entry) + 2 * sizeof(void*) + sizeof(Key) + 4 * sizeof(void*);
+
+    explicit LruCache(size_t capacity)
+        : LruCache(LruLimits{ .maxEntries = capacity })
+    {
+    }
+
+    explicit LruCache(const LruLimits& limits, Hash hash = Hash{}, SizeOf sizeOf = SizeOf{})
+        : mLimits{ limits }
+        , mHash{ std::move(hash) }
+        , mSizeOf{ std::move(sizeOf) }
+    {
+        if (mLimits.maxEntries == 0 || mLimits.maxWeight == 0) {
+            throw std::invalid_argument("Cache limits must be greater than zero.");
+        }
+        if (mLimits.maxEntryWeight == 0 || mLimits.maxEntryWeight > mLimits.maxWeight) {
+            mLimits.maxEntryWeight = mLimits.maxWeight;
+        }
+        mShardLimits = LruLimits{ perShard(mLimits.maxEntries), perShard(mLimits.maxWeight), mLimits.maxEntryWeight };
+        // A put evicts within one shard, so an entry has to fit in one.
+        mShardLimits.maxEntryWeight = std::min(mShardLimits.maxEntryWeight, mShardLimits.maxWeight);
+        for (auto& shard : mShards) {
+            shard.map = Map(0, PrehashedHash<Hash>{ mHash });
+        }
+    }
+
+    // Hashes `key` once for lookups that pass it on to other layers as well.
+    template <typename K>
+        requires std::same_as<K, Key> || TransparentKeyFor<K, Key, Hash>
+    [[nodiscard]] Prehashed<K, Hash> prehash(const K& key) const {
+        return Prehashed<K, Hash>(key, mHash);
+    }
+
+    template <LruLookupKey<Key, Hash> K>
+    [[nodiscard]] std::optional<Value> get(const K& key) {
+        ScopedLatency latency(mMetrics.getLatency);
+        std::optional<Value> value;
+        find(hashed(key), CoarseClock::now(), [&value](const Entry& entry) { value.emplace(entry.value); });
+        return value;
+    }
+
+    // Also reports when the value was stored.
+    template <LruLookupKey<Key, Hash> K>
+    [[nodiscard]] std::optional<std::pair<Value, CoarseClock::time_point>> getTimed(const K& key) {
+        ScopedLatency latency(mMetrics.getLatency);
+        std::optional<std::pair<Value, CoarseClock::time_point>> value;
+        find(hashed(key), CoarseClock::now(), [&value](const Entry& entry) { value.emplace(entry.value, entry.storedAt); });
+        return value;
+    }
+
+    // Calls sink(position, const Value*) once per key, with the key's position
+    // in `keys` and nullptr for a miss. A single-shard cache visits the keys in
+    // order under one lock; a sharded one groups them by shard and takes each
+    // shard's lock once, keeping their order within a shard. Returns the number
+    // of hits.
+    template <typename Sink>
+    size_t getMany(std::span<const Key> keys, Sink&& sink) {
+        const auto now = CoarseClock::now();
+        size_t hits = 0;
+        const auto visit = [&](Shard& shard, size_t position, const auto& key) {
+            if (auto it = lookup(shard, key, now); it != shard.list.end()) {
+                sink(position, &it->value);
+                ++hits;
+            }
+            else {
+                sink(position, static_cast<const Value*>(nullptr));
+            }
+        };
+
+        if constexpr (SHARDS == 1) {
+            std::scoped_lock lock(mShards[0].mutex);
+            for (size_t position = 0; position < keys.size(); ++position) {
+                visit(mShards[0], position, keys[position]);
+            }
+        }
+        else {
+            std::vector<Prehashed<const Key&, Hash>> hashedKeys;
+            hashedKeys.reserve(keys.size());
+            // Counting sort of the positions by shard: shard s owns
+            // order[bounds[s], bounds[s + 1]).
+            std::array<size_t, SHARDS + 1> bounds{};
+            for (const Key& key : keys) {
+                hashedKeys.emplace_back(key, mHash);
+                ++bounds[shardIndex(hashedKeys.back().hash) + 1];
+            }
+            std::partial_sum(bounds.begin(), bounds.end(), bounds.begin());
+            std::vector<size_t> order(keys.size());
+            auto next = bounds;
+            for (size_t position = 0; position < keys.size(); ++position) {
+                order[next[shardIndex(hashedKeys[position].hash)]++] = position;
+            }
+
+            for (size_t index = 0; index < SHARDS; ++index) {
+                if (bounds[index] == bounds[index + 1]) {
+                    continue;
+                }
+                Shard& shard = mShards[index];
+                std::scoped_lock lock(shard.mutex);
+                for (size_t i = bounds[index]; i < bounds[index + 1]; ++i) {
+                    visit(shard, order[i], hashedKeys[order[i]]);
+                }
+            }
+        }
+
+        mMetrics.hits.increment(hits);
+        mMetrics.misses.increment(keys.size() - hits);
+        return hits;
+    }
+
+    // Caches `value` at the hot end, replacing any entry for `key`, for `ttl`
+    // (zero never expires). Returns false if the value weighs more than
+    // maxEntryWeight or a shard's share of maxWeight; it is not cached, nothing
+    // is evicted for it and any older entry is removed.
+    bool put(const Key& key, Value value, std::chrono::milliseconds ttl = std::chrono::milliseconds::zero()) {
+        const size_t weight = mSizeOf(key, value);
+        const auto now = CoarseClock::now();
+        const auto hashedKey = hashed(key);
+        Shard& shard = shardFor(hashedKey.hash);
+        std::scoped_lock lock(shard.mutex);
+
+        if (auto it = shard.map.find(hashedKey); it != shard.map.end()) {
+            erase(shard, it);
+        }
+        if (weight > mShardLimits.maxEntryWeight) {
+            mMetrics.rejections.increment();
+            return false;
+        }
+
+        mMetrics.puts.increment();
+        shard.list.push_front(Entry{ key, std::move(value), weight, now, expiryFor(now, ttl) });
+        shard.map.emplace(key, shard.list.begin());
+        shard.weight += weight;
+
+        // The new entry fits the shard on its own, so this stops before
+        // reaching it. An expired entry at the cold end makes room for free:
+        // dropping it is an expiration, not an eviction.
+        while (shard.map.size() > mShardLimits.maxEntries || shard.weight > mShardLimits.maxWeight) {
+            const Entry& victim = shard.list.back();
+            if (victim.expiresAt <= now) {
+                mMetrics.expirations.increment();
+            }
+            else {
+                mMetrics.evictions.increment();
+                if (mEvictionListener) {
+                    mEvictionListener(victim.key, victim.value);
+                }
+            }
+            erase(shard, shard.map.find(victim.key));
+        }
+        return true;
+    }
+
+    // Adds values behind the entries already cached, in order, without evicting
+    // anything: keys already cached, values over maxEntryWeight and values that
+    // do not fit their shard's remaining weight are skipped, and values for a
+    // shard at maxEntries are dropped. keyOf(value) gives each value's key.
+    // Returns how many were added.
+    template <typename Values, typename KeyOf>
+    size_t appendCold(const Values& values, KeyOf&& keyOf, std::chrono::milliseconds ttl = std::chrono::milliseconds::zero()) {
+        const auto now = CoarseClock::now();
+        const auto expiresAt = expiryFor(now, ttl);
+        std::array<bool, SHARDS> full{};
+        size_t fullShards = 0;
+        size_t added = 0;
+
+        Shard* locked = nullptr;
+        std::unique_lock<typename LockPolicy::Mutex> lock;
+        for (const auto& value : values) {
+            const Key& key = keyOf(value);
+            const auto hashedKey = hashed(key);
+            Shard& shard = shardFor(hashedKey.hash);
+            if (locked != &shard) {
+                lock = std::unique_lock(shard.mutex);
+                locked = &shard;
+            }
+
+            const auto index = static_cast<size_t>(&shard - mShards.data());
+            if (full[index]) {
+                continue;
+            }
+            const size_t weight = mSizeOf(key, value);
+            if (weight > mShardLimits.maxEntryWeight || shard.map.contains(hashedKey)) {
+                continue;
+            }
+            if (shard.map.size() >= mShardLimits.maxEntries) {
+                full[index] = true;
+                if (++fullShards == SHARDS) {
+                    break;
+                }
+                continue;
+            }
+            // A lighter value later on may still fit
+            if (shard.weight + weight > mShardLimits.maxWeight) {
+                continue;
+            }
+
+            shard.list.push_back(Entry{ key, value, weight, now, expiresAt });
+            shard.map.emplace(key, std::prev(shard.list.end()));
+            shard.weight += weight;
+            ++added;
+        }
+
+        mMetrics.puts.increment(added);
+        return added;
+    }
+
+    template <LruLookupKey<Key, Hash> K>
+    bool invalidate(const K& key) {
+        const bool removed = remove(hashed(key));
+        mMetrics.invalidations.increment(removed ? 1 : 0);
+        return removed;
+    }
+
+    size_t invalidateMany(std::span<const Key> keys) {
+        size_t removed = 0;
+        for (const Key& key : keys) {
+            removed += remove(hashed(key)) ? 1 : 0;
+        }
+        mMetrics.invalidations.increment(removed);
+        return removed;
+    }
+
+    // Removes every entry for which predicate(key, value) holds; visits every entry.
+    template <typename Predicate>
+    size_t invalidateIf(Predicate&& predicate) {
+        size_t removed = 0;
+        for (auto& shard : mShards) {
+            std::scoped_lock lock(shard.mutex);
+            for (auto it = shard.list.begin(); it != shard.list.end();) {
+                auto current = it++;
+                if (predicate(current->key, current->value)) {
+                    erase(shard, shard.map.find(current->key));
+                    ++removed;
+                }
+            }
+        }
+        mMetrics.invalidations.increment(removed);
+        return removed;
+    }
+
+    // Calls visitor(key, value) for every live entry, hottest first within each
+    // shard, holding one shard lock at a time.
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        const auto now = CoarseClock::now();
+        for (const auto& shard : mShards) {
+            std::scoped_lock lock(shard.mutex);
+            for (const auto& entry : shard.list) {
+                if (entry.expiresAt > now) {
+                    visitor(entry.key, entry.value);
+                }
+            }
+        }
+    }
+
+    void setEvictionListener(EvictionListener listener) {
+        for (auto& shard : mShards) {
+            shard.mutex.lock();
+        }
+        mEvictionListener = std::move(listener);
+        for (auto& shard : mShards) {
+            shard.mutex.unlock();
+        }
+    }
+
+    [[nodiscard]] const LruLimits& getLimits() const noexcept {
+        return mLimits;
+    }
+
+    [[nodiscard]] size_t getSize() const {
+        size_t size = 0;
+        for (const auto& shard : mShards) {
+            std::scoped_lock lock(shard.mutex);
+            size += shard.map.size();
+        }
+        return size;
+    }
+
+    [[nodiscard]] size_t getWeight() const {
+        size_t weight = 0;
+        for (const auto& shard : mShards) {
+            std::scoped_lock lock(shard.mutex);
+            weight += shard.weight;
+        }
+        return weight;
+    }
+
+    // entries counts the live and not yet dropped expired entries; bytes is the total weight.
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const {
+        auto snapshot = mMetrics.snapshot();
+        for (const auto& shard : mShards) {
+            std::scoped_lock lock(shard.mutex);
+            snapshot.entries += shard.map.size();
+            snapshot.bytes += shard.weight;
+        }
+        return snapshot;
+    }
+
+private:
+    using List = std::list<Entry>;
+    using Map = std::unordered_map<Key, typename List::iterator, PrehashedHash<Hash>, PrehashedEqual>;
+
+    struct alignas(64) Shard {
+        mutable typename LockPolicy::Mutex mutex;
+        List list;
+        Map map;
+        size_t weight = 0;
+    };
+
+    [[nodiscard]] static constexpr size_t perShard(size_t limit) noexcept {
+        return limit == std::numeric_limits<size_t>::max() ? limit : (limit + SHARDS - 1) / SHARDS;
+    }
+
+    [[nodiscard]] static CoarseClock::time_point expiryFor(CoarseClock::time_point now, std::chrono::milliseconds ttl) noexcept {
+        return ttl > std::chrono::milliseconds::zero() ? now + ttl : CoarseClock::time_point::max();
+    }
+
+    // A Prehashed key is passed through. A Key or a transparently hashed type
+    // is hashed once here and held by reference; anything else is converted to
+    // a Key first.
+    template <typename K>
+    [[nodiscard]] auto hashed(const K& key) const {
+        if constexpr (IsPrehashed<K>::value) {
+            static_assert(std::is_same_v<K, Prehashed<decltype(key.key), Hash>>, "Key was prehashed with a different hash.");
+            return key;
+        }
+        else if constexpr (std::is_same_v<K, Key> || TransparentKeyFor<K, Key, Hash>) {
+            return Prehashed<const K&, Hash>(key, mHash);
+        }
+        else {
+            return Prehashed<Key, Hash>(static_cast<Key>(key), mHash);
+        }
+    }
+
+    [[nodiscard]] static size_t shardIndex(size_t hash) noexcept {
+        if constexpr (SHARDS == 1) {
+            return 0;
+        }
+        else {
+            // Fibonacci hashing takes the shard from the high bits, which the
+            // map's own bucket index does not use.
+            const uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(mixed >> (64 - std::countr_zero(SHARDS)));
+        }
+    }
+
+    [[nodiscard]] Shard& shardFor(size_t hash) noexcept {
+        return mShards[shardIndex(hash)];
+    }
+
+    // Caller holds the shard lock. Drops the entry if it has expired and
+    // otherwise applies the policy's hit.
+    template <typename HashedKey>
+    [[nodiscard]] typename List::iterator lookup(Shard& shard, const HashedKey& key, CoarseClock::time_point now) {
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return shard.list.end();
+        }
+        if (it->second->expiresAt <= now) {
+            mMetrics.expirations.increment();
+            erase(shard, it);
+            return shard.list.end();
+        }
+        if constexpr (Policy::PROMOTE_ON_HIT) {
+            shard.list.splice(shard.list.begin(), shard.list, it->second);
+        }
+        return it->second;
+    }
+
+    template <typename HashedKey, typename OnHit>
+    void find(const HashedKey& key, CoarseClock::time_point now, OnHit&& onHit) {
+        Shard& shard = shardFor(key.hash);
+        std::scoped_lock lock(shard.mutex);
+        if (auto it = lookup(shard, key, now); it != shard.list.end()) {
+            mMetrics.hits.increment();
+            onHit(*it);
+            return;
+        }
+        mMetrics.misses.increment();
+    }
+
+    template <typename HashedKey>
+    bool remove(const HashedKey& key) {
+        Shard& shard = shardFor(key.hash);
+        std::scoped_lock lock(shard.mutex);
+        if (auto it = shard.map.find(key); it != shard.map.end()) {
+            erase(shard, it);
+            return true;
+        }
+        return false;
+    }
+
+    void erase(Shard& shard, typename Map::iterator it) {
+        shard.weight -= it->second->weight;
+        shard.list.erase(it->second);
+        shard.map.erase(it);
+    }
+
+    LruLimits mLimits;
+    LruLimits mShardLimits;
+    Hash mHash;
+    SizeOf mSizeOf;
+    std::array<Shard, SHARDS> mShards;
+    EvictionListener mEvictionListener;
+    CacheMetrics mMetrics;
+};
+
+#endif // LRU_CACHE_H
@@ -0,0 +1,35 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+// Read-only view of a whole file mapped into the address space. Opening costs
+// the same for any file size; pages are read in by the OS on first touch.
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::span<const std::byte> getBytes() const noexcept { return { mData, mSize }; }
+
+    // Drops the mapped pages from this process and, where the OS allows it, from
+    // the page cache, so the next touches fault them in again; for benchmarks.
+    void evict() noexcept;
+
+private:
+    const std::byte* mData = nullptr;
+    size_t mSize = 0;
+#ifdef _WIN32
+    void* mFile = nullptr;
+    void* mMapping = nullptr;
+#else
+    int mFile = -1;
+#endif
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,54 @@
+#ifndef MAPPED_PRODUCT_DATABASE_H
+#define MAPPED_PRODUCT_DATABASE_H
+
+#include "IDatabase.h"
+#include "MappedFile.h"
+#include "MappedProductFormat.h"
+#include "Product.h"
+
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Read-only catalog served straight from a file written by MappedProductWriter.
+// Opening maps the file and checks the header, so startup does not depend on
+// the catalog size; a lookup probes the hashed ID index and copies one record,
+// usually touching two pages. The file never changes while open, so reads take
+// no locks and there is no change feed.
+class MappedProductDatabase : public IDatabase {
+public:
+    explicit MappedProductDatabase(const std::filesystem::path& path);
+
+    std::optional<Product> fetchProductDetails(uint64_t productId) override;
+    size_t fetchProductCountByCategory(uint32_t categoryId) override;
+    std::vector<Product> fetchProductsByCategory(uint32_t categoryId, size_t offset, size_t limit) override;
+    std::vector<std::optional<Product>> fetchProductDetailsBatch(std::span<const uint64_t> productIds) override;
+
+    [[nodiscard]] size_t getProductCount() const noexcept { return mHeader.productCount; }
+    // Makes the next lookups cold again; see MappedFile::evict().
+    void evict() noexcept { mFile.evict(); }
+
+private:
+    static constexpr uint64_t NOT_FOUND = 0;
+
+    // Sections are only 8-byte aligned inside the mapping, so values are copied out.
+    template<typename T>
+    [[nodiscard]] T load(uint64_t offset) const noexcept {
+        T value;
+        std::memcpy(&value, mBytes.data() + offset, sizeof(T));
+        return value;
+    }
+
+    // Offset of the product's record, or NOT_FOUND; offset 0 holds the header.
+    [[nodiscard]] uint64_t findRecord(uint64_t productId) const noexcept;
+    [[nodiscard]] std::optional<MappedProductFormat::CategoryEntry> findCategory(uint32_t categoryId) const noexcept;
+    [[nodiscard]] Product readRecord(uint64_t offset) const;
+
+    MappedFile mFile;
+    std::span<const std::byte> mBytes;
+    MappedProductFormat::Header mHeader{};
+};
+
+#endif // MAPPED_PRODUCT_DATABASE_H
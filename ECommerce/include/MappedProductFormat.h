@@ -0,0 +1,73 @@
+#ifndef MAPPED_PRODUCT_FORMAT_H
+#define MAPPED_PRODUCT_FORMAT_H
+
+#include <array>
+#include <cstdint>
+
+// On-disk layout shared by MappedProductWriter and MappedProductDatabase.
+// Integers are stored in native byte order and every section starts on an
+// 8-byte boundary:
+//
+//   Header
+//   records    RecordHeader + name + description + thumbnail, padded to 8 bytes
+//   index      IndexEntry[1 << indexBits], open-addressed hash table on the product ID
+//   categories CategoryEntry[categoryCount], sorted by category ID
+//   members    IndexEntry[productCount], grouped by category, each group sorted by ID
+struct MappedProductFormat {
+    static constexpr std::array<char, 8> MAGIC{ 'X', 'M', 'L', 'R', 'U', 'P', 'D', 'B' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t ALIGNMENT = 8;
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        // The index has 2^indexBits slots, at most two thirds of them used.
+        uint32_t indexBits;
+        uint64_t productCount;
+        uint64_t indexOffset;
+        uint64_t categoryCount;
+        uint64_t categoryOffset;
+        uint64_t membersOffset;
+        // Lets a reader reject a truncated file before touching any section.
+        uint64_t fileSize;
+    };
+
+    struct RecordHeader {
+        uint64_t id;
+        uint32_t category;
+        uint32_t nameLength;
+        uint32_t descriptionLength;
+        uint32_t thumbnailLength;
+    };
+
+    // An index slot with recordOffset 0 is empty; offset 0 holds the header.
+    struct IndexEntry {
+        uint64_t productId;
+        uint64_t recordOffset;
+    };
+
+    struct CategoryEntry {
+        uint32_t categoryId;
+        uint32_t reserved;
+        // Position of the category's first entry in the members section.
+        uint64_t firstMember;
+        uint64_t memberCount;
+    };
+
+    // Fibonacci hashing: consecutive IDs land in different slots, and the top
+    // bits are used so any table size works with a shift.
+    [[nodiscard]] static constexpr uint64_t indexSlot(uint64_t productId, uint32_t indexBits) noexcept {
+        return indexBits == 0 ? 0 : (productId * 0x9E3779B97F4A7C15ULL) >> (64 - indexBits);
+    }
+
+    [[nodiscard]] static constexpr uint64_t align(uint64_t offset) noexcept {
+        return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+};
+
+static_assert(sizeof(MappedProductFormat::Header) == 64);
+static_assert(sizeof(MappedProductFormat::RecordHeader) == 24);
+static_assert(sizeof(MappedProductFormat::IndexEntry) == 16);
+static_assert(sizeof(MappedProductFormat::CategoryEntry) == 24);
+
+#endif // MAPPED_PRODUCT_FORMAT_H
@@ -0,0 +1,48 @@
+#ifndef MAPPED_PRODUCT_WRITER_H
+#define MAPPED_PRODUCT_WRITER_H
+
+#include "MappedProductFormat.h"
+#include "Product.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Streams products into a file that MappedProductDatabase can open. Records are
+// written as they arrive; only 20 bytes per product are kept in memory until
+// finish() builds the hash index and the category sections and appends them.
+class MappedProductWriter {
+public:
+    explicit MappedProductWriter(const std::filesystem::path& path);
+
+    // IDs must be strictly ascending across calls, which keeps every category's
+    // members sorted for paging without a sort at the end.
+    void add(uint64_t id,
+        uint32_t category,
+        std::string_view name,
+        std::string_view description,
+        std::span<const std::byte> thumbnail);
+    void add(const Product& product);
+
+    // Writes the index, the category sections and the header. The file cannot
+    // be opened before this returns, and no product can be added after it.
+    void finish();
+
+    [[nodiscard]] size_t getProductCount() const noexcept { return mIndex.size(); }
+
+private:
+    void write(const void* data, size_t size);
+
+    std::filesystem::path mPath;
+    std::ofstream mOutput;
+    uint64_t mOffset = 0;
+    std::vector<MappedProductFormat::IndexEntry> mIndex;
+    // Category of each entry in mIndex.
+    std::vector<uint32_t> mCategories;
+    bool mFinished = false;
+};
+
+#endif // MAPPED_PRODUCT_WRITER_H
@@ -0,0 +1,168 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Global switch so the cost of recording can be measured against a baseline.
+class Metrics {
+public:
+    [[nodiscard]] static bool isEnabled() noexcept { return enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool value) noexcept { enabled.store(value, std::memory_order_relaxed); }
+
+    // Latency is timed on one call in every `rate` per thread; counters stay exact.
+    // Reading the clock twice costs more than the rest of a cache hit.
+    static void setLatencySampleRate(uint32_t rate) noexcept { latencySampleRate.store(rate == 0 ? 1 : rate, std::memory_order_relaxed); }
+    [[nodiscard]] static bool shouldSampleLatency() noexcept;
+
+    // Stable per-thread stripe so concurrent writers touch different cache lines.
+    [[nodiscard]] static size_t threadStripe() noexcept;
+
+private:
+    static inline std::atomic<bool> enabled{ true };
+    static inline std::atomic<uint32_t> latencySampleRate{ 16 };
+};
+
+// Monotonic counter striped across cache lines; increments never contend
+// unless more threads than stripes are writing.
+class ShardedCounter {
+public:
+    void increment(uint64_t amount = 1) noexcept;
+    [[nodiscard]] uint64_t load() const noexcept;
+
+private:
+    static constexpr size_t STRIPES = 16;
+
+    struct alignas(64) Stripe {
+        std::atomic<uint64_t> value{ 0 };
+    };
+
+    std::array<Stripe, STRIPES> mStripes;
+};
+
+// HDR-style log-linear histogram of nanosecond latencies: every power of two
+// is split into SUB_BUCKETS linear buckets, bounding the relative error of a
+// recorded value to 1 / SUB_BUCKETS.
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = size_t{ 1 } << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sumNanos = 0;
+        std::vector<uint64_t> buckets = std::vector<uint64_t>(BUCKETS, 0);
+
+        // Upper bound, in nanoseconds, of the bucket holding the given quantile (0..1).
+        [[nodiscard]] uint64_t percentile(double quantile) const noexcept;
+        Snapshot& operator+=(const Snapshot& other);
+    };
+
+    void record(std::chrono::nanoseconds latency) noexcept;
+    [[nodiscard]] Snapshot snapshot() const;
+
+    [[nodiscard]] static size_t bucketIndex(uint64_t nanos) noexcept;
+    [[nodiscard]] static uint64_t bucketUpperBound(size_t index) noexcept;
+
+private:
+    static constexpr size_t STRIPES = 4;
+
+    struct alignas(64) Stripe {
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> sumNanos{ 0 };
+    };
+
+    std::array<Stripe, STRIPES> mStripes;
+};
+
+// Measures the lifetime of the scope into a histogram when metrics are enabled
+// and this call is picked by the latency sample rate.
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram& histogram) noexcept;
+    ~ScopedLatency();
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyHistogram* mHistogram;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+struct CacheMetricsSnapshot {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t puts = 0;
+    uint64_t evictions = 0;
+    uint64_t rejections = 0;
+    uint64_t expirations = 0;
+    uint64_t invalidations = 0;
+    LatencyHistogram::Snapshot getLatency;
+    // Gauges filled in by the cache itself; bytes stays 0 for caches that only count entries.
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+
+    CacheMetricsSnapshot& operator+=(const CacheMetricsSnapshot& other);
+};
+
+struct CacheMetrics {
+    ShardedCounter hits;
+    ShardedCounter misses;
+    ShardedCounter puts;
+    ShardedCounter evictions;
+    ShardedCounter rejections;
+    ShardedCounter expirations;
+    ShardedCounter invalidations;
+    LatencyHistogram getLatency;
+
+    [[nodiscard]] CacheMetricsSnapshot snapshot() const;
+};
+
+struct ServiceMetricsSnapshot {
+    uint64_t requests = 0;
+    uint64_t cacheHits = 0;
+    uint64_t cacheMisses = 0;
+    uint64_t databaseFetches = 0;
+    uint64_t databaseNotFound = 0;
+    uint64_t coalescedFetches = 0;
+    uint64_t staleHits = 0;
+    uint64_t backgroundRefreshes = 0;
+    uint64_t invalidations = 0;
+    uint64_t rejectedFetches = 0;
+    LatencyHistogram::Snapshot requestLatency;
+};
+
+struct ServiceMetrics {
+    ShardedCounter requests;
+    ShardedCounter cacheHits;
+    ShardedCounter cacheMisses;
+    ShardedCounter databaseFetches;
+    ShardedCounter databaseNotFound;
+    ShardedCounter staleHits;
+    ShardedCounter backgroundRefreshes;
+    ShardedCounter invalidations;
+    ShardedCounter rejectedFetches;
+    LatencyHistogram requestLatency;
+
+    [[nodiscard]] ServiceMetricsSnapshot snapshot() const;
+};
+
+// Renders snapshots in the Prometheus text exposition format.
+class PrometheusExporter {
+public:
+    [[nodiscard]] static std::string format(std::string_view name, const CacheMetricsSnapshot& metrics);
+    [[nodiscard]] static std::string format(std::string_view name, const ServiceMetricsSnapshot& metrics);
+    // Written to a temporary file first, so a scraper never reads a partial dump.
+    static void writeToFile(const std::filesystem::path& path, std::string_view text);
+};
+
+#endif // METRICS_H
@@ -0,0 +1,76 @@
+#ifndef NUMA_PRODUCT_CACHE_H
+#define NUMA_PRODUCT_CACHE_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include "ICache.h"
+#include "Metrics.h"
+#include "NumaTopology.h"
+#include "Product.h"
+#include "ProductCache.h"
+
+// One ProductCache replica per NUMA node. Every call is served by the replica
+// of the node the calling thread is running on, so a hit touches only memory
+// that node allocated. A local miss checks the other replicas; a product found
+// there is copied into the local replica by the calling thread, which places
+// the copy, its list node and its map slot in local memory under the OS's
+// default first-touch policy. Puts fill the caller's replica and drop other
+// replicas' copies; invalidations remove every copy. Nothing takes a lock
+// across replicas: a copy that races a put or an invalidation is undone. On a
+// single-node machine every call goes straight to one ProductCache, which also
+// keeps the metrics.
+class NumaProductCache : public ICache<uint64_t, Product> {
+public:
+    // Every node gets the whole `capacityPerNode`, so a product hot on all
+    // nodes is held once per node.
+    explicit NumaProductCache(size_t capacityPerNode, NumaTopology topology = NumaTopology::detect());
+
+    [[nodiscard]] std::optional<Product> get(uint64_t productId) override;
+    void put(uint64_t productId, const Product& product) override;
+    void put(uint64_t productId, Product&& product) override;
+    [[nodiscard]] std::shared_ptr<const Product> getShared(uint64_t productId) override;
+    void putShared(uint64_t productId, std::shared_ptr<const Product> product) override;
+    [[nodiscard]] TimedValue<Product> getTimed(uint64_t productId) override;
+    [[nodiscard]] std::vector<std::shared_ptr<const Product>> getMany(std::span<const uint64_t> productIds) override;
+    bool invalidate(uint64_t productId) override;
+    size_t invalidateMany(std::span<const uint64_t> productIds) override;
+    // Counts a product once however many replicas held it.
+    size_t invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) override;
+
+    // Same as the calls above with the node given instead of looked up, for
+    // threads pinned to a known node such as a per-node executor's workers.
+    // `node` must be below getTopology().getNodeCount().
+    [[nodiscard]] TimedValue<Product> getTimedOnNode(size_t node, uint64_t productId);
+    void putSharedOnNode(size_t node, uint64_t productId, std::shared_ptr<const Product> product);
+
+    [[nodiscard]] const NumaTopology& getTopology() const noexcept { return mTopology; }
+    // Hits, misses and puts of the whole cache, with every replica's entries and bytes.
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+    [[nodiscard]] CacheMetricsSnapshot getNodeMetrics(size_t node) const;
+    // Hits served by another node's replica and copied into the caller's.
+    [[nodiscard]] uint64_t getRemoteHitCount() const noexcept;
+
+private:
+    // Copies a product found in another replica into `node`'s; nullptr if no replica has it.
+    [[nodiscard]] std::shared_ptr<const Product> lookupRemote(size_t node, uint64_t productId);
+    // Bracket a put or invalidation that touches several replicas.
+    void beginUpdate() noexcept;
+    void endUpdate() noexcept;
+
+    NumaTopology mTopology;
+    std::vector<std::unique_ptr<ProductCache>> mReplicas;
+    // A copy read just before an update dropped it could land just after.
+    // Updates are counted while they run and bump the generation when done,
+    // so a copy that saw either change is dropped again, as in
+    // TieredProductCache's promotions.
+    std::atomic<uint32_t> mUpdatesInFlight{ 0 };
+    std::atomic<uint64_t> mGeneration{ 0 };
+
+    CacheMetrics mMetrics;
+    ShardedCounter mRemoteHits;
+};
+
+#endif // NUMA_PRODUCT_CACHE_H
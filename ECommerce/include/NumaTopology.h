@@ -0,0 +1,48 @@
+#ifndef NUMA_TOPOLOGY_H
+#define NUMA_TOPOLOGY_H
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Which CPUs belong to which NUMA node. Nodes are numbered densely from 0 in
+// the order the OS lists them; nodes without CPUs (memory-only) are left out,
+// since no thread can be local to them. Any failure to read the topology
+// yields a single node, so callers never need a separate non-NUMA path.
+class NumaTopology {
+public:
+    // Reads /sys/devices/system/node on Linux and the OS NUMA API on Windows.
+    [[nodiscard]] static NumaTopology detect();
+    // Reads a sysfs-style node directory: an `online` list and one
+    // node<N>/cpulist per node.
+    [[nodiscard]] static NumaTopology fromSysfs(const std::filesystem::path& nodeDirectory);
+    [[nodiscard]] static NumaTopology singleNode();
+
+    // Parses a kernel CPU list such as "0-3,8,10-11"; throws std::invalid_argument if malformed.
+    [[nodiscard]] static std::vector<uint32_t> parseCpuList(std::string_view list);
+
+    // cpusByNode[node] lists that node's CPUs; an empty list or a node without CPUs is dropped.
+    explicit NumaTopology(std::vector<std::vector<uint32_t>> cpusByNode);
+
+    [[nodiscard]] size_t getNodeCount() const noexcept { return mCpusByNode.size(); }
+    [[nodiscard]] std::span<const uint32_t> getCpus(size_t node) const noexcept { return mCpusByNode[node]; }
+    // Node 0 for CPUs the topology does not know, e.g. ones brought online later.
+    [[nodiscard]] size_t getNodeOfCpu(uint32_t cpu) const noexcept;
+    // Node of the CPU the calling thread is running on right now. The thread
+    // may migrate afterwards, so this is a placement hint unless it is pinned.
+    [[nodiscard]] size_t getCurrentNode() const noexcept;
+
+    [[nodiscard]] static uint32_t getCurrentCpu() noexcept;
+    // Restricts the calling thread to `cpus`, e.g. one node's; returns false if
+    // the OS refused. On Windows only the first CPU's processor group is used.
+    static bool pinCurrentThread(std::span<const uint32_t> cpus) noexcept;
+
+private:
+    std::vector<std::vector<uint32_t>> mCpusByNode;
+    // Indexed by CPU number.
+    std::vector<uint32_t> mNodeOfCpu;
+};
+
+#endif // NUMA_TOPOLOGY_H
@@ -0,0 +1,85 @@
+#ifndef PREHASHED_H
+#define PREHASHED_H
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+// A key together with its hash under Hash, computed once and handed down
+// through every layer a lookup passes: shard selection, the cache's hash map
+// and the database index. Key should be cheap to copy (an integer ID, a
+// string_view or a reference type); a prehashed key is only valid for maps
+// that hash with the same Hash.
+template <typename Key, typename Hash = std::hash<std::remove_cvref_t<Key>>>
+struct Prehashed {
+    Key key;
+    size_t hash;
+
+    explicit Prehashed(const Key& keyToHash, const Hash& hasher = Hash{})
+        : key{ keyToHash }
+        , hash{ hasher(keyToHash) }
+    {
+    }
+};
+
+template <typename T>
+struct IsPrehashed : std::false_type {};
+
+template <typename Key, typename Hash>
+struct IsPrehashed<Prehashed<Key, Hash>> : std::true_type {};
+
+// Hash-map hasher that takes the hash carried by a Prehashed key instead of
+// recomputing it and forwards anything else to Hash. It is transparent, so a
+// map using it with PrehashedEqual can be probed with a Prehashed key, or with
+// any type Hash accepts, without building a Key.
+template <typename Hash>
+struct PrehashedHash : Hash {
+    using is_transparent = void;
+    using Hash::operator();
+
+    template <typename Key>
+    [[nodiscard]] size_t operator()(const Prehashed<Key, Hash>& key) const noexcept {
+        return key.hash;
+    }
+};
+
+// A type a map keyed by Key and hashed with Hash can be probed with directly:
+// Hash is transparent and hashes it, and it compares equal with Key.
+template <typename K, typename Key, typename Hash>
+concept TransparentKeyFor = requires { typename Hash::is_transparent; }
+    && std::is_invocable_r_v<size_t, const Hash&, const K&>
+    && std::equality_comparable_with<const Key&, const K&>;
+
+struct PrehashedEqual {
+    using is_transparent = void;
+
+    template <typename Left, typename Right>
+    [[nodiscard]] bool operator()(const Left& left, const Right& right) const {
+        return unwrap(left) == unwrap(right);
+    }
+
+private:
+    template <typename T>
+    [[nodiscard]] static const auto& unwrap(const T& value) noexcept {
+        if constexpr (IsPrehashed<T>::value) {
+            return value.key;
+        }
+        else {
+            return value;
+        }
+    }
+};
+
+// Transparent string hash, so maps keyed by std::string can be probed with a
+// string_view or a string literal without allocating a std::string.
+struct StringHash {
+    using is_transparent = void;
+
+    [[nodiscard]] size_t operator()(std::string_view value) const noexcept {
+        return std::hash<std::string_view>{}(value);
+    }
+};
+
+#endif // PREHASHED_H
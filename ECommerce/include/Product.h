@@ -1,34 +1,75 @@
 #ifndef PRODUCT_H
 #define PRODUCT_H
 
+#include <array>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <span>
 #include <cstdint>
 
+class ProductArena;
+
+// The name, description and thumbnail are stored back to back in one blob whose
+// layout is described by the field lengths in the object header. Blobs of up to
+// INLINE_CAPACITY bytes live inside the object, so a typical catalog entry needs
+// no heap memory at all; larger ones take a single allocation, or are carved
+// from a ProductArena. Copies always own their blob.
 class Product {
 public:
+    static constexpr size_t INLINE_CAPACITY = 48;
+
+    // Fields are taken as views and copied straight into the blob, so callers can
+    // pass any contiguous buffer without building a std::string or vector first.
+    explicit Product(uint64_t id,
+        uint32_t category,
+        std::string_view name,
+        std::string_view description,
+        std::span<const std::byte> thumbnail);
+
+    // Places a blob that does not fit inline in `arena`, which must outlive this product.
     explicit Product(uint64_t id,
         uint32_t category,
         std::string_view name,
         std::string_view description,
-        const std::vector<std::byte>& thumbnail);
+        std::span<const std::byte> thumbnail,
+        ProductArena& arena);
+
+    Product(const Product& other);
+    Product(Product&& other) noexcept;
+    Product& operator=(const Product& other);
+    Product& operator=(Product&& other) noexcept;
+    ~Product();
 
     [[nodiscard]] uint64_t getId() const noexcept;
     [[nodiscard]] uint32_t getCategory() const noexcept;
     [[nodiscard]] std::string_view getName() const noexcept;
     [[nodiscard]] std::string_view getDescription() const noexcept;
     [[nodiscard]] std::vector<std::byte> getThumbnail() const noexcept;
+    // View of the thumbnail inside the blob; valid while the product is alive and unmodified.
+    [[nodiscard]] std::span<const std::byte> getThumbnailBytes() const noexcept;
+    // Bytes held by this object, including a blob stored outside it.
+    [[nodiscard]] size_t getMemoryFootprint() const noexcept;
 
-    bool operator==(const Product& other) const = default;
+    bool operator==(const Product& other) const noexcept;
 
 private:
+    enum class Storage : uint8_t { INLINE, HEAP, ARENA };
+
+    void assign(std::string_view name, std::string_view description, std::span<const std::byte> thumbnail, ProductArena* arena);
+    void release() noexcept;
+    [[nodiscard]] const std::byte* blob() const noexcept;
+    [[nodiscard]] size_t blobSize() const noexcept;
+
     uint64_t mID;
     uint32_t mCategory;
-    std::string mName;
-    std::string mDescription;
-    std::vector<std::byte> mThumbnail;
+    uint32_t mNameLength = 0;
+    uint32_t mDescriptionLength = 0;
+    uint32_t mThumbnailLength = 0;
+    Storage mStorage = Storage::INLINE;
+    // Heap or arena blob; unused while the fields fit in mInline.
+    std::byte* mExternal = nullptr;
+    std::array<std::byte, INLINE_CAPACITY> mInline;
 };
 
 #endif // PRODUCT_H
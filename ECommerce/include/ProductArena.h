@@ -0,0 +1,34 @@
+#ifndef PRODUCT_ARENA_H
+#define PRODUCT_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator for Product field blobs: products built in an arena share a
+// few large chunks instead of allocating one buffer each. Memory is returned
+// only when the arena is destroyed, so it suits long-lived, append-only
+// catalogs such as FakeDatabase. Not thread-safe.
+class ProductArena {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit ProductArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    ProductArena(const ProductArena&) = delete;
+    ProductArena& operator=(const ProductArena&) = delete;
+
+    [[nodiscard]] std::byte* allocate(size_t size);
+
+    [[nodiscard]] size_t getBytesUsed() const noexcept { return mBytesUsed; }
+    [[nodiscard]] size_t getChunkCount() const noexcept { return mChunks.size(); }
+
+private:
+    size_t mChunkSize;
+    std::vector<std::unique_ptr<std::byte[]>> mChunks;
+    std::byte* mCursor = nullptr;
+    size_t mRemaining = 0;
+    size_t mBytesUsed = 0;
+};
+
+#endif // PRODUCT_ARENA_H
@@ -1,25 +1,89 @@
 #ifndef PRODUCT_CACHE_H
 #define PRODUCT_CACHE_H
 
-#include <unordered_map>
-#include <list>
-#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
 #include <optional>
+#include <span>
+#include <vector>
 #include "ICache.h"
+#include "LruCache.h"
 #include "Product.h"
+#include "Metrics.h"
 #include "Logger.h"
 
+// Byte limit for a ProductCache. Each entry is charged its product's memory
+// footprint plus the list and hash map nodes that hold it.
+struct CacheMemoryBudget {
+    size_t maxBytes;
+    // Products charged more than this are not cached; 0 only rejects products
+    // that could never fit in maxBytes.
+    size_t maxEntryBytes = 0;
+};
+
+// Weighs a cached product by ProductCache::entryCharge.
+struct ProductCharge {
+    [[nodiscard]] size_t operator()(uint64_t productId, const std::shared_ptr<const Product>& product) const noexcept;
+};
+
+// Exact LRU cache of shared product handles; the LruCache instantiation for
+// products, with the ICache interface, time to live, snapshots and logging.
 class ProductCache : public ICache<uint64_t, Product> {
 public:
+    // Receives each product evicted to make room, with the cache lock held, so it
+    // must be quick and must not call back into the cache. Expired and
+    // invalidated products are not reported.
+    using EvictionListener = std::function<void(uint64_t productId, const std::shared_ptr<const Product>& product)>;
+
     explicit ProductCache(size_t capacity);
+    // Evicts least recently used products until the charged bytes fit the budget,
+    // however many entries that leaves.
+    explicit ProductCache(const CacheMemoryBudget& budget);
     [[nodiscard]] std::optional<Product> get(uint64_t productId) override;
     void put(uint64_t productId, const Product& product) override;
+    void put(uint64_t productId, Product&& product) override;
+    [[nodiscard]] std::shared_ptr<const Product> getShared(uint64_t productId) override;
+    void putShared(uint64_t productId, std::shared_ptr<const Product> product) override;
+    // Caches `product` for `ttl` instead of the default time to live; zero never expires.
+    void putShared(uint64_t productId, std::shared_ptr<const Product> product, std::chrono::milliseconds ttl);
+    [[nodiscard]] std::vector<std::shared_ptr<const Product>> getMany(std::span<const uint64_t> productIds) override;
+    bool invalidate(uint64_t productId) override;
+    size_t invalidateMany(std::span<const uint64_t> productIds) override;
+    size_t invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) override;
+    [[nodiscard]] TimedValue<Product> getTimed(uint64_t productId) override;
+    [[nodiscard]] TimedValue<Product> getTimed(const Prehashed<uint64_t>& productId) override;
+
+    // Time to live for products put from now on; zero (the default) keeps them
+    // until evicted. Expired products are dropped lazily, when looked up or when
+    // a put needs room and they are at the tail of the list.
+    void setTimeToLive(std::chrono::milliseconds ttl) noexcept;
+    void setEvictionListener(EvictionListener listener);
+
+    // Writes the live products to a ProductSnapshot file, most recently used
+    // first. The lock is held only while the product handles are collected.
+    // Returns how many products were written.
+    size_t saveSnapshot(const std::filesystem::path& path) const;
+    // Restores a snapshot behind the products already cached, keeping its
+    // recency order, until the cache is full; products already cached are
+    // skipped. Loaded products get the current time to live. The products are
+    // built on `threadCount` threads (0: one per hardware thread) before the
+    // lock is taken once to link them in. Returns how many were loaded.
+    size_t loadSnapshot(const std::filesystem::path& path, size_t threadCount = 0);
+
+    [[nodiscard]] size_t getSize() const;
+    [[nodiscard]] size_t getMemoryUsage() const;
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+
+    // Bytes charged for caching `product`, including per-entry container overhead.
+    [[nodiscard]] static size_t entryCharge(const Product& product) noexcept;
 
 private:
-    size_t mCapacity;
-    std::list<std::pair<uint64_t, Product>> mCacheList;
-    std::unordered_map<uint64_t, std::list<std::pair<uint64_t, Product>>::iterator> mCacheMap;
-    mutable std::shared_mutex mCacheMutex;
+    using Entries = LruCache<uint64_t, std::shared_ptr<const Product>, std::hash<uint64_t>, LruEviction, MutexLocking, ProductCharge>;
+
+    std::atomic<std::chrono::milliseconds> mTimeToLive{ std::chrono::milliseconds::zero() };
+    Entries mEntries;
 };
 
 #endif // PRODUCT_CACHE_H
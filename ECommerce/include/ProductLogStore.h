@@ -0,0 +1,116 @@
+#ifndef PRODUCT_LOG_STORE_H
+#define PRODUCT_LOG_STORE_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "Metrics.h"
+#include "Product.h"
+#include "ScratchFile.h"
+
+struct LogStoreOptions {
+    // Where segment files are created; they are removed when closed.
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    size_t segmentBytes = 64 * 1024 * 1024;
+    // Disk bytes across all segments; past it, the oldest segment is dropped whole.
+    size_t maxBytes = 1024 * 1024 * 1024;
+    // Sealed segments whose live share of bytes falls below this are compacted.
+    double compactionThreshold = 0.5;
+};
+
+// Disk cache tier: products are appended to a log of fixed-size segment files
+// and found through an in-memory index from product ID to record location.
+// Replacing or erasing a product only updates the index; the old record stays
+// on disk as garbage until compact() copies a mostly dead segment's live records
+// to the end of the log and deletes it. When the log outgrows maxBytes the
+// oldest segment is dropped with its products, which makes eviction FIFO by
+// write order. Contents do not survive the process.
+class ProductLogStore {
+public:
+    explicit ProductLogStore(const LogStoreOptions& options);
+
+    // Reads the record from disk; nullptr if the product is not stored.
+    [[nodiscard]] std::shared_ptr<const Product> get(uint64_t productId);
+    [[nodiscard]] bool contains(uint64_t productId) const;
+    // Appends all products in one write, replacing any stored copies. The write
+    // happens outside the index lock; `shouldIndex`, if given, is then called
+    // under it for each product, and a product it rejects stays unindexed. That
+    // lets a caller drop products it erased while the write was in flight; see
+    // TieredProductCache.
+    void append(std::span<const std::shared_ptr<const Product>> products,
+        const std::function<bool(const std::shared_ptr<const Product>&)>& shouldIndex = {});
+    bool erase(uint64_t productId);
+    // Reads every stored product back to test it.
+    size_t eraseIf(const std::function<bool(const uint64_t&, const Product&)>& predicate);
+
+    // Compacts every sealed segment below the compaction threshold and returns
+    // how many were compacted. Runs concurrently with reads and writes; records
+    // replaced or erased while it copies are not resurrected.
+    size_t compact();
+
+    [[nodiscard]] size_t getSize() const;
+    [[nodiscard]] uint64_t getDiskBytes() const;
+    [[nodiscard]] uint64_t getCompactionCount() const noexcept { return mCompactions.load(std::memory_order_relaxed); }
+    // hits and misses count get(), puts appended products and evictions the
+    // products dropped with an old segment; bytes holds the live record bytes.
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+
+private:
+    struct Segment {
+        uint32_t id;
+        ScratchFile file;
+        // Bytes reserved, including writes still in flight.
+        uint64_t size = 0;
+        uint64_t liveBytes = 0;
+        // Reserved ranges not yet indexed; compaction leaves the segment alone until they are.
+        uint32_t pendingWrites = 0;
+        // Every product appended here, live or not; compaction and drops walk it.
+        std::vector<uint64_t> productIds;
+
+        Segment(uint32_t segmentId, const std::filesystem::path& path) : id{ segmentId }, file{ path } {}
+    };
+
+    struct Location {
+        uint32_t segmentId;
+        uint32_t size;
+        uint64_t offset;
+    };
+
+    // Product ID and offset of each record in an encoded batch.
+    using RecordList = std::vector<std::pair<uint64_t, Location>>;
+
+    // Reserves room for `bytes` at the end of the log under the lock and writes
+    // them outside it; the caller indexes the records under the lock and then
+    // decrements the returned segment's pendingWrites.
+    [[nodiscard]] std::shared_ptr<Segment> write(std::span<const std::byte> bytes, uint64_t& offset);
+    // Caller holds mMutex exclusively.
+    void openSegment();
+    void index(uint64_t productId, const Location& location, Segment& segment);
+    void unindex(std::unordered_map<uint64_t, Location>::iterator it);
+    void dropOldestSegments();
+    [[nodiscard]] std::shared_ptr<const Product> read(const Segment& segment, const Location& location) const;
+
+    LogStoreOptions mOptions;
+    std::unordered_map<uint64_t, Location> mIndex;
+    // Oldest first; the last one is the segment being appended to. Readers
+    // copy the shared_ptr so a segment dropped mid-read stays open.
+    std::map<uint32_t, std::shared_ptr<Segment>> mSegments;
+    uint32_t mNextSegmentId = 0;
+    uint64_t mDiskBytes = 0;
+    uint64_t mLiveBytes = 0;
+    CacheMetrics mMetrics;
+    std::atomic<uint64_t> mCompactions{ 0 };
+    // Distinguishes this store's segment files from others in the same directory.
+    uint64_t mFileTag;
+    // Guards the index and segment list; disk reads and writes happen outside it.
+    mutable std::shared_mutex mMutex;
+};
+
+#endif // PRODUCT_LOG_STORE_H
@@ -1,25 +1,134 @@
 #ifndef PRODUCT_SERVICE_H
 #define PRODUCT_SERVICE_H
 
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
-#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "CategoryCountCache.h"
 #include "ICache.h"
 #include "IDatabase.h"
 #include "Product.h"
+#include "Metrics.h"
+#include "TaskExecutor.h"
 
 class ProductService {
 public:
+    static constexpr size_t CATEGORY_COUNT_CAPACITY = 1024;
+    static constexpr std::chrono::milliseconds DEFAULT_CATEGORY_COUNT_TTL{ 60'000 };
+    static constexpr size_t DEFAULT_WARM_UP_BATCH_SIZE = 1000;
+
+    // Every database call runs on an executor built from `executorOptions`; its
+    // worker count bounds the concurrent database requests.
     ProductService(std::shared_ptr<ICache<uint64_t, Product>> cache,
-        std::shared_ptr<IDatabase> database);
+        std::shared_ptr<IDatabase> database,
+        const ExecutorOptions& executorOptions = {});
+    // Subscribes to the database's change feed until destroyed.
+    ~ProductService();
 
     std::optional<Product> getProductDetails(uint64_t productId) const;
+    // Zero-copy variant: a cache hit only bumps the product's reference count.
+    // A miss blocks until the executor has fetched the product.
+    std::shared_ptr<const Product> getProductDetailsShared(uint64_t productId) const;
+
+    // Non-blocking variant: a cache hit returns a ready future, a miss one that the
+    // executor completes. If the executor is full and rejects the fetch
+    // (ExecutorOverflowPolicy::REJECT), the future holds a std::runtime_error.
+    [[nodiscard]] std::shared_future<std::shared_ptr<const Product>> getProductDetailsAsync(uint64_t productId) const;
+
+    // One handle per ID, in the same order; nullptr for products that do not exist.
+    // Hits are resolved in one cache batch. Misses join fetches already in flight
+    // for the same IDs, and the rest go to the database in one batch. If the
+    // executor rejects that batch, the hits are still returned and its misses
+    // are nullptr, counted as rejected fetches.
+    std::vector<std::shared_ptr<const Product>> getMany(std::span<const uint64_t> productIds) const;
+
+    // Prefetches a hot-ID list into the cache before traffic is admitted. The IDs
+    // are fetched in database batches of `batchSize`, spread over the executor's
+    // workers, and replace any cached copy; IDs the database does not know are
+    // skipped. Blocks until every batch is done and returns how many products
+    // were cached. Batches the executor rejects are skipped.
+    size_t warmUp(std::span<const uint64_t> productIds, size_t batchSize = DEFAULT_WARM_UP_BATCH_SIZE);
+
+    // Number of products in the category, served from a cache of counts that
+    // change notifications invalidate. Concurrent misses for the same category
+    // share one database query, which runs on the executor.
+    size_t getProductCountByCategory(uint32_t categoryId) const;
+    // Fallback expiry of cached counts, for changes the database does not notify.
+    void setCategoryCountTimeToLive(std::chrono::milliseconds ttl) noexcept;
+    [[nodiscard]] CacheMetricsSnapshot getCategoryCountMetrics() const;
+
+    // Number of cache misses that waited on another caller's database fetch
+    // for the same product instead of issuing their own.
+    [[nodiscard]] uint64_t getCoalescedFetchCount() const noexcept;
+
+    // Stale-while-revalidate: a cached product older than `softTtl` is still
+    // returned at once, and the executor refetches it from the database, one
+    // refresh per product at a time. Zero (the default) turns this off.
+    void setStaleWhileRevalidate(std::chrono::milliseconds softTtl) noexcept;
+
+    [[nodiscard]] ServiceMetricsSnapshot getMetrics() const;
 
 private:
+    using PendingFetch = std::shared_future<std::shared_ptr<const Product>>;
+    using PendingCount = std::shared_future<size_t>;
+
+    // Cache lookup shared by the blocking and async paths; schedules a refresh for stale hits.
+    // The ID is hashed once per request and the hash reused by the cache, the
+    // in-flight table and the database.
+    std::shared_ptr<const Product> lookupCached(const Prehashed<uint64_t>& productId) const;
+    // Joins the in-flight fetch for `productId`, or submits one to the executor.
+    PendingFetch fetchMiss(const Prehashed<uint64_t>& productId) const;
+    void completeFetch(const Prehashed<uint64_t>& productId, std::promise<std::shared_ptr<const Product>>& fetchPromise) const;
+    // Fetches `productIds` in one database batch, caches them and completes one promise per ID.
+    void completeBatch(std::span<const uint64_t> productIds,
+        std::span<std::promise<std::shared_ptr<const Product>>> fetchPromises, uint64_t epoch) const;
+    void completeCount(uint32_t categoryId, std::promise<size_t>& countPromise, uint64_t epoch) const;
+    std::shared_ptr<const Product> fetchAndCache(const Prehashed<uint64_t>& productId) const;
+    // Caches `product` unless a change notification arrived since `epoch` was read
+    // before fetching it, so a fetch racing an update cannot cache the old copy.
+    // The copy is put first and dropped again if a notification ran meanwhile,
+    // so fills never wait for invalidation batches. Returns whether it was kept.
+    bool putIfCurrent(uint64_t productId, std::shared_ptr<const Product> product, uint64_t epoch) const;
+    // No change notification is running or has finished since `epoch` was read.
+    [[nodiscard]] bool isCurrent(uint64_t epoch) const noexcept;
+    void onDatabaseChanges(std::span<const ProductChange> changes);
+    void scheduleRefresh(uint64_t productId) const;
+    void refresh(uint64_t productId) const;
+
     std::shared_ptr<ICache<uint64_t, Product>> mCache;
     std::shared_ptr<IDatabase> mDatabase;
 
-    mutable std::shared_mutex mCacheMutex;
+    // Single-flight: at most one database fetch per product ID is in progress.
+    mutable std::mutex mInFlightMutex;
+    mutable std::unordered_map<uint64_t, PendingFetch, PrehashedHash<std::hash<uint64_t>>, PrehashedEqual> mInFlight;
+    mutable std::unordered_map<uint32_t, PendingCount> mCountsInFlight;
+    mutable std::atomic<uint64_t> mCoalescedFetches{ 0 };
+
+    mutable ServiceMetrics mMetrics;
+
+    // Filled under the same epoch rule as the product cache; see putIfCurrent().
+    mutable CategoryCountCache mCategoryCounts{ CATEGORY_COUNT_CAPACITY, DEFAULT_CATEGORY_COUNT_TTL };
+
+    // Notifications are counted while they run and bump the epoch when done,
+    // like NumaProductCache's updates; see putIfCurrent().
+    std::atomic<uint32_t> mInvalidationsInFlight{ 0 };
+    std::atomic<uint64_t> mInvalidationEpoch{ 0 };
+    uint64_t mSubscriptionId = 0;
+
+    std::atomic<std::chrono::milliseconds> mSoftTtl{ std::chrono::milliseconds::zero() };
+    mutable std::mutex mRefreshMutex;
+    // IDs queued or being refreshed, so a hot stale product is fetched only once.
+    mutable std::unordered_set<uint64_t> mRefreshPending;
+
+    // Declared last so queued fetches finish before the members they use are destroyed.
+    std::unique_ptr<TaskExecutor> mExecutor;
 };
 
 #endif // PRODUCT_SERVICE_H
@@ -0,0 +1,57 @@
+#ifndef PRODUCT_SNAPSHOT_H
+#define PRODUCT_SNAPSHOT_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+#include "Product.h"
+
+// Compact binary image of cached products, used to restart a cache warm. The
+// file is a Header followed by one packed record per product, in the order
+// given to write(): a RecordHeader and the name, description and thumbnail
+// bytes. Integers are stored in native byte order.
+class ProductSnapshot {
+public:
+    static constexpr std::array<char, 8> MAGIC{ 'X', 'M', 'L', 'R', 'U', 'S', 'N', 'P' };
+    static constexpr uint32_t VERSION = 1;
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t productCount;
+        uint64_t fileSize;
+    };
+
+    struct RecordHeader {
+        uint64_t id;
+        uint32_t category;
+        uint32_t nameLength;
+        uint32_t descriptionLength;
+        uint32_t thumbnailLength;
+    };
+
+    // Record encoding, shared with ProductLogStore.
+    [[nodiscard]] static size_t recordSize(const Product& product) noexcept;
+    static void encodeRecord(const Product& product, std::vector<std::byte>& buffer);
+    // `record` must hold exactly one whole record.
+    [[nodiscard]] static Product decodeRecord(std::span<const std::byte> record);
+
+    // Written to a temporary file first, so a crash mid-write keeps the previous snapshot.
+    static void write(const std::filesystem::path& path, std::span<const std::shared_ptr<const Product>> products);
+
+    // The first `maxProducts` products of the file, in file order. The file is
+    // mapped and scanned once for record boundaries, then the products are
+    // built on up to `threadCount` threads (0: one per hardware thread).
+    [[nodiscard]] static std::vector<std::shared_ptr<const Product>> read(const std::filesystem::path& path,
+        size_t maxProducts,
+        size_t threadCount = 0);
+};
+
+static_assert(sizeof(ProductSnapshot::Header) == 32);
+static_assert(sizeof(ProductSnapshot::RecordHeader) == 24);
+
+#endif // PRODUCT_SNAPSHOT_H
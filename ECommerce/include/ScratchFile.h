@@ -0,0 +1,32 @@
+#ifndef SCRATCH_FILE_H
+#define SCRATCH_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+// A file that exists only while it is open: it is created empty and removed
+// when closed, even if the process dies first. Reads and writes take an
+// explicit offset, so concurrent reads need no lock and never move a cursor.
+class ScratchFile {
+public:
+    explicit ScratchFile(const std::filesystem::path& path);
+    ~ScratchFile();
+
+    ScratchFile(const ScratchFile&) = delete;
+    ScratchFile& operator=(const ScratchFile&) = delete;
+
+    void write(uint64_t offset, std::span<const std::byte> bytes);
+    // Fills `bytes` from `offset`; the range must have been written.
+    void read(uint64_t offset, std::span<std::byte> bytes) const;
+
+private:
+#ifdef _WIN32
+    void* mFile = nullptr;
+#else
+    int mFile = -1;
+#endif
+};
+
+#endif // SCRATCH_FILE_H
@@ -0,0 +1,68 @@
+#ifndef SHARDED_PRODUCT_CACHE_H
+#define SHARDED_PRODUCT_CACHE_H
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include "ICache.h"
+#include "Product.h"
+#include "Metrics.h"
+
+enum class EvictionMode {
+    LRU,      // exact recency order, every hit takes the shard lock exclusively
+    CLOCK,    // approximate recency, hits only set a reference bit under a shared lock
+    TINY_LFU  // W-TinyLFU, admits new entries by frequency so scans do not flush the hot set
+};
+
+// Splits the key space across independently locked LRU shards so that lookups
+// for different products do not contend on a single mutex.
+class ShardedProductCache : public ICache<uint64_t, Product> {
+public:
+    // capacity is the total budget, split as evenly as possible: the first
+    // capacity % shards shards hold one entry more than the others.
+    // shardCount is rounded down to a power of two and never exceeds capacity.
+    explicit ShardedProductCache(size_t capacity,
+        size_t shardCount = defaultShardCount(),
+        EvictionMode evictionMode = EvictionMode::LRU);
+
+    [[nodiscard]] std::optional<Product> get(uint64_t productId) override;
+    void put(uint64_t productId, const Product& product) override;
+    void put(uint64_t productId, Product&& product) override;
+    [[nodiscard]] std::shared_ptr<const Product> getShared(uint64_t productId) override;
+    void putShared(uint64_t productId, std::shared_ptr<const Product> product) override;
+    [[nodiscard]] TimedValue<Product> getTimed(uint64_t productId) override;
+    // The carried hash picks the shard and probes the shard's map, so the ID is not hashed again.
+    [[nodiscard]] TimedValue<Product> getTimed(const Prehashed<uint64_t>& productId) override;
+    [[nodiscard]] std::vector<std::shared_ptr<const Product>> getMany(std::span<const uint64_t> productIds) override;
+    bool invalidate(uint64_t productId) override;
+    size_t invalidateMany(std::span<const uint64_t> productIds) override;
+    size_t invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) override;
+
+    [[nodiscard]] size_t getShardCount() const noexcept;
+    [[nodiscard]] size_t getCapacity() const noexcept;
+    // Capacity of the largest shard.
+    [[nodiscard]] size_t getShardCapacity() const noexcept;
+    [[nodiscard]] EvictionMode getEvictionMode() const noexcept;
+    // Sum of every shard's counters and latency histogram.
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+
+    [[nodiscard]] static size_t defaultShardCount() noexcept;
+
+private:
+    using Shard = ICache<uint64_t, Product>;
+
+    // Shards are picked from std::hash<uint64_t> of the ID, the hash a
+    // Prehashed<uint64_t> carries, so both kinds of lookup agree.
+    [[nodiscard]] size_t shardIndex(uint64_t productId) const noexcept;
+    [[nodiscard]] size_t shardIndexOfHash(size_t hash) const noexcept;
+    [[nodiscard]] Shard& shardFor(uint64_t productId) noexcept;
+
+    size_t mCapacity;
+    size_t mShardCapacity;
+    size_t mShardMask;
+    EvictionMode mEvictionMode;
+    std::vector<std::unique_ptr<Shard>> mShards;
+};
+
+#endif // SHARDED_PRODUCT_CACHE_H
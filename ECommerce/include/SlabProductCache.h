@@ -0,0 +1,63 @@
+#ifndef SLAB_PRODUCT_CACHE_H
+#define SLAB_PRODUCT_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+#include "ICache.h"
+#include "FlatProductIndex.h"
+#include "Product.h"
+#include "Metrics.h"
+
+// Exact LRU with the same behaviour as ProductCache, but every entry lives in a
+// slab allocated once at construction and the recency list is threaded through
+// it with 32-bit indexes. Together with FlatProductIndex this makes a lookup one
+// control group, one index slot and one slab node, and puts with a shared handle
+// allocate nothing once the cache is full: an eviction reuses the victim's node.
+class SlabProductCache : public ICache<uint64_t, Product> {
+public:
+    explicit SlabProductCache(size_t capacity);
+    [[nodiscard]] std::optional<Product> get(uint64_t productId) override;
+    void put(uint64_t productId, const Product& product) override;
+    void put(uint64_t productId, Product&& product) override;
+    [[nodiscard]] std::shared_ptr<const Product> getShared(uint64_t productId) override;
+    void putShared(uint64_t productId, std::shared_ptr<const Product> product) override;
+    [[nodiscard]] std::vector<std::shared_ptr<const Product>> getMany(std::span<const uint64_t> productIds) override;
+    bool invalidate(uint64_t productId) override;
+    size_t invalidateMany(std::span<const uint64_t> productIds) override;
+    size_t invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) override;
+
+    [[nodiscard]] size_t getSize() const;
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+
+private:
+    static constexpr uint32_t NIL = FlatProductIndex::NOT_FOUND;
+
+    struct Node {
+        uint64_t productId = 0;
+        std::shared_ptr<const Product> product;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+    };
+
+    [[nodiscard]] std::shared_ptr<const Product> lookup(uint64_t productId) noexcept;
+    void unlink(uint32_t node) noexcept;
+    void pushFront(uint32_t node) noexcept;
+    // Frees `node` and moves the last used node into it, keeping [0, mSize) dense.
+    void release(uint32_t node);
+
+    size_t mCapacity;
+    std::vector<Node> mNodes;
+    // Nodes [0, mSize) are in use; the slab is filled in order and never shrinks.
+    uint32_t mSize = 0;
+    uint32_t mHead = NIL;
+    uint32_t mTail = NIL;
+    FlatProductIndex mIndex;
+    CacheMetrics mMetrics;
+    // Hits relink the node at the head, so reads need exclusive access as well.
+    mutable std::mutex mCacheMutex;
+};
+
+#endif // SLAB_PRODUCT_CACHE_H
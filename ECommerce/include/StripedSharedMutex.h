@@ -0,0 +1,60 @@
+#ifndef STRIPED_SHARED_MUTEX_H
+#define STRIPED_SHARED_MUTEX_H
+
+#include <array>
+#include <cstddef>
+#include <shared_mutex>
+#include "Metrics.h"
+
+// Reader-writer lock for read-mostly data. A reader locks only its thread's
+// stripe, so readers on different stripes write to different cache lines
+// instead of all bouncing one lock word between cores. A writer locks every
+// stripe, in order, which makes writes cost STRIPES lock operations.
+// Satisfies SharedMutex, so std::shared_lock and std::unique_lock work with it.
+class StripedSharedMutex {
+public:
+    static constexpr size_t STRIPES = 16;
+
+    void lock() {
+        for (auto& stripe : mStripes) {
+            stripe.mutex.lock();
+        }
+    }
+
+    [[nodiscard]] bool try_lock() {
+        for (size_t locked = 0; locked < STRIPES; ++locked) {
+            if (!mStripes[locked].mutex.try_lock()) {
+                while (locked > 0) {
+                    mStripes[--locked].mutex.unlock();
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void unlock() {
+        for (auto& stripe : mStripes) {
+            stripe.mutex.unlock();
+        }
+    }
+
+    // A thread's stripe never changes, so unlock_shared() releases the stripe
+    // lock_shared() took.
+    void lock_shared() { readerStripe().lock_shared(); }
+    [[nodiscard]] bool try_lock_shared() { return readerStripe().try_lock_shared(); }
+    void unlock_shared() { readerStripe().unlock_shared(); }
+
+private:
+    struct alignas(64) Stripe {
+        std::shared_mutex mutex;
+    };
+
+    [[nodiscard]] std::shared_mutex& readerStripe() noexcept {
+        return mStripes[Metrics::threadStripe() % STRIPES].mutex;
+    }
+
+    std::array<Stripe, STRIPES> mStripes;
+};
+
+#endif // STRIPED_SHARED_MUTEX_H
@@ -0,0 +1,73 @@
+#ifndef TASK_EXECUTOR_H
+#define TASK_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class ExecutorOverflowPolicy {
+    REJECT, // submit() returns false at once
+    BLOCK   // submit() waits until a worker takes a task
+};
+
+struct ExecutorOptions {
+    size_t workerCount = 4;
+    // Tasks queued but not yet started; beyond this the overflow policy applies.
+    size_t maxQueuedTasks = 1024;
+    ExecutorOverflowPolicy overflowPolicy = ExecutorOverflowPolicy::BLOCK;
+};
+
+// Fixed pool of worker threads with one task deque each. Workers take their own
+// tasks oldest first and, when idle, steal the newest task of another worker,
+// so a burst submitted to one queue spreads over the whole pool. Tasks submitted
+// from a worker stay on that worker's queue.
+// Destruction runs every queued task before joining the workers.
+class TaskExecutor {
+public:
+    using Task = std::function<void()>;
+
+    explicit TaskExecutor(const ExecutorOptions& options = {});
+
+    // Queues `task`, applying the overflow policy when the executor is full;
+    // returns false only if the task was rejected.
+    [[nodiscard]] bool submit(Task task);
+    // Never blocks: returns false if the executor is full, whatever the policy.
+    [[nodiscard]] bool trySubmit(Task task);
+
+    [[nodiscard]] size_t getWorkerCount() const noexcept;
+    [[nodiscard]] size_t getQueuedCount() const noexcept;
+    [[nodiscard]] uint64_t getRejectedCount() const noexcept;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    [[nodiscard]] bool tryReserve() noexcept;
+    void enqueue(Task task);
+    [[nodiscard]] bool tryPop(size_t worker, Task& task);
+    void run(size_t worker, std::stop_token stopToken);
+
+    size_t mMaxQueuedTasks;
+    ExecutorOverflowPolicy mOverflowPolicy;
+    std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+    std::atomic<size_t> mQueued{ 0 };
+    std::atomic<size_t> mNextQueue{ 0 };
+    std::atomic<uint64_t> mRejected{ 0 };
+
+    // Only guards sleeping and waking; the task deques have their own locks.
+    std::mutex mWaitMutex;
+    std::condition_variable_any mTaskReady;
+    std::condition_variable mSpaceReady;
+
+    // Declared last so the workers are joined before the queues are destroyed.
+    std::vector<std::jthread> mWorkers;
+};
+
+#endif // TASK_EXECUTOR_H
@@ -0,0 +1,101 @@
+#ifndef TIERED_PRODUCT_CACHE_H
+#define TIERED_PRODUCT_CACHE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "ICache.h"
+#include "Metrics.h"
+#include "Product.h"
+#include "ProductCache.h"
+#include "ProductLogStore.h"
+
+// Two-tier cache: a ProductCache in memory in front of a ProductLogStore on
+// local disk. Products the memory tier evicts are queued and demoted by a
+// background thread, which appends them to the log in batches and compacts it.
+// A memory miss checks the demotion queue, then the disk, and promotes what it
+// finds back into memory; only a miss in both reaches the caller's database.
+// The disk tier keeps its copy on promotion, so a product evicted again is not
+// rewritten. Puts and invalidations remove every lower-tier copy.
+class TieredProductCache : public ICache<uint64_t, Product> {
+public:
+    static constexpr size_t DEMOTION_BATCH_SIZE = 256;
+    static constexpr size_t DEFAULT_MAX_PENDING_DEMOTIONS = 64 * 1024;
+
+    // Evicted products waiting for the disk hold memory outside the memory
+    // tier's budget; past `maxPendingDemotions` further evictions are dropped.
+    TieredProductCache(std::unique_ptr<ProductCache> memoryTier,
+        const LogStoreOptions& diskTier,
+        size_t maxPendingDemotions = DEFAULT_MAX_PENDING_DEMOTIONS);
+
+    [[nodiscard]] std::optional<Product> get(uint64_t productId) override;
+    void put(uint64_t productId, const Product& product) override;
+    void put(uint64_t productId, Product&& product) override;
+    [[nodiscard]] std::shared_ptr<const Product> getShared(uint64_t productId) override;
+    void putShared(uint64_t productId, std::shared_ptr<const Product> product) override;
+    // Products found below the memory tier report the time they were promoted.
+    [[nodiscard]] TimedValue<Product> getTimed(uint64_t productId) override;
+    [[nodiscard]] TimedValue<Product> getTimed(const Prehashed<uint64_t>& productId) override;
+    [[nodiscard]] std::vector<std::shared_ptr<const Product>> getMany(std::span<const uint64_t> productIds) override;
+    bool invalidate(uint64_t productId) override;
+    size_t invalidateMany(std::span<const uint64_t> productIds) override;
+    // Reads every product on disk back to test it.
+    size_t invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) override;
+
+    // Blocks until every product evicted so far has been written to disk.
+    void flush();
+
+    // Hits and misses of the whole cache, with the memory tier's entries and bytes.
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+    [[nodiscard]] CacheMetricsSnapshot getMemoryTierMetrics() const;
+    [[nodiscard]] CacheMetricsSnapshot getDiskTierMetrics() const;
+    [[nodiscard]] uint64_t getDemotionCount() const noexcept;
+    [[nodiscard]] uint64_t getDroppedDemotionCount() const noexcept;
+    [[nodiscard]] uint64_t getCompactionCount() const noexcept;
+
+private:
+    // Called by the memory tier with its lock held.
+    void onEviction(uint64_t productId, const std::shared_ptr<const Product>& product);
+    void runDemotions(std::stop_token stopToken);
+    [[nodiscard]] std::shared_ptr<const Product> lookupLowerTiers(uint64_t productId);
+    // Removes lower-tier copies of the products and bumps mGeneration. Called
+    // before the memory tier is updated, so a promotion that read an old copy
+    // either lands before the update and is overwritten, or lands after the
+    // bump and undoes itself. Adds the IDs it removed to `removedIds`, if given.
+    void dropLowerCopies(std::span<const uint64_t> productIds, std::unordered_set<uint64_t>* removedIds = nullptr);
+
+    std::unique_ptr<ProductCache> mMemoryTier;
+    ProductLogStore mDiskTier;
+    size_t mMaxPendingDemotions;
+
+    // Taken by the memory tier's eviction callback, so it is never held while
+    // calling into the memory tier.
+    std::mutex mDemotionMutex;
+    std::condition_variable_any mDemotionReady;
+    std::condition_variable_any mDemotionsDone;
+    std::deque<uint64_t> mDemotionQueue;
+    // Latest evicted copy of each queued product; lookups are served from here
+    // until the product is on disk.
+    std::unordered_map<uint64_t, std::shared_ptr<const Product>> mPending;
+    bool mWritingBatch = false;
+
+    // Bumped whenever a lower-tier copy is removed; a promotion that raced it is undone.
+    std::atomic<uint64_t> mGeneration{ 0 };
+
+    CacheMetrics mMetrics;
+    ShardedCounter mDemotions;
+    ShardedCounter mDroppedDemotions;
+
+    // Declared last so the demotion thread stops before the tiers are destroyed.
+    std::jthread mDemotionThread;
+};
+
+#endif // TIERED_PRODUCT_CACHE_H
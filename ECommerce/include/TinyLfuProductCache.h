@@ -0,0 +1,66 @@
+#ifndef TINY_LFU_PRODUCT_CACHE_H
+#define TINY_LFU_PRODUCT_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "ICache.h"
+#include "FrequencySketch.h"
+#include "Product.h"
+#include "Metrics.h"
+
+// W-TinyLFU: new products enter a small LRU window (1% of capacity). When the
+// window overflows, its oldest entry competes with the main area's eviction
+// victim and is only admitted if the frequency sketch has seen it more often,
+// so one-off scans cannot flush the hot set. The main area is a segmented LRU:
+// entries hit again in probation are promoted to the protected segment (80%).
+class TinyLfuProductCache : public ICache<uint64_t, Product> {
+public:
+    explicit TinyLfuProductCache(size_t capacity);
+    [[nodiscard]] std::optional<Product> get(uint64_t productId) override;
+    void put(uint64_t productId, const Product& product) override;
+    void put(uint64_t productId, Product&& product) override;
+    [[nodiscard]] std::shared_ptr<const Product> getShared(uint64_t productId) override;
+    void putShared(uint64_t productId, std::shared_ptr<const Product> product) override;
+    [[nodiscard]] std::vector<std::shared_ptr<const Product>> getMany(std::span<const uint64_t> productIds) override;
+    bool invalidate(uint64_t productId) override;
+    size_t invalidateMany(std::span<const uint64_t> productIds) override;
+    size_t invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) override;
+
+    [[nodiscard]] CacheMetricsSnapshot getMetrics() const;
+
+private:
+    enum class Segment { WINDOW, PROBATION, PROTECTED };
+
+    struct Entry {
+        uint64_t productId;
+        std::shared_ptr<const Product> product;
+        Segment segment;
+    };
+    using EntryList = std::list<Entry>;
+
+    [[nodiscard]] std::shared_ptr<const Product> lookup(uint64_t productId);
+    [[nodiscard]] EntryList& listFor(Segment segment) noexcept;
+    void onHit(EntryList::iterator entry);
+    void evictFromWindow();
+    void evict(EntryList& list, EntryList::iterator entry);
+
+    size_t mCapacity;
+    size_t mWindowCapacity;
+    size_t mMainCapacity;
+    size_t mProtectedCapacity;
+    EntryList mWindow;
+    EntryList mProbation;
+    EntryList mProtected;
+    std::unordered_map<uint64_t, EntryList::iterator> mIndex;
+    FrequencySketch mSketch;
+    CacheMetrics mMetrics;
+    // Hits reorder the segment lists and update the sketch, so reads lock exclusively.
+    mutable std::mutex mCacheMutex;
+};
+
+#endif // TINY_LFU_PRODUCT_CACHE_H
@@ -0,0 +1,63 @@
+#include "CategoryCountCache.h"
+#include "Logger.h"
+#include <stdexcept>
+#include <string>
+
+namespace {
+    size_t validatedCapacity(size_t capacity) {
+        if (capacity == 0) {
+            LOG_ERROR(LogCategory::CACHE, "CategoryCountCache initialized with zero capacity.");
+            throw std::invalid_argument("Cache capacity must be greater than zero.");
+        }
+        return capacity;
+    }
+}
+
+CategoryCountCache::CategoryCountCache(size_t capacity, std::chrono::milliseconds ttl)
+    : mTimeToLive{ ttl }
+    , mCounts{ validatedCapacity(capacity) }
+{
+    mCounts.setEvictionListener([](const uint32_t& categoryId, const size_t&) {
+        LOG_WARNING(LogCategory::CACHE, "Evicting count of category ID: {}", categoryId);
+        });
+    LOG_INFO(LogCategory::CACHE, "CategoryCountCache initialized with capacity: {} and time to live: {} ms",
+        capacity, ttl.count());
+}
+
+[[nodiscard]] std::optional<size_t> CategoryCountCache::get(uint32_t categoryId) {
+    return mCounts.get(categoryId);
+}
+
+void CategoryCountCache::put(uint32_t categoryId, const size_t& count) {
+    LOG_INFO(LogCategory::CACHE, "Putting count {} for category ID: {}", count, categoryId);
+    mCounts.put(categoryId, count, mTimeToLive.load(std::memory_order_relaxed));
+}
+
+bool CategoryCountCache::invalidate(uint32_t categoryId) {
+    return invalidateMany(std::span<const uint32_t>(&categoryId, 1)) != 0;
+}
+
+size_t CategoryCountCache::invalidateMany(std::span<const uint32_t> categoryIds) {
+    const size_t removed = mCounts.invalidateMany(categoryIds);
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} of {} category counts.", removed, categoryIds.size());
+    return removed;
+}
+
+size_t CategoryCountCache::invalidateIf(const std::function<bool(const uint32_t&, const size_t&)>& predicate) {
+    return mCounts.invalidateIf(predicate);
+}
+
+void CategoryCountCache::setTimeToLive(std::chrono::milliseconds ttl) noexcept {
+    mTimeToLive.store(ttl, std::memory_order_relaxed);
+}
+
+[[nodiscard]] size_t CategoryCountCache::getSize() const {
+    return mCounts.getSize();
+}
+
+[[nodiscard]] CacheMetricsSnapshot CategoryCountCache::getMetrics() const {
+    auto snapshot = mCounts.getMetrics();
+    // Counts are not weighed by memory.
+    snapshot.bytes = 0;
+    return snapshot;
+}
@@ -0,0 +1,187 @@
+#include "ClockProductCache.h"
+#include "Logger.h"
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+ClockProductCache::ClockProductCache(size_t capacity)
+    : mCapacity{ capacity }
+    , mSlots(capacity)
+{
+    if (mCapacity == 0) {
+        LOG_ERROR(LogCategory::CACHE, "ClockProductCache initialized with zero capacity.");
+        throw std::invalid_argument("Cache capacity must be greater than zero.");
+    }
+    mIndex.reserve(mCapacity);
+    mFreeSlots.reserve(mCapacity);
+    for (size_t slot = mCapacity; slot > 0; --slot) {
+        mFreeSlots.push_back(slot - 1);
+    }
+    LOG_INFO(LogCategory::CACHE, "ClockProductCache initialized with capacity: {}", mCapacity);
+}
+
+[[nodiscard]] std::optional<Product> ClockProductCache::get(uint64_t productId) {
+    if (auto product = getShared(productId)) {
+        return *product;
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] std::shared_ptr<const Product> ClockProductCache::getShared(uint64_t productId) {
+    ScopedLatency latency(mMetrics.getLatency);
+    std::shared_lock lock(mCacheMutex);
+
+    LOG_INFO(LogCategory::CACHE, "Getting Product ID: {}", productId);
+
+    if (auto it = mIndex.find(productId); it != mIndex.end()) {
+        auto& slot = mSlots[it->second];
+        // Test before setting: a hot entry's bit is almost always set already,
+        // and skipping the store keeps its cache line shared between readers.
+        if (!slot.referenced.load(std::memory_order_relaxed)) {
+            slot.referenced.store(true, std::memory_order_relaxed);
+        }
+        mMetrics.hits.increment();
+        LOG_INFO(LogCategory::CACHE, "Product ID: {} found.", productId);
+        return slot.product;
+    }
+
+    mMetrics.misses.increment();
+    LOG_INFO(LogCategory::CACHE, "Product ID: {} not found.", productId);
+    return nullptr;
+}
+
+[[nodiscard]] std::vector<std::shared_ptr<const Product>> ClockProductCache::getMany(std::span<const uint64_t> productIds) {
+    std::vector<std::shared_ptr<const Product>> products;
+    products.reserve(productIds.size());
+    size_t hits = 0;
+
+    std::shared_lock lock(mCacheMutex);
+
+    for (uint64_t productId : productIds) {
+        if (auto it = mIndex.find(productId); it != mIndex.end()) {
+            auto& slot = mSlots[it->second];
+            if (!slot.referenced.load(std::memory_order_relaxed)) {
+                slot.referenced.store(true, std::memory_order_relaxed);
+            }
+            products.push_back(slot.product);
+            ++hits;
+        }
+        else {
+            products.push_back(nullptr);
+        }
+    }
+
+    mMetrics.hits.increment(hits);
+    mMetrics.misses.increment(productIds.size() - hits);
+    LOG_INFO(LogCategory::CACHE, "Batch get of {} products: {} found.", productIds.size(), hits);
+    return products;
+}
+
+void ClockProductCache::put(uint64_t productId, const Product& product) {
+    putShared(productId, std::make_shared<const Product>(product));
+}
+
+void ClockProductCache::put(uint64_t productId, Product&& product) {
+    putShared(productId, std::make_shared<const Product>(std::move(product)));
+}
+
+void ClockProductCache::putShared(uint64_t productId, std::shared_ptr<const Product> product) {
+    std::unique_lock lock(mCacheMutex);
+
+    LOG_INFO(LogCategory::CACHE, "Putting Product ID: {}", productId);
+    mMetrics.puts.increment();
+
+    if (auto it = mIndex.find(productId); it != mIndex.end()) {
+        auto& slot = mSlots[it->second];
+        slot.product = std::move(product);
+        slot.referenced.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t slotIndex = 0;
+    if (!mFreeSlots.empty()) {
+        slotIndex = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    }
+    else {
+        slotIndex = findVictim();
+    }
+    auto& slot = mSlots[slotIndex];
+
+    if (slot.product) {
+        mMetrics.evictions.increment();
+        LOG_WARNING(LogCategory::CACHE, "Evicting Product ID: {}", slot.productId);
+        mIndex.erase(slot.productId);
+    }
+
+    slot.productId = productId;
+    slot.product = std::move(product);
+    // New entries start unreferenced so a one-off insert is the first to go.
+    slot.referenced.store(false, std::memory_order_relaxed);
+    mIndex.emplace(productId, slotIndex);
+}
+
+bool ClockProductCache::invalidate(uint64_t productId) {
+    return invalidateMany(std::span<const uint64_t>(&productId, 1)) != 0;
+}
+
+size_t ClockProductCache::invalidateMany(std::span<const uint64_t> productIds) {
+    size_t removed = 0;
+    std::unique_lock lock(mCacheMutex);
+
+    for (uint64_t productId : productIds) {
+        if (auto it = mIndex.find(productId); it != mIndex.end()) {
+            release(it);
+            ++removed;
+        }
+    }
+
+    mMetrics.invalidations.increment(removed);
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} of {} products.", removed, productIds.size());
+    return removed;
+}
+
+size_t ClockProductCache::invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) {
+    size_t removed = 0;
+    std::unique_lock lock(mCacheMutex);
+
+    for (auto it = mIndex.begin(); it != mIndex.end();) {
+        auto current = it++;
+        if (predicate(current->first, *mSlots[current->second].product)) {
+            release(current);
+            ++removed;
+        }
+    }
+
+    mMetrics.invalidations.increment(removed);
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} products matching a predicate.", removed);
+    return removed;
+}
+
+void ClockProductCache::release(std::unordered_map<uint64_t, size_t>::iterator it) {
+    auto& slot = mSlots[it->second];
+    slot.product.reset();
+    slot.referenced.store(false, std::memory_order_relaxed);
+    mFreeSlots.push_back(it->second);
+    mIndex.erase(it);
+}
+
+[[nodiscard]] size_t ClockProductCache::findVictim() {
+    // Every pass clears the bits it skips, so this terminates within two sweeps.
+    while (true) {
+        auto& slot = mSlots[mHand];
+        size_t current = mHand;
+        mHand = (mHand + 1) % mCapacity;
+
+        if (!slot.referenced.exchange(false, std::memory_order_relaxed)) {
+            return current;
+        }
+    }
+}
+
+[[nodiscard]] CacheMetricsSnapshot ClockProductCache::getMetrics() const {
+    auto snapshot = mMetrics.snapshot();
+    std::shared_lock lock(mCacheMutex);
+    snapshot.entries = mIndex.size();
+    return snapshot;
+}
@@ -0,0 +1,39 @@
+#include "CoarseClock.h"
+
+void CoarseClock::start(std::chrono::milliseconds resolution) {
+    std::scoped_lock lock(controlMutex);
+    stopTicker();
+
+    ticks.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    mode.store(Mode::TICKING, std::memory_order_relaxed);
+    tickerThread = std::jthread([resolution](std::stop_token stopToken) {
+        while (!stopToken.stop_requested()) {
+            std::this_thread::sleep_for(resolution);
+            ticks.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        }
+        });
+}
+
+void CoarseClock::stop() {
+    std::scoped_lock lock(controlMutex);
+    stopTicker();
+    mode.store(Mode::PRECISE, std::memory_order_relaxed);
+}
+
+void CoarseClock::setTime(time_point time) {
+    std::scoped_lock lock(controlMutex);
+    stopTicker();
+    ticks.store(time.time_since_epoch().count(), std::memory_order_relaxed);
+    mode.store(Mode::MANUAL, std::memory_order_relaxed);
+}
+
+void CoarseClock::advance(std::chrono::steady_clock::duration duration) {
+    setTime(now() + duration);
+}
+
+void CoarseClock::stopTicker() {
+    if (tickerThread.joinable()) {
+        tickerThread.request_stop();
+        tickerThread.join();
+    }
+}
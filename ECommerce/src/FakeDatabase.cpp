@@ -4,63 +4,211 @@
 
 #include <format>
 #include <algorithm>
+#include <array>
 #include <ranges>
 
-constexpr unsigned int PRODUCTS_NBR = 3000;
-
-FakeDatabase::FakeDatabase() {
-    Logger::log(LogLevel::INFO, LogCategory::DATABASE, std::format("Initializing FakeDatabase with {} products...", std::to_string(PRODUCTS_NBR)));
+FakeDatabase::FakeDatabase(size_t productCount) {
+    LOG_INFO(LogCategory::DATABASE, "Initializing FakeDatabase with {} products...", productCount);
 
     try {
-        mProducts.reserve(PRODUCTS_NBR);  // Reserve space to avoid reallocations
-
-        for (uint64_t i = 1; i <= PRODUCTS_NBR; ++i) {
-            uint32_t category = (i % 3) + 100;  // Cycles through 100, 101, 102
-            auto name = std::format("Product {}", i);
-            auto description = std::format("Description of {}", name);
-
-            std::vector<std::byte> thumbnail{
-                std::byte { 'A' + (i % 26)},
-                std::byte { 'B' + (i % 26)},
-                std::byte { 'C' + (i % 26)}
-            };
+        mProducts.reserve(productCount);  // Reserve space to avoid reallocations
+        for (uint32_t category = 100; category <= 102; ++category) {
+            mCategoryIndex[category].reserve(productCount / 3 + 1);
+        }
 
-            mProducts.emplace(i, Product{ i, category, name, description, thumbnail });
+        generateProducts(productCount, [this](const GeneratedProduct& product) {
+            mProducts.try_emplace(product.id, product.id, product.category, product.name, product.description, product.thumbnail, mArena);
+            // IDs ascend, so appending keeps each category sorted.
+            mCategoryIndex[product.category].push_back(product.id);
 
-            if (i % 500 == 0) {
-                Logger::log(LogLevel::INFO, LogCategory::DATABASE, std::format("Added Product ID: {} to FakeDatabase", std::to_string(i)));
+            if (product.id % 500 == 0) {
+                LOG_INFO(LogCategory::DATABASE, "Added Product ID: {} to FakeDatabase", product.id);
             }
-        }
+            });
     }
     catch (const std::exception& e) {
-        Logger::log(LogLevel::ERROR, LogCategory::DATABASE, std::format("Failed to initialize FakeDatabase: {}", e.what()));
+        LOG_ERROR(LogCategory::DATABASE, "Failed to initialize FakeDatabase: {}", e.what());
         throw;
     }
 
-    Logger::log(LogLevel::INFO, LogCategory::DATABASE, "FakeDatabase initialized successfully.");
+    LOG_INFO(LogCategory::DATABASE, "FakeDatabase initialized successfully.");
+}
+
+void FakeDatabase::generateProducts(size_t productCount, const std::function<void(const GeneratedProduct&)>& sink) {
+    for (uint64_t i = 1; i <= productCount; ++i) {
+        uint32_t category = (i % 3) + 100;  // Cycles through 100, 101, 102
+
+        // Fields are formatted into stack buffers; the sink copies them out.
+        std::array<char, 64> nameBuffer;
+        std::array<char, 96> descriptionBuffer;
+        const auto nameEnd = std::format_to_n(nameBuffer.data(), nameBuffer.size(), "Product {}", i).out;
+        const std::string_view name(nameBuffer.data(), nameEnd);
+        const auto descriptionEnd = std::format_to_n(descriptionBuffer.data(), descriptionBuffer.size(), "Description of {}", name).out;
+        const std::string_view description(descriptionBuffer.data(), descriptionEnd);
+
+        const std::array<std::byte, 3> thumbnail{
+            std::byte { 'A' + (i % 26)},
+            std::byte { 'B' + (i % 26)},
+            std::byte { 'C' + (i % 26)}
+        };
+
+        sink(GeneratedProduct{ i, category, name, description, thumbnail });
+    }
 }
 
 std::optional<Product> FakeDatabase::fetchProductDetails(uint64_t productId) {
-    Logger::log(LogLevel::INFO, LogCategory::DATABASE, std::format("Fetching product details for Product ID: {}", std::to_string(productId)));
+    return fetchProductDetails(Prehashed<uint64_t>(productId));
+}
+
+std::optional<Product> FakeDatabase::fetchProductDetails(const Prehashed<uint64_t>& productId) {
+    LOG_INFO(LogCategory::DATABASE, "Fetching product details for Product ID: {}", productId.key);
+    std::shared_lock lock(mProductsMutex);
 
     if (auto it = mProducts.find(productId); it != mProducts.end()) {
-        Logger::log(LogLevel::INFO, LogCategory::DATABASE, std::format("Found Product ID: {} in FakeDatabase", std::to_string(productId)));
+        LOG_INFO(LogCategory::DATABASE, "Found Product ID: {} in FakeDatabase", productId.key);
         return it->second;
     }
 
-    Logger::log(LogLevel::WARNING, LogCategory::DATABASE, std::format("Product ID: {} not found in FakeDatabase.", std::to_string(productId)));
+    LOG_WARNING(LogCategory::DATABASE, "Product ID: {} not found in FakeDatabase.", productId.key);
     return std::nullopt;
 }
 
-size_t FakeDatabase::fetchProductCountByCategory(uint32_t categoryId) {
-    Logger::log(LogLevel::INFO, LogCategory::DATABASE, std::format("Counting mProducts in category ID: {}", std::to_string(categoryId)));
+std::vector<std::optional<Product>> FakeDatabase::fetchProductDetailsBatch(std::span<const uint64_t> productIds) {
+    LOG_INFO(LogCategory::DATABASE, "Fetching product details for a batch of {} products", productIds.size());
 
-    auto filteredView = mProducts | std::ranges::views::filter([categoryId](const auto& productPair) {
-        return productPair.second.getCategory() == categoryId;
-        });
+    std::vector<std::optional<Product>> products;
+    products.reserve(productIds.size());
+    size_t found = 0;
 
-    size_t count = std::ranges::distance(filteredView);
+    std::shared_lock lock(mProductsMutex);
+    for (uint64_t productId : productIds) {
+        if (auto it = mProducts.find(productId); it != mProducts.end()) {
+            products.emplace_back(it->second);
+            ++found;
+        }
+        else {
+            products.emplace_back(std::nullopt);
+        }
+    }
 
-    Logger::log(LogLevel::INFO, LogCategory::DATABASE, std::format("Found {} mProducts in category ID: {}", std::to_string(count), std::to_string(categoryId)));
+    LOG_INFO(LogCategory::DATABASE, "Found {} of {} products in FakeDatabase", found, productIds.size());
+    return products;
+}
+
+size_t FakeDatabase::fetchProductCountByCategory(uint32_t categoryId) {
+    LOG_INFO(LogCategory::DATABASE, "Counting mProducts in category ID: {}", categoryId);
+    std::shared_lock lock(mProductsMutex);
+
+    const auto it = mCategoryIndex.find(categoryId);
+    const size_t count = it != mCategoryIndex.end() ? it->second.size() : 0;
+
+    LOG_INFO(LogCategory::DATABASE, "Found {} mProducts in category ID: {}", count, categoryId);
     return count;
 }
+
+std::vector<Product> FakeDatabase::fetchProductsByCategory(uint32_t categoryId, size_t offset, size_t limit) {
+    LOG_INFO(LogCategory::DATABASE, "Listing up to {} products of category ID: {} from offset {}", limit, categoryId, offset);
+
+    std::vector<Product> products;
+    std::shared_lock lock(mProductsMutex);
+
+    const auto it = mCategoryIndex.find(categoryId);
+    if (it == mCategoryIndex.end() || offset >= it->second.size()) {
+        return products;
+    }
+
+    const auto& productIds = it->second;
+    const size_t end = offset + std::min(limit, productIds.size() - offset);
+    products.reserve(end - offset);
+    for (size_t position = offset; position < end; ++position) {
+        products.push_back(mProducts.at(productIds[position]));
+    }
+
+    LOG_INFO(LogCategory::DATABASE, "Listed {} products of category ID: {}", products.size(), categoryId);
+    return products;
+}
+
+uint64_t FakeDatabase::subscribe(ChangeListener listener) {
+    std::scoped_lock lock(mListenersMutex);
+    const uint64_t subscriptionId = mNextSubscriptionId++;
+    mListeners.emplace(subscriptionId, std::move(listener));
+    LOG_INFO(LogCategory::DATABASE, "Change listener {} subscribed.", subscriptionId);
+    return subscriptionId;
+}
+
+void FakeDatabase::unsubscribe(uint64_t subscriptionId) {
+    std::scoped_lock lock(mListenersMutex);
+    mListeners.erase(subscriptionId);
+    LOG_INFO(LogCategory::DATABASE, "Change listener {} unsubscribed.", subscriptionId);
+}
+
+void FakeDatabase::updateProducts(std::span<const Product> products) {
+    std::vector<ProductChange> changes;
+    changes.reserve(products.size());
+    {
+        std::unique_lock lock(mProductsMutex);
+        for (const auto& product : products) {
+            const uint32_t categoryId = product.getCategory();
+            if (auto it = mProducts.find(product.getId()); it != mProducts.end()) {
+                const uint32_t previousCategoryId = it->second.getCategory();
+                if (previousCategoryId != categoryId) {
+                    unindexProduct(previousCategoryId, product.getId());
+                    indexProduct(categoryId, product.getId());
+                }
+                it->second = product;
+                changes.push_back({ product.getId(), ProductChange::Kind::UPDATED, categoryId, previousCategoryId });
+            }
+            else {
+                mProducts.emplace(product.getId(), product);
+                indexProduct(categoryId, product.getId());
+                changes.push_back({ product.getId(), ProductChange::Kind::ADDED, categoryId, categoryId });
+            }
+        }
+    }
+
+    LOG_INFO(LogCategory::DATABASE, "Updated {} products in FakeDatabase", products.size());
+    notify(changes);
+}
+
+void FakeDatabase::removeProducts(std::span<const uint64_t> productIds) {
+    std::vector<ProductChange> changes;
+    changes.reserve(productIds.size());
+    {
+        std::unique_lock lock(mProductsMutex);
+        for (uint64_t productId : productIds) {
+            if (auto it = mProducts.find(productId); it != mProducts.end()) {
+                const uint32_t categoryId = it->second.getCategory();
+                unindexProduct(categoryId, productId);
+                mProducts.erase(it);
+                changes.push_back({ productId, ProductChange::Kind::REMOVED, categoryId, categoryId });
+            }
+        }
+    }
+
+    LOG_INFO(LogCategory::DATABASE, "Removed {} of {} products from FakeDatabase", changes.size(), productIds.size());
+    notify(changes);
+}
+
+void FakeDatabase::notify(std::span<const ProductChange> changes) {
+    if (changes.empty()) {
+        return;
+    }
+
+    // Outside mProductsMutex, so listeners may read the database back.
+    std::scoped_lock lock(mListenersMutex);
+    for (const auto& [subscriptionId, listener] : mListeners) {
+        listener(changes);
+    }
+}
+
+void FakeDatabase::indexProduct(uint32_t categoryId, uint64_t productId) {
+    auto& productIds = mCategoryIndex[categoryId];
+    productIds.insert(std::ranges::lower_bound(productIds, productId), productId);
+}
+
+void FakeDatabase::unindexProduct(uint32_t categoryId, uint64_t productId) {
+    auto& productIds = mCategoryIndex[categoryId];
+    if (auto it = std::ranges::lower_bound(productIds, productId); it != productIds.end() && *it == productId) {
+        productIds.erase(it);
+    }
+}
@@ -0,0 +1,155 @@
+#include "FlatProductIndex.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_PRODUCT_INDEX_SSE2 1
+#endif
+
+namespace {
+    // Control byte states; full slots store the low 7 hash bits (0..127), so
+    // exactly the empty and deleted states have the sign bit set.
+    constexpr int8_t EMPTY = -128;
+    constexpr int8_t DELETED = -2;
+    constexpr size_t NPOS = SIZE_MAX;
+
+    constexpr uint64_t hashKey(uint64_t key) noexcept {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        return key ^ (key >> 33);
+    }
+
+    constexpr int8_t controlHash(uint64_t hash) noexcept {
+        return static_cast<int8_t>(hash & 0x7F);
+    }
+
+    // Bit i is set when control byte i of the group equals `value`.
+    uint32_t matchByte(const int8_t* group, int8_t value) noexcept {
+#ifdef FLAT_PRODUCT_INDEX_SSE2
+        const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(value))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < 16; ++i) {
+            mask |= static_cast<uint32_t>(group[i] == value) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Bit i is set when slot i of the group can take a new entry.
+    uint32_t matchEmptyOrDeleted(const int8_t* group) noexcept {
+#ifdef FLAT_PRODUCT_INDEX_SSE2
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < 16; ++i) {
+            mask |= static_cast<uint32_t>(group[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+}
+
+FlatProductIndex::FlatProductIndex(size_t capacity)
+    // Twice the key count keeps probe chains short and leaves room for erased
+    // slots to accumulate between rehashes.
+    : mControl(std::bit_ceil(std::max<size_t>(capacity * 2, GROUP_WIDTH)), EMPTY)
+    , mSlots(mControl.size())
+    , mGroupMask(mControl.size() / GROUP_WIDTH - 1)
+    , mMaxUsed(mControl.size() / 8 * 7)
+{
+    mRehashScratch.reserve(capacity);
+}
+
+[[nodiscard]] uint32_t FlatProductIndex::find(uint64_t productId) const noexcept {
+    const size_t slot = findSlot(productId);
+    return slot == NPOS ? NOT_FOUND : mSlots[slot].value;
+}
+
+void FlatProductIndex::insert(uint64_t productId, uint32_t value) {
+    if (mSize + mTombstones >= mMaxUsed && mTombstones > 0) {
+        rehash();
+    }
+
+    const uint64_t hash = hashKey(productId);
+    size_t group = (hash >> 7) & mGroupMask;
+    // Triangular probing over a power-of-two group count visits every group.
+    for (size_t step = 1;; ++step) {
+        if (const uint32_t free = matchEmptyOrDeleted(&mControl[group * GROUP_WIDTH])) {
+            const size_t slot = group * GROUP_WIDTH + static_cast<size_t>(std::countr_zero(free));
+            if (mControl[slot] == DELETED) {
+                --mTombstones;
+            }
+            mControl[slot] = controlHash(hash);
+            mSlots[slot] = Slot{ productId, value };
+            ++mSize;
+            return;
+        }
+        group = (group + step) & mGroupMask;
+    }
+}
+
+void FlatProductIndex::erase(uint64_t productId) noexcept {
+    const size_t slot = findSlot(productId);
+    if (slot == NPOS) {
+        return;
+    }
+
+    // Lookups stop at the first group holding an empty slot. If this group still
+    // has one, no probe ever continued past it and the slot can simply be emptied;
+    // otherwise a tombstone keeps later groups reachable.
+    const int8_t* group = &mControl[slot / GROUP_WIDTH * GROUP_WIDTH];
+    if (matchByte(group, EMPTY) != 0) {
+        mControl[slot] = EMPTY;
+    }
+    else {
+        mControl[slot] = DELETED;
+        ++mTombstones;
+    }
+    --mSize;
+}
+
+void FlatProductIndex::clear() noexcept {
+    std::ranges::fill(mControl, EMPTY);
+    mSize = 0;
+    mTombstones = 0;
+}
+
+[[nodiscard]] size_t FlatProductIndex::findSlot(uint64_t productId) const noexcept {
+    const uint64_t hash = hashKey(productId);
+    const int8_t tag = controlHash(hash);
+    size_t group = (hash >> 7) & mGroupMask;
+
+    for (size_t step = 1;; ++step) {
+        const int8_t* control = &mControl[group * GROUP_WIDTH];
+        for (uint32_t match = matchByte(control, tag); match != 0; match &= match - 1) {
+            const size_t slot = group * GROUP_WIDTH + static_cast<size_t>(std::countr_zero(match));
+            if (mSlots[slot].productId == productId) {
+                return slot;
+            }
+        }
+        if (matchByte(control, EMPTY) != 0) {
+            return NPOS;
+        }
+        group = (group + step) & mGroupMask;
+    }
+}
+
+void FlatProductIndex::rehash() {
+    mRehashScratch.clear();
+    for (size_t slot = 0; slot < mControl.size(); ++slot) {
+        if (mControl[slot] >= 0) {
+            mRehashScratch.push_back(mSlots[slot]);
+        }
+    }
+
+    clear();
+    for (const auto& [productId, value] : mRehashScratch) {
+        insert(productId, value);
+    }
+}
@@ -0,0 +1,79 @@
+#include "FrequencySketch.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+    constexpr std::array<uint64_t, 4> ROW_SEEDS{
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+    };
+
+    constexpr uint64_t mixKey(uint64_t key, uint64_t seed) noexcept {
+        key = (key ^ seed) * 0x9e3779b97f4a7c15ULL;
+        key ^= key >> 32;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        return key ^ (key >> 29);
+    }
+}
+
+FrequencySketch::FrequencySketch(size_t capacity)
+    // One word (sixteen counters) per expected entry keeps the counters sparse
+    // enough that a sample period of one-off keys does not look popular.
+    : mTable(std::bit_ceil(std::max<size_t>(capacity, 1)))
+    , mCounterMask(mTable.size() * COUNTERS_PER_WORD - 1)
+    , mSampleSize(capacity == 0 ? 10 : capacity * 10)
+{
+}
+
+void FrequencySketch::increment(uint64_t key) noexcept {
+    const auto indexes = counterIndexes(key);
+    uint32_t estimate = MAX_FREQUENCY;
+    for (size_t index : indexes) {
+        estimate = std::min(estimate, counterAt(index));
+    }
+    if (estimate == MAX_FREQUENCY) {
+        return;
+    }
+
+    // Conservative update: only the counters holding the current estimate grow,
+    // so keys that merely collide with a popular one are not inflated as well.
+    for (size_t index : indexes) {
+        if (counterAt(index) == estimate) {
+            mTable[index / COUNTERS_PER_WORD] += uint64_t{ 1 } << ((index % COUNTERS_PER_WORD) * 4);
+        }
+    }
+
+    if (++mAdditions >= mSampleSize) {
+        age();
+    }
+}
+
+[[nodiscard]] uint32_t FrequencySketch::frequency(uint64_t key) const noexcept {
+    uint32_t estimate = MAX_FREQUENCY;
+    for (size_t index : counterIndexes(key)) {
+        estimate = std::min(estimate, counterAt(index));
+    }
+    return estimate;
+}
+
+[[nodiscard]] std::array<size_t, FrequencySketch::DEPTH> FrequencySketch::counterIndexes(uint64_t key) const noexcept {
+    std::array<size_t, DEPTH> indexes{};
+    for (size_t row = 0; row < DEPTH; ++row) {
+        indexes[row] = static_cast<size_t>(mixKey(key, ROW_SEEDS[row])) & mCounterMask;
+    }
+    return indexes;
+}
+
+[[nodiscard]] uint32_t FrequencySketch::counterAt(size_t index) const noexcept {
+    return static_cast<uint32_t>((mTable[index / COUNTERS_PER_WORD] >> ((index % COUNTERS_PER_WORD) * 4)) & 0xF);
+}
+
+void FrequencySketch::age() noexcept {
+    // Halve all sixteen counters of a word at once: shift right and drop the bit
+    // that crossed into the neighbouring counter.
+    constexpr uint64_t LOW_THREE_BITS = 0x7777777777777777ULL;
+    for (uint64_t& word : mTable) {
+        word = (word >> 1) & LOW_THREE_BITS;
+    }
+    mAdditions /= 2;
+}
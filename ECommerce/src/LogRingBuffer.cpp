@@ -0,0 +1,79 @@
+#include "LogRingBuffer.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+void LogRecord::setMessage(std::string_view text) noexcept {
+    length = static_cast<uint16_t>(std::min(text.size(), MAX_MESSAGE_LENGTH));
+    std::copy_n(text.data(), length, message.data());
+}
+
+[[nodiscard]] std::string_view LogRecord::getMessage() const noexcept {
+    return { message.data(), length };
+}
+
+LogRingBuffer::LogRingBuffer(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Log queue capacity must be greater than zero.");
+    }
+
+    capacity = std::bit_ceil(capacity);
+    mMask = capacity - 1;
+    mCells = std::make_unique<Cell[]>(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        mCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+[[nodiscard]] bool LogRingBuffer::tryPush(const LogRecord& record) noexcept {
+    size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = mCells[position & mMask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (diff == 0) {
+            // The cell is free for this lap; claim it.
+            if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.record = record;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) {
+            // The consumer has not freed this cell yet: the queue is full.
+            return false;
+        }
+        else {
+            position = mEnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+[[nodiscard]] bool LogRingBuffer::tryPop(LogRecord& record) noexcept {
+    size_t position = mDequeuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = mCells[position & mMask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+        if (diff == 0) {
+            if (mDequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                record = cell.record;
+                cell.sequence.store(position + mMask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0) {
+            return false;
+        }
+        else {
+            position = mDequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+[[nodiscard]] size_t LogRingBuffer::getCapacity() const noexcept {
+    return mMask + 1;
+}
@@ -1,6 +1,7 @@
 #include "Logger.h"
 #include <iomanip>
 #include <filesystem>
+#include <iterator>
 
 
 void Logger::initialize(const std::string& filename) {
@@ -14,6 +15,10 @@ void Logger::initialize(const std::string& filename) {
             fs::create_directories(logPath.parent_path());
         }
 
+        if (logFile.is_open()) {
+            logFile.close();
+        }
+        logFile.clear();
         logFile.open(filename, std::ios::app);
         if (!logFile.is_open()) {
             throw std::ios_base::failure("Failed to open log file.");
@@ -25,8 +30,34 @@ void Logger::initialize(const std::string& filename) {
 }
 
 void Logger::log(LogLevel level, LogCategory category, const std::string& message) {
-    if (level < currentLogLevel) return;
+    if (!isEnabled(level)) return;
+
+    if (AsyncProducer producer; producer) {
+        LogRecord record{ std::chrono::system_clock::now(), level, category };
+        record.setMessage(message);
+        enqueue(record);
+        return;
+    }
+
+    writeSync(level, category, message);
+}
+
+void Logger::enqueue(const LogRecord& record) {
+    if (asyncQueue->tryPush(record)) {
+        return;
+    }
+
+    overflowCount.fetch_add(1, std::memory_order_relaxed);
+    if (asyncOverflowPolicy == LogOverflowPolicy::BLOCK) {
+        // shutdown() keeps the writer running until every producer is done,
+        // so a slot is always freed eventually.
+        while (!asyncQueue->tryPush(record)) {
+            std::this_thread::yield();
+        }
+    }
+}
 
+void Logger::writeSync(LogLevel level, LogCategory category, std::string_view message) {
     std::scoped_lock lock(logMutex);
     auto logMessage = std::format("{} [{}] [{}] {}",
         getCurrentTime(),
@@ -43,14 +74,107 @@ void Logger::log(LogLevel level, LogCategory category, const std::string& messag
 }
 
 void Logger::setLogLevel(LogLevel level) {
-    std::scoped_lock lock(logMutex);
-    currentLogLevel = level;
+    currentLogLevel.store(level, std::memory_order_relaxed);
+}
+
+void Logger::enableAsync(size_t queueCapacity, LogOverflowPolicy overflowPolicy, std::chrono::milliseconds flushInterval) {
+    std::scoped_lock lock(asyncControlMutex, logMutex);
+    if (asyncEnabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // No producer can hold the queue here: either async mode never ran, or
+    // shutdown() waited for every producer before returning.
+    if (!asyncQueue || asyncQueue->getCapacity() < queueCapacity) {
+        asyncQueue = std::make_unique<LogRingBuffer>(queueCapacity);
+    }
+    asyncOverflowPolicy = overflowPolicy;
+    asyncFlushInterval = flushInterval;
+    writerThread = std::jthread(&Logger::runWriter);
+    asyncEnabled.store(true, std::memory_order_release);
+}
+
+void Logger::shutdown() {
+    std::scoped_lock lock(asyncControlMutex);
+    // New records go through the synchronous path from here on.
+    asyncEnabled.store(false);
+    // Producers that saw async mode before the store finish their push while
+    // the writer is still running, so the drain after the stop request below
+    // sees every record and a BLOCK producer on a full queue still gets a slot.
+    while (asyncProducers.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    if (writerThread.joinable()) {
+        writerThread.request_stop();
+        writerThread.join();
+    }
+}
+
+[[nodiscard]] uint64_t Logger::getOverflowCount() noexcept {
+    return overflowCount.load(std::memory_order_relaxed);
+}
+
+void Logger::runWriter(std::stop_token stopToken) {
+    constexpr size_t MAX_BATCH_BYTES = 64 * 1024;
+
+    std::string batch;
+    batch.reserve(MAX_BATCH_BYTES);
+    LogRecord record{};
+    auto lastFlush = std::chrono::steady_clock::now();
+
+    auto flushBatch = [&batch, &lastFlush] {
+        std::scoped_lock lock(logMutex);
+        if (logFile.is_open()) {
+            logFile.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            logFile.flush();
+        }
+        else {
+            std::cerr << "Log file not open. Logging to console: " << batch;
+        }
+        batch.clear();
+        lastFlush = std::chrono::steady_clock::now();
+    };
+
+    while (!stopToken.stop_requested()) {
+        bool drained = true;
+        while (batch.size() < MAX_BATCH_BYTES && asyncQueue->tryPop(record)) {
+            writeRecord(batch, record);
+            drained = false;
+        }
+
+        bool intervalElapsed = std::chrono::steady_clock::now() - lastFlush >= asyncFlushInterval;
+        if (!batch.empty() && (batch.size() >= MAX_BATCH_BYTES || intervalElapsed)) {
+            flushBatch();
+        }
+
+        if (drained) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // shutdown() requests the stop only once no producer can push, so this
+    // drain is the last and leaves the queue empty.
+    while (asyncQueue->tryPop(record)) {
+        writeRecord(batch, record);
+    }
+    flushBatch();
+}
+
+void Logger::writeRecord(std::string& batch, const LogRecord& record) {
+    std::format_to(std::back_inserter(batch), "{} [{}] [{}] {}\n",
+        formatTime(record.time),
+        logLevelToString(record.level),
+        logCategoryToString(record.category),
+        record.getMessage());
 }
 
 std::string Logger::getCurrentTime() {
+    return formatTime(std::chrono::system_clock::now());
+}
+
+std::string Logger::formatTime(std::chrono::system_clock::time_point time) {
     using namespace std::chrono;
-    auto now = system_clock::now();
-    auto zonedTime = zoned_time{ current_zone(), now };
+    auto zonedTime = zoned_time{ current_zone(), time };
     return format("{:%Y-%m-%d %H:%M:%S}", zonedTime.get_local_time());
 }
 
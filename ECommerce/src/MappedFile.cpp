@@ -0,0 +1,97 @@
+#include "MappedFile.h"
+#include "Logger.h"
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    mFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE) {
+        mFile = nullptr;
+        LOG_ERROR(LogCategory::DATABASE, "Failed to open {}.", path.string());
+        throw std::runtime_error("Failed to open mapped file.");
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0) {
+        CloseHandle(mFile);
+        LOG_ERROR(LogCategory::DATABASE, "Mapped file {} is empty or unreadable.", path.string());
+        throw std::runtime_error("Mapped file is empty or unreadable.");
+    }
+    mSize = static_cast<size_t>(size.QuadPart);
+
+    mMapping = CreateFileMappingW(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mMapping ? MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mMapping) {
+            CloseHandle(mMapping);
+        }
+        CloseHandle(mFile);
+        LOG_ERROR(LogCategory::DATABASE, "Failed to map {}.", path.string());
+        throw std::runtime_error("Failed to map file.");
+    }
+    mData = static_cast<const std::byte*>(view);
+}
+
+MappedFile::~MappedFile() {
+    UnmapViewOfFile(mData);
+    CloseHandle(mMapping);
+    CloseHandle(mFile);
+}
+
+void MappedFile::evict() noexcept {
+    // Unlocking pages that are not locked removes them from the working set.
+    VirtualUnlock(const_cast<std::byte*>(mData), mSize);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    mFile = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (mFile < 0) {
+        LOG_ERROR(LogCategory::DATABASE, "Failed to open {}.", path.string());
+        throw std::runtime_error("Failed to open mapped file.");
+    }
+
+    struct stat status {};
+    if (::fstat(mFile, &status) != 0 || status.st_size == 0) {
+        ::close(mFile);
+        LOG_ERROR(LogCategory::DATABASE, "Mapped file {} is empty or unreadable.", path.string());
+        throw std::runtime_error("Mapped file is empty or unreadable.");
+    }
+    mSize = static_cast<size_t>(status.st_size);
+
+    void* view = ::mmap(nullptr, mSize, PROT_READ, MAP_SHARED, mFile, 0);
+    if (view == MAP_FAILED) {
+        ::close(mFile);
+        LOG_ERROR(LogCategory::DATABASE, "Failed to map {}.", path.string());
+        throw std::runtime_error("Failed to map file.");
+    }
+    // Lookups jump around the file, so read-ahead would mostly fetch unused pages.
+    ::madvise(view, mSize, MADV_RANDOM);
+    mData = static_cast<const std::byte*>(view);
+}
+
+MappedFile::~MappedFile() {
+    ::munmap(const_cast<std::byte*>(mData), mSize);
+    ::close(mFile);
+}
+
+void MappedFile::evict() noexcept {
+    ::madvise(const_cast<std::byte*>(mData), mSize, MADV_DONTNEED);
+    ::posix_fadvise(mFile, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+#endif
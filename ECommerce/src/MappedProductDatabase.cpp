@@ -0,0 +1,175 @@
+#include "MappedProductDatabase.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+    // Whether [offset, offset + count * size) lies within `limit` without overflowing.
+    bool fits(uint64_t offset, uint64_t count, uint64_t size, uint64_t limit) noexcept {
+        return offset <= limit && count <= (limit - offset) / size;
+    }
+}
+
+MappedProductDatabase::MappedProductDatabase(const std::filesystem::path& path)
+    : mFile{ path }
+    , mBytes{ mFile.getBytes() }
+{
+    using Format = MappedProductFormat;
+
+    if (mBytes.size() < sizeof(Format::Header)) {
+        LOG_ERROR(LogCategory::DATABASE, "Product store {} is too small for a header.", path.string());
+        throw std::runtime_error("Product store is truncated.");
+    }
+    mHeader = load<Format::Header>(0);
+
+    if (mHeader.magic != Format::MAGIC || mHeader.version != Format::VERSION) {
+        LOG_ERROR(LogCategory::DATABASE, "Product store {} has an unknown format.", path.string());
+        throw std::runtime_error("Product store has an unknown format.");
+    }
+    const uint64_t size = mBytes.size();
+    if (mHeader.fileSize != size
+        || mHeader.indexOffset < sizeof(Format::Header)
+        || mHeader.indexBits >= 64
+        || (uint64_t{ 1 } << mHeader.indexBits) <= mHeader.productCount
+        || !fits(mHeader.indexOffset, uint64_t{ 1 } << mHeader.indexBits, sizeof(Format::IndexEntry), size)
+        || !fits(mHeader.categoryOffset, mHeader.categoryCount, sizeof(Format::CategoryEntry), size)
+        || !fits(mHeader.membersOffset, mHeader.productCount, sizeof(Format::IndexEntry), size)) {
+        LOG_ERROR(LogCategory::DATABASE, "Product store {} is truncated or corrupt.", path.string());
+        throw std::runtime_error("Product store is truncated or corrupt.");
+    }
+    // Checked once here so listing a category never reads past the members section.
+    for (uint64_t position = 0; position < mHeader.categoryCount; ++position) {
+        const auto category = load<Format::CategoryEntry>(mHeader.categoryOffset + position * sizeof(Format::CategoryEntry));
+        if (category.memberCount > mHeader.productCount || category.firstMember > mHeader.productCount - category.memberCount) {
+            LOG_ERROR(LogCategory::DATABASE, "Product store {} lists members of category {} outside the members section.",
+                path.string(), category.categoryId);
+            throw std::runtime_error("Product store is truncated or corrupt.");
+        }
+    }
+
+    LOG_INFO(LogCategory::DATABASE, "Mapped {} products in {} categories from {}.",
+        mHeader.productCount, mHeader.categoryCount, path.string());
+}
+
+std::optional<Product> MappedProductDatabase::fetchProductDetails(uint64_t productId) {
+    LOG_INFO(LogCategory::DATABASE, "Fetching product details for Product ID: {}", productId);
+
+    if (const uint64_t offset = findRecord(productId); offset != NOT_FOUND) {
+        return readRecord(offset);
+    }
+
+    LOG_WARNING(LogCategory::DATABASE, "Product ID: {} not found in MappedProductDatabase.", productId);
+    return std::nullopt;
+}
+
+std::vector<std::optional<Product>> MappedProductDatabase::fetchProductDetailsBatch(std::span<const uint64_t> productIds) {
+    LOG_INFO(LogCategory::DATABASE, "Fetching product details for a batch of {} products", productIds.size());
+
+    std::vector<std::optional<Product>> products;
+    products.reserve(productIds.size());
+    size_t found = 0;
+
+    for (uint64_t productId : productIds) {
+        if (const uint64_t offset = findRecord(productId); offset != NOT_FOUND) {
+            products.emplace_back(readRecord(offset));
+            ++found;
+        }
+        else {
+            products.emplace_back(std::nullopt);
+        }
+    }
+
+    LOG_INFO(LogCategory::DATABASE, "Found {} of {} products in MappedProductDatabase", found, productIds.size());
+    return products;
+}
+
+size_t MappedProductDatabase::fetchProductCountByCategory(uint32_t categoryId) {
+    LOG_INFO(LogCategory::DATABASE, "Counting products in category ID: {}", categoryId);
+
+    const auto category = findCategory(categoryId);
+    const size_t count = category ? category->memberCount : 0;
+
+    LOG_INFO(LogCategory::DATABASE, "Found {} products in category ID: {}", count, categoryId);
+    return count;
+}
+
+std::vector<Product> MappedProductDatabase::fetchProductsByCategory(uint32_t categoryId, size_t offset, size_t limit) {
+    LOG_INFO(LogCategory::DATABASE, "Listing up to {} products of category ID: {} from offset {}", limit, categoryId, offset);
+
+    std::vector<Product> products;
+    const auto category = findCategory(categoryId);
+    if (!category || offset >= category->memberCount) {
+        return products;
+    }
+
+    const uint64_t end = offset + std::min<uint64_t>(limit, category->memberCount - offset);
+    products.reserve(end - offset);
+    for (uint64_t position = category->firstMember + offset; position < category->firstMember + end; ++position) {
+        const auto member = load<MappedProductFormat::IndexEntry>(
+            mHeader.membersOffset + position * sizeof(MappedProductFormat::IndexEntry));
+        products.push_back(readRecord(member.recordOffset));
+    }
+
+    LOG_INFO(LogCategory::DATABASE, "Listed {} products of category ID: {}", products.size(), categoryId);
+    return products;
+}
+
+[[nodiscard]] uint64_t MappedProductDatabase::findRecord(uint64_t productId) const noexcept {
+    using Format = MappedProductFormat;
+
+    // The writer always leaves empty slots, but a corrupt index may not, so
+    // the probe stops after visiting every slot once.
+    const uint64_t slotCount = uint64_t{ 1 } << mHeader.indexBits;
+    uint64_t slot = Format::indexSlot(productId, mHeader.indexBits);
+    for (uint64_t probes = 0; probes < slotCount; ++probes, slot = (slot + 1) & (slotCount - 1)) {
+        const auto entry = load<Format::IndexEntry>(mHeader.indexOffset + slot * sizeof(Format::IndexEntry));
+        if (entry.recordOffset == NOT_FOUND) {
+            return NOT_FOUND;
+        }
+        if (entry.productId == productId) {
+            return entry.recordOffset;
+        }
+    }
+    return NOT_FOUND;
+}
+
+[[nodiscard]] std::optional<MappedProductFormat::CategoryEntry> MappedProductDatabase::findCategory(uint32_t categoryId) const noexcept {
+    // A catalog has a handful of categories, so a linear scan beats anything clever.
+    for (uint64_t position = 0; position < mHeader.categoryCount; ++position) {
+        const auto entry = load<MappedProductFormat::CategoryEntry>(
+            mHeader.categoryOffset + position * sizeof(MappedProductFormat::CategoryEntry));
+        if (entry.categoryId == categoryId) {
+            return entry;
+        }
+        if (entry.categoryId > categoryId) {
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] Product MappedProductDatabase::readRecord(uint64_t offset) const {
+    using Format = MappedProductFormat;
+
+    const uint64_t recordsEnd = mHeader.indexOffset;
+    if (offset < sizeof(Format::Header) || !fits(offset, 1, sizeof(Format::RecordHeader), recordsEnd)) {
+        LOG_ERROR(LogCategory::DATABASE, "Record offset {} lies outside the record section.", offset);
+        throw std::runtime_error("Product store record is corrupt.");
+    }
+    const auto record = load<Format::RecordHeader>(offset);
+    const uint64_t fields = offset + sizeof(record);
+    const uint64_t fieldsSize = uint64_t{ record.nameLength } + record.descriptionLength + record.thumbnailLength;
+    if (!fits(fields, fieldsSize, 1, recordsEnd)) {
+        LOG_ERROR(LogCategory::DATABASE, "Record at offset {} runs past the record section.", offset);
+        throw std::runtime_error("Product store record is corrupt.");
+    }
+
+    const auto* bytes = mBytes.data() + fields;
+    const std::string_view name(reinterpret_cast<const char*>(bytes), record.nameLength);
+    const std::string_view description(reinterpret_cast<const char*>(bytes + record.nameLength), record.descriptionLength);
+    const std::span<const std::byte> thumbnail(bytes + record.nameLength + record.descriptionLength, record.thumbnailLength);
+    return Product(record.id, record.category, name, description, thumbnail);
+}
@@ -0,0 +1,140 @@
+#include "MappedProductWriter.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+MappedProductWriter::MappedProductWriter(const std::filesystem::path& path)
+    : mPath{ path }
+    , mOutput{ path, std::ios::binary | std::ios::trunc }
+{
+    if (!mOutput.is_open()) {
+        LOG_ERROR(LogCategory::DATABASE, "Failed to create product store {}.", path.string());
+        throw std::ios_base::failure("Failed to create product store.");
+    }
+
+    // Reserved now and filled in by finish(), once the section offsets are known.
+    const MappedProductFormat::Header header{};
+    write(&header, sizeof(header));
+    LOG_INFO(LogCategory::DATABASE, "Writing product store {}.", path.string());
+}
+
+void MappedProductWriter::add(uint64_t id,
+    uint32_t category,
+    std::string_view name,
+    std::string_view description,
+    std::span<const std::byte> thumbnail) {
+    if (mFinished) {
+        throw std::logic_error("Product store is already finished.");
+    }
+    if (!mIndex.empty() && id <= mIndex.back().productId) {
+        LOG_ERROR(LogCategory::DATABASE, "Product ID: {} added after Product ID: {}.", id, mIndex.back().productId);
+        throw std::invalid_argument("Product IDs must be added in ascending order.");
+    }
+    constexpr size_t MAX_FIELD = std::numeric_limits<uint32_t>::max();
+    if (name.size() > MAX_FIELD || description.size() > MAX_FIELD || thumbnail.size() > MAX_FIELD) {
+        throw std::length_error("Product field exceeds 4 GiB.");
+    }
+
+    mIndex.push_back({ id, mOffset });
+    mCategories.push_back(category);
+
+    const MappedProductFormat::RecordHeader record{
+        id,
+        category,
+        static_cast<uint32_t>(name.size()),
+        static_cast<uint32_t>(description.size()),
+        static_cast<uint32_t>(thumbnail.size())
+    };
+    write(&record, sizeof(record));
+    write(name.data(), name.size());
+    write(description.data(), description.size());
+    write(thumbnail.data(), thumbnail.size());
+
+    constexpr std::array<char, MappedProductFormat::ALIGNMENT> padding{};
+    write(padding.data(), MappedProductFormat::align(mOffset) - mOffset);
+}
+
+void MappedProductWriter::add(const Product& product) {
+    add(product.getId(), product.getCategory(), product.getName(), product.getDescription(), product.getThumbnailBytes());
+}
+
+void MappedProductWriter::finish() {
+    if (mFinished) {
+        return;
+    }
+
+    MappedProductFormat::Header header{};
+    header.magic = MappedProductFormat::MAGIC;
+    header.version = MappedProductFormat::VERSION;
+    header.productCount = mIndex.size();
+
+    // Linear probing at a load factor of at most 2/3 keeps a lookup to one or
+    // two cache lines of the table.
+    const uint64_t slotCount = std::bit_ceil(std::max<uint64_t>(1, mIndex.size() + (mIndex.size() + 1) / 2));
+    header.indexBits = static_cast<uint32_t>(std::countr_zero(slotCount));
+    std::vector<MappedProductFormat::IndexEntry> slots(slotCount);
+    for (const auto& entry : mIndex) {
+        uint64_t slot = MappedProductFormat::indexSlot(entry.productId, header.indexBits);
+        while (slots[slot].recordOffset != 0) {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        slots[slot] = entry;
+    }
+
+    header.indexOffset = mOffset;
+    write(slots.data(), slots.size() * sizeof(MappedProductFormat::IndexEntry));
+    slots = {};
+
+    // A stable sort by category keeps every group in ascending ID order.
+    std::vector<size_t> members(mIndex.size());
+    std::iota(members.begin(), members.end(), size_t{ 0 });
+    std::ranges::stable_sort(members, {}, [this](size_t member) { return mCategories[member]; });
+
+    std::map<uint32_t, MappedProductFormat::CategoryEntry> categories;
+    for (size_t position = 0; position < members.size(); ++position) {
+        auto [it, inserted] = categories.try_emplace(mCategories[members[position]]);
+        if (inserted) {
+            it->second = { it->first, 0, position, 0 };
+        }
+        ++it->second.memberCount;
+    }
+
+    header.categoryCount = categories.size();
+    header.categoryOffset = mOffset;
+    for (const auto& [categoryId, entry] : categories) {
+        write(&entry, sizeof(entry));
+    }
+
+    header.membersOffset = mOffset;
+    for (size_t member : members) {
+        write(&mIndex[member], sizeof(MappedProductFormat::IndexEntry));
+    }
+
+    header.fileSize = mOffset;
+    mOutput.seekp(0);
+    mOutput.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    mOutput.close();
+    if (mOutput.fail()) {
+        LOG_ERROR(LogCategory::DATABASE, "Failed to finish product store {}.", mPath.string());
+        throw std::ios_base::failure("Failed to write product store.");
+    }
+
+    mFinished = true;
+    LOG_INFO(LogCategory::DATABASE, "Wrote {} products in {} categories to {} ({} bytes).",
+        header.productCount, header.categoryCount, mPath.string(), header.fileSize);
+}
+
+void MappedProductWriter::write(const void* data, size_t size) {
+    mOutput.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (mOutput.fail()) {
+        LOG_ERROR(LogCategory::DATABASE, "Failed to write product store {}.", mPath.string());
+        throw std::ios_base::failure("Failed to write product store.");
+    }
+    mOffset += size;
+}
@@ -0,0 +1,225 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+    // Fixed "le" boundaries, in nanoseconds, so exported series stay stable between scrapes.
+    constexpr std::array<uint64_t, 22> PROMETHEUS_BOUNDS_NANOS{
+        100, 250, 500,
+        1'000, 2'500, 5'000,
+        10'000, 25'000, 50'000,
+        100'000, 250'000, 500'000,
+        1'000'000, 2'500'000, 5'000'000,
+        10'000'000, 25'000'000, 50'000'000,
+        100'000'000, 250'000'000, 500'000'000,
+        1'000'000'000
+    };
+
+    void appendCounter(std::string& out, std::string_view name, std::string_view metric, std::string_view help, uint64_t value) {
+        std::format_to(std::back_inserter(out), "# HELP {}_{}_total {}\n# TYPE {}_{}_total counter\n{}_{}_total {}\n",
+            name, metric, help, name, metric, name, metric, value);
+    }
+
+    void appendGauge(std::string& out, std::string_view name, std::string_view metric, std::string_view help, uint64_t value) {
+        std::format_to(std::back_inserter(out), "# HELP {}_{} {}\n# TYPE {}_{} gauge\n{}_{} {}\n",
+            name, metric, help, name, metric, name, metric, value);
+    }
+
+    void appendHistogram(std::string& out, std::string_view name, std::string_view metric, std::string_view help,
+        const LatencyHistogram::Snapshot& histogram) {
+        std::format_to(std::back_inserter(out), "# HELP {}_{}_seconds {}\n# TYPE {}_{}_seconds histogram\n",
+            name, metric, help, name, metric);
+
+        uint64_t cumulative = 0;
+        size_t bucket = 0;
+        for (uint64_t bound : PROMETHEUS_BOUNDS_NANOS) {
+            while (bucket < LatencyHistogram::BUCKETS && LatencyHistogram::bucketUpperBound(bucket) <= bound) {
+                cumulative += histogram.buckets[bucket++];
+            }
+            std::format_to(std::back_inserter(out), "{}_{}_seconds_bucket{{le=\"{}\"}} {}\n",
+                name, metric, static_cast<double>(bound) / 1e9, cumulative);
+        }
+        std::format_to(std::back_inserter(out), "{}_{}_seconds_bucket{{le=\"+Inf\"}} {}\n", name, metric, histogram.count);
+        std::format_to(std::back_inserter(out), "{}_{}_seconds_sum {}\n", name, metric, static_cast<double>(histogram.sumNanos) / 1e9);
+        std::format_to(std::back_inserter(out), "{}_{}_seconds_count {}\n", name, metric, histogram.count);
+    }
+}
+
+[[nodiscard]] bool Metrics::shouldSampleLatency() noexcept {
+    thread_local uint32_t calls = 0;
+    return isEnabled() && ++calls % latencySampleRate.load(std::memory_order_relaxed) == 0;
+}
+
+[[nodiscard]] size_t Metrics::threadStripe() noexcept {
+    static std::atomic<size_t> nextStripe{ 0 };
+    thread_local const size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed);
+    return stripe;
+}
+
+void ShardedCounter::increment(uint64_t amount) noexcept {
+    if (!Metrics::isEnabled()) {
+        return;
+    }
+    mStripes[Metrics::threadStripe() % STRIPES].value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+[[nodiscard]] uint64_t ShardedCounter::load() const noexcept {
+    uint64_t total = 0;
+    for (const auto& stripe : mStripes) {
+        total += stripe.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+[[nodiscard]] size_t LatencyHistogram::bucketIndex(uint64_t nanos) noexcept {
+    if (nanos < SUB_BUCKETS) {
+        return static_cast<size_t>(nanos);
+    }
+    const size_t highestBit = std::bit_width(nanos) - 1;
+    const size_t shift = highestBit - SUB_BUCKET_BITS;
+    const size_t subBucket = static_cast<size_t>(nanos >> shift) & (SUB_BUCKETS - 1);
+    return (shift + 1) * SUB_BUCKETS + subBucket;
+}
+
+[[nodiscard]] uint64_t LatencyHistogram::bucketUpperBound(size_t index) noexcept {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    const size_t shift = index / SUB_BUCKETS - 1;
+    const uint64_t subBucket = index % SUB_BUCKETS;
+    const uint64_t lowerBound = (SUB_BUCKETS + subBucket) << shift;
+    return lowerBound + ((uint64_t{ 1 } << shift) - 1);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency) noexcept {
+    const auto nanos = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+    auto& stripe = mStripes[Metrics::threadStripe() % STRIPES];
+    stripe.buckets[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+    stripe.count.fetch_add(1, std::memory_order_relaxed);
+    stripe.sumNanos.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+[[nodiscard]] LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot result;
+    for (const auto& stripe : mStripes) {
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            result.buckets[i] += stripe.buckets[i].load(std::memory_order_relaxed);
+        }
+        result.count += stripe.count.load(std::memory_order_relaxed);
+        result.sumNanos += stripe.sumNanos.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+[[nodiscard]] uint64_t LatencyHistogram::Snapshot::percentile(double quantile) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    const auto target = static_cast<uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen > 0 && seen >= target) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BUCKETS - 1);
+}
+
+LatencyHistogram::Snapshot& LatencyHistogram::Snapshot::operator+=(const Snapshot& other) {
+    count += other.count;
+    sumNanos += other.sumNanos;
+    for (size_t i = 0; i < buckets.size() && i < other.buckets.size(); ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    return *this;
+}
+
+ScopedLatency::ScopedLatency(LatencyHistogram& histogram) noexcept
+    : mHistogram{ Metrics::shouldSampleLatency() ? &histogram : nullptr }
+{
+    if (mHistogram) {
+        mStart = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedLatency::~ScopedLatency() {
+    if (mHistogram) {
+        mHistogram->record(std::chrono::steady_clock::now() - mStart);
+    }
+}
+
+CacheMetricsSnapshot& CacheMetricsSnapshot::operator+=(const CacheMetricsSnapshot& other) {
+    hits += other.hits;
+    misses += other.misses;
+    puts += other.puts;
+    evictions += other.evictions;
+    rejections += other.rejections;
+    expirations += other.expirations;
+    invalidations += other.invalidations;
+    getLatency += other.getLatency;
+    entries += other.entries;
+    bytes += other.bytes;
+    return *this;
+}
+
+[[nodiscard]] CacheMetricsSnapshot CacheMetrics::snapshot() const {
+    return { hits.load(), misses.load(), puts.load(), evictions.load(), rejections.load(), expirations.load(), invalidations.load(),
+        getLatency.snapshot() };
+}
+
+[[nodiscard]] ServiceMetricsSnapshot ServiceMetrics::snapshot() const {
+    return { requests.load(), cacheHits.load(), cacheMisses.load(), databaseFetches.load(),
+        databaseNotFound.load(), 0, staleHits.load(), backgroundRefreshes.load(),
+        invalidations.load(), rejectedFetches.load(), requestLatency.snapshot() };
+}
+
+[[nodiscard]] std::string PrometheusExporter::format(std::string_view name, const CacheMetricsSnapshot& metrics) {
+    std::string out;
+    appendCounter(out, name, "hits", "Cache lookups that found the product.", metrics.hits);
+    appendCounter(out, name, "misses", "Cache lookups that did not find the product.", metrics.misses);
+    appendCounter(out, name, "puts", "Products inserted or replaced.", metrics.puts);
+    appendCounter(out, name, "evictions", "Products evicted to stay within capacity.", metrics.evictions);
+    appendCounter(out, name, "rejections", "Products too large to be cached.", metrics.rejections);
+    appendCounter(out, name, "expirations", "Products removed because their time to live elapsed.", metrics.expirations);
+    appendCounter(out, name, "invalidations", "Products removed because they changed in the database.", metrics.invalidations);
+    appendGauge(out, name, "entries", "Products currently cached.", metrics.entries);
+    appendGauge(out, name, "bytes", "Memory charged for the cached products.", metrics.bytes);
+    appendHistogram(out, name, "get_latency", "Latency of single-product cache lookups.", metrics.getLatency);
+    return out;
+}
+
+[[nodiscard]] std::string PrometheusExporter::format(std::string_view name, const ServiceMetricsSnapshot& metrics) {
+    std::string out;
+    appendCounter(out, name, "requests", "Product detail requests.", metrics.requests);
+    appendCounter(out, name, "cache_hits", "Requests served from the cache.", metrics.cacheHits);
+    appendCounter(out, name, "cache_misses", "Requests that missed the cache.", metrics.cacheMisses);
+    appendCounter(out, name, "db_fetches", "Database fetches issued.", metrics.databaseFetches);
+    appendCounter(out, name, "db_not_found", "Database fetches that found no product.", metrics.databaseNotFound);
+    appendCounter(out, name, "coalesced_fetches", "Misses that waited on another caller's fetch.", metrics.coalescedFetches);
+    appendCounter(out, name, "stale_hits", "Hits served past the soft time to live.", metrics.staleHits);
+    appendCounter(out, name, "background_refreshes", "Stale products refreshed from the database in the background.", metrics.backgroundRefreshes);
+    appendCounter(out, name, "invalidations", "Cached products dropped after a database change notification.", metrics.invalidations);
+    appendCounter(out, name, "rejected_fetches", "Database fetches refused because the executor was full.", metrics.rejectedFetches);
+    appendHistogram(out, name, "request_latency", "Latency of getProductDetails.", metrics.requestLatency);
+    return out;
+}
+
+void PrometheusExporter::writeToFile(const std::filesystem::path& path, std::string_view text) {
+    auto temporaryPath = path;
+    temporaryPath += ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc | std::ios::binary);
+        if (!file.is_open()) {
+            throw std::ios_base::failure("Failed to open metrics file.");
+        }
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    std::filesystem::rename(temporaryPath, path);
+}
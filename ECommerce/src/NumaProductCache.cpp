@@ -0,0 +1,199 @@
+#include "NumaProductCache.h"
+#include "Logger.h"
+
+#include <unordered_set>
+
+NumaProductCache::NumaProductCache(size_t capacityPerNode, NumaTopology topology)
+    : mTopology{ std::move(topology) }
+{
+    mReplicas.reserve(mTopology.getNodeCount());
+    for (size_t node = 0; node < mTopology.getNodeCount(); ++node) {
+        mReplicas.push_back(std::make_unique<ProductCache>(capacityPerNode));
+    }
+    LOG_INFO(LogCategory::CACHE, "NumaProductCache initialized with {} node(s) of capacity {}", mReplicas.size(), capacityPerNode);
+}
+
+[[nodiscard]] std::optional<Product> NumaProductCache::get(uint64_t productId) {
+    if (auto product = getShared(productId)) {
+        return *product;
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] std::shared_ptr<const Product> NumaProductCache::getShared(uint64_t productId) {
+    return getTimed(productId).value;
+}
+
+[[nodiscard]] TimedValue<Product> NumaProductCache::getTimed(uint64_t productId) {
+    return getTimedOnNode(mTopology.getCurrentNode(), productId);
+}
+
+[[nodiscard]] TimedValue<Product> NumaProductCache::getTimedOnNode(size_t node, uint64_t productId) {
+    if (mReplicas.size() == 1) {
+        return mReplicas[0]->getTimed(productId);
+    }
+    ScopedLatency latency(mMetrics.getLatency);
+
+    if (auto cached = mReplicas[node]->getTimed(productId); cached.value) {
+        mMetrics.hits.increment();
+        return cached;
+    }
+    if (auto product = lookupRemote(node, productId)) {
+        mMetrics.hits.increment();
+        mRemoteHits.increment();
+        return { std::move(product), CoarseClock::now() };
+    }
+    mMetrics.misses.increment();
+    return { nullptr, CoarseClock::now() };
+}
+
+[[nodiscard]] std::vector<std::shared_ptr<const Product>> NumaProductCache::getMany(std::span<const uint64_t> productIds) {
+    if (mReplicas.size() == 1) {
+        return mReplicas[0]->getMany(productIds);
+    }
+    const size_t node = mTopology.getCurrentNode();
+    auto products = mReplicas[node]->getMany(productIds);
+
+    uint64_t hits = 0;
+    uint64_t remoteHits = 0;
+    for (size_t position = 0; position < products.size(); ++position) {
+        if (!products[position]) {
+            products[position] = lookupRemote(node, productIds[position]);
+            remoteHits += products[position] ? 1 : 0;
+        }
+        hits += products[position] ? 1 : 0;
+    }
+
+    mMetrics.hits.increment(hits);
+    mMetrics.misses.increment(productIds.size() - hits);
+    mRemoteHits.increment(remoteHits);
+    return products;
+}
+
+void NumaProductCache::put(uint64_t productId, const Product& product) {
+    putShared(productId, std::make_shared<const Product>(product));
+}
+
+void NumaProductCache::put(uint64_t productId, Product&& product) {
+    putShared(productId, std::make_shared<const Product>(std::move(product)));
+}
+
+void NumaProductCache::putShared(uint64_t productId, std::shared_ptr<const Product> product) {
+    putSharedOnNode(mTopology.getCurrentNode(), productId, std::move(product));
+}
+
+void NumaProductCache::putSharedOnNode(size_t node, uint64_t productId, std::shared_ptr<const Product> product) {
+    if (mReplicas.size() == 1) {
+        mReplicas[0]->putShared(productId, std::move(product));
+        return;
+    }
+    mMetrics.puts.increment();
+
+    beginUpdate();
+    mReplicas[node]->putShared(productId, std::move(product));
+    for (size_t other = 0; other < mReplicas.size(); ++other) {
+        if (other != node) {
+            mReplicas[other]->invalidate(productId);
+        }
+    }
+    endUpdate();
+}
+
+bool NumaProductCache::invalidate(uint64_t productId) {
+    return invalidateMany(std::span<const uint64_t>(&productId, 1)) != 0;
+}
+
+size_t NumaProductCache::invalidateMany(std::span<const uint64_t> productIds) {
+    if (mReplicas.size() == 1) {
+        return mReplicas[0]->invalidateMany(productIds);
+    }
+    size_t removed = 0;
+    beginUpdate();
+    for (uint64_t productId : productIds) {
+        bool wasCached = false;
+        for (auto& replica : mReplicas) {
+            wasCached = replica->invalidate(productId) || wasCached;
+        }
+        removed += wasCached ? 1 : 0;
+    }
+    endUpdate();
+
+    mMetrics.invalidations.increment(removed);
+    return removed;
+}
+
+size_t NumaProductCache::invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) {
+    if (mReplicas.size() == 1) {
+        return mReplicas[0]->invalidateIf(predicate);
+    }
+    std::unordered_set<uint64_t> removed;
+    beginUpdate();
+    for (auto& replica : mReplicas) {
+        replica->invalidateIf([&predicate, &removed](const uint64_t& productId, const Product& product) {
+            if (predicate(productId, product)) {
+                removed.insert(productId);
+                return true;
+            }
+            return false;
+            });
+    }
+    endUpdate();
+
+    mMetrics.invalidations.increment(removed.size());
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} products matching a predicate across {} node(s).", removed.size(), mReplicas.size());
+    return removed.size();
+}
+
+[[nodiscard]] CacheMetricsSnapshot NumaProductCache::getMetrics() const {
+    if (mReplicas.size() == 1) {
+        return mReplicas[0]->getMetrics();
+    }
+    auto snapshot = mMetrics.snapshot();
+    for (const auto& replica : mReplicas) {
+        const auto replicaMetrics = replica->getMetrics();
+        snapshot.evictions += replicaMetrics.evictions;
+        snapshot.expirations += replicaMetrics.expirations;
+        snapshot.entries += replicaMetrics.entries;
+        snapshot.bytes += replicaMetrics.bytes;
+    }
+    return snapshot;
+}
+
+[[nodiscard]] CacheMetricsSnapshot NumaProductCache::getNodeMetrics(size_t node) const {
+    return mReplicas[node]->getMetrics();
+}
+
+[[nodiscard]] uint64_t NumaProductCache::getRemoteHitCount() const noexcept {
+    return mRemoteHits.load();
+}
+
+[[nodiscard]] std::shared_ptr<const Product> NumaProductCache::lookupRemote(size_t node, uint64_t productId) {
+    const uint64_t generation = mGeneration.load();
+    for (size_t other = 0; other < mReplicas.size(); ++other) {
+        if (other == node) {
+            continue;
+        }
+        if (auto remote = mReplicas[other]->getShared(productId)) {
+            // Copied on the calling thread, so the copy is allocated on its node.
+            auto local = std::make_shared<const Product>(*remote);
+            mReplicas[node]->putShared(productId, local);
+            // Read in this order: endUpdate() bumps the generation before it
+            // leaves, so an update is seen either running or finished.
+            if (mUpdatesInFlight.load() != 0 || mGeneration.load() != generation) {
+                // An update raced the copy and may have missed it: do not keep it.
+                mReplicas[node]->invalidate(productId);
+            }
+            return local;
+        }
+    }
+    return nullptr;
+}
+
+void NumaProductCache::beginUpdate() noexcept {
+    mUpdatesInFlight.fetch_add(1);
+}
+
+void NumaProductCache::endUpdate() noexcept {
+    mGeneration.fetch_add(1);
+    mUpdatesInFlight.fetch_sub(1);
+}
@@ -0,0 +1,199 @@
+#include "NumaTopology.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    std::vector<uint32_t> allCpus() {
+        std::vector<uint32_t> cpus(std::max(1u, std::thread::hardware_concurrency()));
+        for (uint32_t cpu = 0; cpu < cpus.size(); ++cpu) {
+            cpus[cpu] = cpu;
+        }
+        return cpus;
+    }
+
+    [[nodiscard]] uint32_t parseCpu(std::string_view text) {
+        uint32_t value = 0;
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (text.empty() || error != std::errc{} || end != text.data() + text.size()) {
+            throw std::invalid_argument("Malformed CPU list.");
+        }
+        return value;
+    }
+
+    // Whole file as text; throws std::runtime_error if it cannot be read.
+    [[nodiscard]] std::string readFile(const std::filesystem::path& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Failed to open " + path.string());
+        }
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+}
+
+NumaTopology::NumaTopology(std::vector<std::vector<uint32_t>> cpusByNode) {
+    for (auto& cpus : cpusByNode) {
+        if (!cpus.empty()) {
+            std::ranges::sort(cpus);
+            mCpusByNode.push_back(std::move(cpus));
+        }
+    }
+    if (mCpusByNode.empty()) {
+        mCpusByNode.push_back(allCpus());
+    }
+
+    uint32_t highestCpu = 0;
+    for (const auto& cpus : mCpusByNode) {
+        highestCpu = std::max(highestCpu, cpus.back());
+    }
+    mNodeOfCpu.assign(static_cast<size_t>(highestCpu) + 1, 0);
+    for (uint32_t node = 0; node < mCpusByNode.size(); ++node) {
+        for (uint32_t cpu : mCpusByNode[node]) {
+            mNodeOfCpu[cpu] = node;
+        }
+    }
+}
+
+[[nodiscard]] NumaTopology NumaTopology::singleNode() {
+    return NumaTopology({ allCpus() });
+}
+
+[[nodiscard]] std::vector<uint32_t> NumaTopology::parseCpuList(std::string_view list) {
+    std::vector<uint32_t> cpus;
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) {
+        list.remove_suffix(1);
+    }
+
+    while (!list.empty()) {
+        const size_t comma = list.find(',');
+        const std::string_view range = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        const size_t dash = range.find('-');
+        const uint32_t first = parseCpu(range.substr(0, dash));
+        const uint32_t last = dash == std::string_view::npos ? first : parseCpu(range.substr(dash + 1));
+        if (last < first) {
+            throw std::invalid_argument("Malformed CPU list.");
+        }
+        for (uint32_t cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+[[nodiscard]] NumaTopology NumaTopology::fromSysfs(const std::filesystem::path& nodeDirectory) {
+    try {
+        std::vector<std::vector<uint32_t>> cpusByNode;
+        for (uint32_t node : parseCpuList(readFile(nodeDirectory / "online"))) {
+            cpusByNode.push_back(parseCpuList(readFile(nodeDirectory / ("node" + std::to_string(node)) / "cpulist")));
+        }
+        NumaTopology topology(std::move(cpusByNode));
+        LOG_INFO(LogCategory::GENERAL, "Read {} NUMA node(s) from {}", topology.getNodeCount(), nodeDirectory.string());
+        return topology;
+    }
+    catch (const std::exception& e) {
+        LOG_WARNING(LogCategory::GENERAL, "Could not read the NUMA topology from {}: {}. Assuming one node.", nodeDirectory.string(), e.what());
+        return singleNode();
+    }
+}
+
+#ifdef _WIN32
+
+[[nodiscard]] NumaTopology NumaTopology::detect() {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) {
+        LOG_WARNING(LogCategory::GENERAL, "Could not read the NUMA topology. Assuming one node.");
+        return singleNode();
+    }
+
+    std::vector<std::vector<uint32_t>> cpusByNode(static_cast<size_t>(highestNode) + 1);
+    for (ULONG node = 0; node <= highestNode; ++node) {
+        GROUP_AFFINITY affinity{};
+        if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(node), &affinity)) {
+            continue;
+        }
+        // CPUs are numbered across processor groups of 64.
+        for (uint32_t bit = 0; bit < 64; ++bit) {
+            if (affinity.Mask & (KAFFINITY{ 1 } << bit)) {
+                cpusByNode[node].push_back(static_cast<uint32_t>(affinity.Group) * 64 + bit);
+            }
+        }
+    }
+    NumaTopology topology(std::move(cpusByNode));
+    LOG_INFO(LogCategory::GENERAL, "Detected {} NUMA node(s).", topology.getNodeCount());
+    return topology;
+}
+
+[[nodiscard]] uint32_t NumaTopology::getCurrentCpu() noexcept {
+    PROCESSOR_NUMBER processor{};
+    GetCurrentProcessorNumberEx(&processor);
+    return static_cast<uint32_t>(processor.Group) * 64 + processor.Number;
+}
+
+bool NumaTopology::pinCurrentThread(std::span<const uint32_t> cpus) noexcept {
+    if (cpus.empty()) {
+        return false;
+    }
+    GROUP_AFFINITY affinity{};
+    affinity.Group = static_cast<WORD>(cpus.front() / 64);
+    for (uint32_t cpu : cpus) {
+        if (cpu / 64 == affinity.Group) {
+            affinity.Mask |= KAFFINITY{ 1 } << (cpu % 64);
+        }
+    }
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+}
+
+#else
+
+[[nodiscard]] NumaTopology NumaTopology::detect() {
+    return fromSysfs("/sys/devices/system/node");
+}
+
+[[nodiscard]] uint32_t NumaTopology::getCurrentCpu() noexcept {
+    const int cpu = ::sched_getcpu();
+    return cpu < 0 ? 0 : static_cast<uint32_t>(cpu);
+}
+
+bool NumaTopology::pinCurrentThread(std::span<const uint32_t> cpus) noexcept {
+    cpu_set_t affinity;
+    CPU_ZERO(&affinity);
+    for (uint32_t cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &affinity);
+        }
+    }
+    if (CPU_COUNT(&affinity) == 0) {
+        return false;
+    }
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(affinity), &affinity) == 0;
+}
+
+#endif
+
+[[nodiscard]] size_t NumaTopology::getNodeOfCpu(uint32_t cpu) const noexcept {
+    return cpu < mNodeOfCpu.size() ? mNodeOfCpu[cpu] : 0;
+}
+
+[[nodiscard]] size_t NumaTopology::getCurrentNode() const noexcept {
+    if (mCpusByNode.size() == 1) {
+        return 0;
+    }
+    return getNodeOfCpu(getCurrentCpu());
+}
@@ -1,15 +1,145 @@
 #include "Product.h"
+#include "ProductArena.h"
 
-Product::Product(uint64_t id, uint32_t category, std::string_view name, std::string_view description, const std::vector<std::byte>& thumbnail)
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+    uint32_t fieldLength(size_t size) {
+        if (size > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Product field exceeds 4 GiB.");
+        }
+        return static_cast<uint32_t>(size);
+    }
+
+    void copyBytes(std::byte* destination, const void* source, size_t size) noexcept {
+        if (size != 0) {
+            std::memcpy(destination, source, size);
+        }
+    }
+}
+
+Product::Product(uint64_t id, uint32_t category, std::string_view name, std::string_view description, std::span<const std::byte> thumbnail)
+    : mID{ id }
+    , mCategory{ category } {
+    assign(name, description, thumbnail, nullptr);
+}
+
+Product::Product(uint64_t id, uint32_t category, std::string_view name, std::string_view description, std::span<const std::byte> thumbnail, ProductArena& arena)
     : mID{ id }
-    , mCategory{ category }
-    , mName{ name }
-    , mDescription{ description }
-    , mThumbnail{ thumbnail } {
+    , mCategory{ category } {
+    assign(name, description, thumbnail, &arena);
+}
+
+Product::Product(const Product& other)
+    : mID{ other.mID }
+    , mCategory{ other.mCategory } {
+    assign(other.getName(), other.getDescription(), other.getThumbnailBytes(), nullptr);
+}
+
+Product::Product(Product&& other) noexcept
+    : mID{ other.mID }
+    , mCategory{ other.mCategory }
+    , mNameLength{ other.mNameLength }
+    , mDescriptionLength{ other.mDescriptionLength }
+    , mThumbnailLength{ other.mThumbnailLength }
+    , mStorage{ other.mStorage }
+    , mExternal{ other.mExternal } {
+    if (mStorage == Storage::INLINE) {
+        copyBytes(mInline.data(), other.mInline.data(), blobSize());
+    }
+    other.mNameLength = other.mDescriptionLength = other.mThumbnailLength = 0;
+    other.mStorage = Storage::INLINE;
+    other.mExternal = nullptr;
+}
+
+Product& Product::operator=(const Product& other) {
+    if (this != &other) {
+        *this = Product(other);
+    }
+    return *this;
+}
+
+Product& Product::operator=(Product&& other) noexcept {
+    if (this != &other) {
+        std::destroy_at(this);
+        std::construct_at(this, std::move(other));
+    }
+    return *this;
+}
+
+Product::~Product() {
+    release();
 }
 
 [[nodiscard]] uint64_t Product::getId() const noexcept { return mID; }
 [[nodiscard]] uint32_t Product::getCategory() const noexcept { return mCategory; }
-[[nodiscard]] std::string_view Product::getName() const noexcept { return mName; }
-[[nodiscard]] std::string_view Product::getDescription() const noexcept { return mDescription; }
-[[nodiscard]] std::vector<std::byte> Product::getThumbnail() const noexcept { return mThumbnail; }
+
+[[nodiscard]] std::string_view Product::getName() const noexcept {
+    return { reinterpret_cast<const char*>(blob()), mNameLength };
+}
+
+[[nodiscard]] std::string_view Product::getDescription() const noexcept {
+    return { reinterpret_cast<const char*>(blob()) + mNameLength, mDescriptionLength };
+}
+
+[[nodiscard]] std::vector<std::byte> Product::getThumbnail() const noexcept {
+    const auto thumbnail = getThumbnailBytes();
+    return { thumbnail.begin(), thumbnail.end() };
+}
+
+[[nodiscard]] size_t Product::getMemoryFootprint() const noexcept {
+    return sizeof(Product) + (mStorage == Storage::INLINE ? 0 : blobSize());
+}
+
+bool Product::operator==(const Product& other) const noexcept {
+    return mID == other.mID && mCategory == other.mCategory
+        && getName() == other.getName() && getDescription() == other.getDescription()
+        && std::ranges::equal(getThumbnailBytes(), other.getThumbnailBytes());
+}
+
+void Product::assign(std::string_view name, std::string_view description, std::span<const std::byte> thumbnail, ProductArena* arena) {
+    const uint32_t nameLength = fieldLength(name.size());
+    const uint32_t descriptionLength = fieldLength(description.size());
+    const uint32_t thumbnailLength = fieldLength(thumbnail.size());
+    const size_t size = size_t{ nameLength } + descriptionLength + thumbnailLength;
+
+    std::byte* destination = mInline.data();
+    Storage storage = Storage::INLINE;
+    if (size > INLINE_CAPACITY) {
+        destination = arena ? arena->allocate(size) : new std::byte[size];
+        storage = arena ? Storage::ARENA : Storage::HEAP;
+    }
+
+    copyBytes(destination, name.data(), nameLength);
+    copyBytes(destination + nameLength, description.data(), descriptionLength);
+    copyBytes(destination + nameLength + descriptionLength, thumbnail.data(), thumbnailLength);
+
+    mNameLength = nameLength;
+    mDescriptionLength = descriptionLength;
+    mThumbnailLength = thumbnailLength;
+    mStorage = storage;
+    mExternal = storage == Storage::INLINE ? nullptr : destination;
+}
+
+void Product::release() noexcept {
+    if (mStorage == Storage::HEAP) {
+        delete[] mExternal;
+    }
+    mExternal = nullptr;
+}
+
+[[nodiscard]] const std::byte* Product::blob() const noexcept {
+    return mStorage == Storage::INLINE ? mInline.data() : mExternal;
+}
+
+[[nodiscard]] size_t Product::blobSize() const noexcept {
+    return size_t{ mNameLength } + mDescriptionLength + mThumbnailLength;
+}
+
+[[nodiscard]] std::span<const std::byte> Product::getThumbnailBytes() const noexcept {
+    return { blob() + mNameLength + mDescriptionLength, mThumbnailLength };
+}
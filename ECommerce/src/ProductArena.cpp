@@ -0,0 +1,29 @@
+#include "ProductArena.h"
+
+#include <algorithm>
+
+ProductArena::ProductArena(size_t chunkSize)
+    : mChunkSize{ std::max<size_t>(chunkSize, 1) }
+{
+}
+
+[[nodiscard]] std::byte* ProductArena::allocate(size_t size) {
+    mBytesUsed += size;
+
+    // Large blobs get a chunk of their own so they do not strand the rest of the current one.
+    if (size > mChunkSize / 4) {
+        mChunks.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+        return mChunks.back().get();
+    }
+
+    if (size > mRemaining) {
+        mChunks.push_back(std::make_unique_for_overwrite<std::byte[]>(mChunkSize));
+        mCursor = mChunks.back().get();
+        mRemaining = mChunkSize;
+    }
+
+    std::byte* blob = mCursor;
+    mCursor += size;
+    mRemaining -= size;
+    return blob;
+}
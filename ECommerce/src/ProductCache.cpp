@@ -1,49 +1,185 @@
 #include "ProductCache.h"
+#include "ProductSnapshot.h"
 #include <stdexcept>
 #include <string>
 
-ProductCache::ProductCache(size_t capacity) 
-    : mCapacity{ capacity } 
-{
-    if (mCapacity == 0) {
-        Logger::log(LogLevel::ERROR, LogCategory::CACHE, "ProductCache initialized with zero capacity.");
-        throw std::invalid_argument("Cache capacity must be greater than zero.");
+namespace {
+    // make_shared places the reference counts next to the product.
+    constexpr size_t CONTROL_BLOCK_OVERHEAD = 2 * sizeof(long);
+
+    LruLimits capacityLimits(size_t capacity) {
+        if (capacity == 0) {
+            LOG_ERROR(LogCategory::CACHE, "ProductCache initialized with zero capacity.");
+            throw std::invalid_argument("Cache capacity must be greater than zero.");
+        }
+        return LruLimits{ .maxEntries = capacity };
+    }
+
+    LruLimits budgetLimits(const CacheMemoryBudget& budget) {
+        if (budget.maxBytes == 0) {
+            LOG_ERROR(LogCategory::CACHE, "ProductCache initialized with zero memory budget.");
+            throw std::invalid_argument("Cache memory budget must be greater than zero.");
+        }
+        return LruLimits{ .maxWeight = budget.maxBytes, .maxEntryWeight = budget.maxEntryBytes };
     }
-    Logger::log(LogLevel::INFO, LogCategory::CACHE, "ProductCache initialized with capacity: " + std::to_string(mCapacity));
+}
+
+[[nodiscard]] size_t ProductCharge::operator()(uint64_t, const std::shared_ptr<const Product>& product) const noexcept {
+    return ProductCache::entryCharge(*product);
+}
+
+ProductCache::ProductCache(size_t capacity)
+    : mEntries{ capacityLimits(capacity) }
+{
+    setEvictionListener(nullptr);
+    LOG_INFO(LogCategory::CACHE, "ProductCache initialized with capacity: {}", capacity);
+}
+
+ProductCache::ProductCache(const CacheMemoryBudget& budget)
+    : mEntries{ budgetLimits(budget) }
+{
+    setEvictionListener(nullptr);
+    LOG_INFO(LogCategory::CACHE, "ProductCache initialized with memory budget: {} bytes (max entry {} bytes)",
+        mEntries.getLimits().maxWeight, mEntries.getLimits().maxEntryWeight);
 }
 
 [[nodiscard]] std::optional<Product> ProductCache::get(uint64_t productId) {
-    std::shared_lock lock(mCacheMutex);
+    if (auto product = getShared(productId)) {
+        return *product;
+    }
+    return std::nullopt;
+}
 
-    Logger::log(LogLevel::INFO, LogCategory::CACHE, "Getting Product ID: " + std::to_string(productId));
+[[nodiscard]] std::shared_ptr<const Product> ProductCache::getShared(uint64_t productId) {
+    return getTimed(productId).value;
+}
 
-    if (auto it = mCacheMap.find(productId); it != mCacheMap.end()) {
-        mCacheList.splice(mCacheList.begin(), mCacheList, it->second);
-        Logger::log(LogLevel::INFO, LogCategory::CACHE, "Product ID: " + std::to_string(productId) + " found.");
-        return it->second->second;
+[[nodiscard]] TimedValue<Product> ProductCache::getTimed(uint64_t productId) {
+    return getTimed(Prehashed<uint64_t>(productId));
+}
+
+[[nodiscard]] TimedValue<Product> ProductCache::getTimed(const Prehashed<uint64_t>& productId) {
+    LOG_INFO(LogCategory::CACHE, "Getting Product ID: {}", productId.key);
+
+    if (auto entry = mEntries.getTimed(productId)) {
+        LOG_INFO(LogCategory::CACHE, "Product ID: {} found.", productId.key);
+        return { std::move(entry->first), entry->second };
     }
 
-    Logger::log(LogLevel::INFO, LogCategory::CACHE, "Product ID: " + std::to_string(productId) + " not found.");
-    return std::nullopt;
+    LOG_INFO(LogCategory::CACHE, "Product ID: {} not found.", productId.key);
+    return { nullptr, CoarseClock::now() };
+}
+
+[[nodiscard]] std::vector<std::shared_ptr<const Product>> ProductCache::getMany(std::span<const uint64_t> productIds) {
+    std::vector<std::shared_ptr<const Product>> products(productIds.size());
+    const size_t hits = mEntries.getMany(productIds, [&products](size_t position, const std::shared_ptr<const Product>* product) {
+        if (product) {
+            products[position] = *product;
+        }
+        });
+
+    LOG_INFO(LogCategory::CACHE, "Batch get of {} products: {} found.", productIds.size(), hits);
+    return products;
 }
 
 void ProductCache::put(uint64_t productId, const Product& product) {
-    std::unique_lock lock(mCacheMutex);
+    putShared(productId, std::make_shared<const Product>(product));
+}
+
+void ProductCache::put(uint64_t productId, Product&& product) {
+    putShared(productId, std::make_shared<const Product>(std::move(product)));
+}
 
-    Logger::log(LogLevel::INFO, LogCategory::CACHE, "Putting Product ID: " + std::to_string(productId));
+void ProductCache::putShared(uint64_t productId, std::shared_ptr<const Product> product) {
+    putShared(productId, std::move(product), mTimeToLive.load(std::memory_order_relaxed));
+}
+
+void ProductCache::putShared(uint64_t productId, std::shared_ptr<const Product> product, std::chrono::milliseconds ttl) {
+    LOG_INFO(LogCategory::CACHE, "Putting Product ID: {}", productId);
+    const size_t charge = entryCharge(*product);
 
-    if (auto it = mCacheMap.find(productId); it != mCacheMap.end()) {
-        mCacheList.erase(it->second);
-        mCacheMap.erase(it);
+    // An oversized product is dropped rather than flushing the cache to make room;
+    // any older copy is removed as well so it is not served stale.
+    if (!mEntries.put(productId, std::move(product), ttl)) {
+        LOG_WARNING(LogCategory::CACHE, "Rejecting Product ID: {} ({} bytes exceeds the {} byte entry limit)",
+            productId, charge, mEntries.getLimits().maxEntryWeight);
     }
+}
 
-    mCacheList.emplace_front(productId, product);
-    mCacheMap[productId] = mCacheList.begin();
+bool ProductCache::invalidate(uint64_t productId) {
+    return invalidateMany(std::span<const uint64_t>(&productId, 1)) != 0;
+}
 
-    if (mCacheMap.size() > mCapacity) {
-        const auto& [oldId, _] = mCacheList.back();
-        Logger::log(LogLevel::WARNING, LogCategory::CACHE, "Evicting Product ID: " + std::to_string(oldId));
-        mCacheMap.erase(oldId);
-        mCacheList.pop_back();
+size_t ProductCache::invalidateMany(std::span<const uint64_t> productIds) {
+    const size_t removed = mEntries.invalidateMany(productIds);
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} of {} products.", removed, productIds.size());
+    return removed;
+}
+
+size_t ProductCache::invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) {
+    const size_t removed = mEntries.invalidateIf([&predicate](const uint64_t& productId, const std::shared_ptr<const Product>& product) {
+        return predicate(productId, *product);
+        });
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} products matching a predicate.", removed);
+    return removed;
+}
+
+size_t ProductCache::saveSnapshot(const std::filesystem::path& path) const {
+    std::vector<std::shared_ptr<const Product>> products;
+    products.reserve(getSize());
+    mEntries.forEach([&products](uint64_t, const std::shared_ptr<const Product>& product) {
+        products.push_back(product);
+        });
+
+    ProductSnapshot::write(path, products);
+    return products.size();
+}
+
+size_t ProductCache::loadSnapshot(const std::filesystem::path& path, size_t threadCount) {
+    const size_t capacity = mEntries.getLimits().maxEntries;
+    if (getSize() >= capacity) {
+        LOG_WARNING(LogCategory::CACHE, "Cache is full; snapshot {} not loaded.", path.string());
+        return 0;
     }
+
+    // Up to a full cache's worth, since some of them may be cached already.
+    const auto products = ProductSnapshot::read(path, capacity, threadCount);
+
+    // Appending at the cold end leaves products cached meanwhile, which are
+    // fresher than the snapshot, at the front; nothing is evicted to make room.
+    const size_t loaded = mEntries.appendCold(products,
+        [](const std::shared_ptr<const Product>& product) { return product->getId(); },
+        mTimeToLive.load(std::memory_order_relaxed));
+
+    LOG_INFO(LogCategory::CACHE, "Loaded {} products from snapshot {}.", loaded, path.string());
+    return loaded;
+}
+
+void ProductCache::setTimeToLive(std::chrono::milliseconds ttl) noexcept {
+    mTimeToLive.store(ttl, std::memory_order_relaxed);
+}
+
+void ProductCache::setEvictionListener(EvictionListener listener) {
+    mEntries.setEvictionListener([listener = std::move(listener)](const uint64_t& productId, const std::shared_ptr<const Product>& product) {
+        LOG_WARNING(LogCategory::CACHE, "Evicting Product ID: {}", productId);
+        if (listener) {
+            listener(productId, product);
+        }
+        });
+}
+
+[[nodiscard]] size_t ProductCache::getSize() const {
+    return mEntries.getSize();
+}
+
+[[nodiscard]] size_t ProductCache::getMemoryUsage() const {
+    return mEntries.getWeight();
+}
+
+[[nodiscard]] CacheMetricsSnapshot ProductCache::getMetrics() const {
+    return mEntries.getMetrics();
+}
+
+[[nodiscard]] size_t ProductCache::entryCharge(const Product& product) noexcept {
+    return product.getMemoryFootprint() + CONTROL_BLOCK_OVERHEAD + Entries::ENTRY_OVERHEAD;
 }
@@ -0,0 +1,295 @@
+#include "ProductLogStore.h"
+#include "ProductSnapshot.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <format>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+ProductLogStore::ProductLogStore(const LogStoreOptions& options)
+    : mOptions{ options }
+    , mFileTag{ std::random_device{}() }
+{
+    if (mOptions.segmentBytes == 0 || mOptions.maxBytes < mOptions.segmentBytes) {
+        LOG_ERROR(LogCategory::CACHE, "ProductLogStore initialized with segment size {} and limit {}.",
+            mOptions.segmentBytes, mOptions.maxBytes);
+        throw std::invalid_argument("Log store limit must hold at least one non-empty segment.");
+    }
+
+    std::unique_lock lock(mMutex);
+    openSegment();
+    LOG_INFO(LogCategory::CACHE, "ProductLogStore initialized in {} with {} byte segments, {} bytes at most.",
+        mOptions.directory.string(), mOptions.segmentBytes, mOptions.maxBytes);
+}
+
+[[nodiscard]] std::shared_ptr<const Product> ProductLogStore::get(uint64_t productId) {
+    ScopedLatency latency(mMetrics.getLatency);
+    std::shared_ptr<Segment> segment;
+    Location location{};
+    {
+        std::shared_lock lock(mMutex);
+        const auto it = mIndex.find(productId);
+        if (it == mIndex.end()) {
+            mMetrics.misses.increment();
+            return nullptr;
+        }
+        location = it->second;
+        segment = mSegments.at(location.segmentId);
+    }
+
+    mMetrics.hits.increment();
+    return read(*segment, location);
+}
+
+[[nodiscard]] bool ProductLogStore::contains(uint64_t productId) const {
+    std::shared_lock lock(mMutex);
+    return mIndex.contains(productId);
+}
+
+void ProductLogStore::append(std::span<const std::shared_ptr<const Product>> products,
+    const std::function<bool(const std::shared_ptr<const Product>&)>& shouldIndex) {
+    if (products.empty()) {
+        return;
+    }
+
+    std::vector<std::byte> records;
+    RecordList recordList;
+    recordList.reserve(products.size());
+    for (const auto& product : products) {
+        const uint64_t start = records.size();
+        ProductSnapshot::encodeRecord(*product, records);
+        recordList.emplace_back(product->getId(), Location{ 0, static_cast<uint32_t>(records.size() - start), start });
+    }
+
+    uint64_t offset = 0;
+    const auto segment = write(records, offset);
+
+    std::unique_lock lock(mMutex);
+    --segment->pendingWrites;
+    // A segment dropped while the write was in flight takes its records with it.
+    if (mSegments.contains(segment->id)) {
+        for (size_t i = 0; i < recordList.size(); ++i) {
+            if (shouldIndex && !shouldIndex(products[i])) {
+                continue;
+            }
+            auto& [productId, location] = recordList[i];
+            location.segmentId = segment->id;
+            location.offset += offset;
+            index(productId, location, *segment);
+        }
+    }
+    mMetrics.puts.increment(products.size());
+    dropOldestSegments();
+}
+
+bool ProductLogStore::erase(uint64_t productId) {
+    std::unique_lock lock(mMutex);
+    const auto it = mIndex.find(productId);
+    if (it == mIndex.end()) {
+        return false;
+    }
+    unindex(it);
+    mMetrics.invalidations.increment();
+    return true;
+}
+
+size_t ProductLogStore::eraseIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) {
+    std::vector<std::pair<std::shared_ptr<Segment>, std::pair<uint64_t, Location>>> stored;
+    {
+        std::shared_lock lock(mMutex);
+        stored.reserve(mIndex.size());
+        for (const auto& [productId, location] : mIndex) {
+            stored.emplace_back(mSegments.at(location.segmentId), std::pair{ productId, location });
+        }
+    }
+
+    RecordList matching;
+    for (const auto& [segment, record] : stored) {
+        if (predicate(record.first, *read(*segment, record.second))) {
+            matching.push_back(record);
+        }
+    }
+
+    size_t removed = 0;
+    std::unique_lock lock(mMutex);
+    for (const auto& [productId, location] : matching) {
+        // Skip products replaced since they were read.
+        const auto it = mIndex.find(productId);
+        if (it != mIndex.end() && it->second.segmentId == location.segmentId && it->second.offset == location.offset) {
+            unindex(it);
+            ++removed;
+        }
+    }
+    mMetrics.invalidations.increment(removed);
+    return removed;
+}
+
+size_t ProductLogStore::compact() {
+    size_t compacted = 0;
+    for (;;) {
+        std::shared_ptr<Segment> victim;
+        RecordList live;
+        {
+            std::shared_lock lock(mMutex);
+            const auto active = std::prev(mSegments.end());
+            const auto it = std::find_if(mSegments.begin(), active, [this](const auto& entry) {
+                const Segment& segment = *entry.second;
+                return segment.pendingWrites == 0
+                    && static_cast<double>(segment.liveBytes) < mOptions.compactionThreshold * static_cast<double>(segment.size);
+                });
+            if (it == active) {
+                break;
+            }
+
+            victim = it->second;
+            for (uint64_t productId : victim->productIds) {
+                const auto location = mIndex.find(productId);
+                if (location != mIndex.end() && location->second.segmentId == victim->id) {
+                    live.emplace_back(productId, location->second);
+                }
+            }
+        }
+
+        // A product appended to the segment twice is listed twice but indexed once.
+        std::ranges::sort(live, {}, [](const auto& record) { return record.second.offset; });
+        const auto duplicates = std::ranges::unique(live, {}, [](const auto& record) { return record.second.offset; });
+        live.erase(duplicates.begin(), duplicates.end());
+
+        std::vector<std::byte> records;
+        for (const auto& [productId, location] : live) {
+            const size_t start = records.size();
+            records.resize(start + location.size);
+            victim->file.read(location.offset, std::span(records).subspan(start));
+        }
+
+        uint64_t offset = 0;
+        const auto segment = records.empty() ? nullptr : write(records, offset);
+
+        std::unique_lock lock(mMutex);
+        uint64_t moved = 0;
+        if (segment) {
+            --segment->pendingWrites;
+        }
+        if (mSegments.contains(victim->id)) {
+            for (const auto& [productId, location] : live) {
+                // Records replaced or erased during the copy stay dead.
+                const auto it = mIndex.find(productId);
+                const bool current = it != mIndex.end()
+                    && it->second.segmentId == location.segmentId && it->second.offset == location.offset;
+                if (current && segment && mSegments.contains(segment->id)) {
+                    unindex(it);
+                    index(productId, Location{ segment->id, location.size, offset + moved }, *segment);
+                }
+                moved += location.size;
+            }
+            for (uint64_t productId : victim->productIds) {
+                if (const auto it = mIndex.find(productId); it != mIndex.end() && it->second.segmentId == victim->id) {
+                    unindex(it);
+                }
+            }
+            mDiskBytes -= victim->size;
+            mSegments.erase(victim->id);
+        }
+        dropOldestSegments();
+
+        ++compacted;
+        mCompactions.fetch_add(1, std::memory_order_relaxed);
+        LOG_INFO(LogCategory::CACHE, "Compacted log segment {}: {} live products moved.", victim->id, live.size());
+    }
+    return compacted;
+}
+
+[[nodiscard]] size_t ProductLogStore::getSize() const {
+    std::shared_lock lock(mMutex);
+    return mIndex.size();
+}
+
+[[nodiscard]] uint64_t ProductLogStore::getDiskBytes() const {
+    std::shared_lock lock(mMutex);
+    return mDiskBytes;
+}
+
+[[nodiscard]] CacheMetricsSnapshot ProductLogStore::getMetrics() const {
+    auto snapshot = mMetrics.snapshot();
+    std::shared_lock lock(mMutex);
+    snapshot.entries = mIndex.size();
+    snapshot.bytes = mLiveBytes;
+    return snapshot;
+}
+
+[[nodiscard]] std::shared_ptr<ProductLogStore::Segment> ProductLogStore::write(std::span<const std::byte> bytes, uint64_t& offset) {
+    std::shared_ptr<Segment> segment;
+    {
+        std::unique_lock lock(mMutex);
+        if (mSegments.rbegin()->second->size > 0 && mSegments.rbegin()->second->size + bytes.size() > mOptions.segmentBytes) {
+            openSegment();
+        }
+        segment = mSegments.rbegin()->second;
+        offset = segment->size;
+        segment->size += bytes.size();
+        ++segment->pendingWrites;
+        mDiskBytes += bytes.size();
+    }
+
+    try {
+        segment->file.write(offset, bytes);
+    }
+    catch (const std::exception& e) {
+        std::unique_lock lock(mMutex);
+        --segment->pendingWrites;
+        LOG_ERROR(LogCategory::CACHE, "Failed to append {} bytes to log segment {}: {}", bytes.size(), segment->id, e.what());
+        throw;
+    }
+    return segment;
+}
+
+void ProductLogStore::openSegment() {
+    const uint32_t segmentId = mNextSegmentId++;
+    const auto path = mOptions.directory / std::format("ProductLogStore_{:016x}_{}.log", mFileTag, segmentId);
+    mSegments.emplace(segmentId, std::make_shared<Segment>(segmentId, path));
+    LOG_INFO(LogCategory::CACHE, "Opened log segment {}.", segmentId);
+}
+
+void ProductLogStore::index(uint64_t productId, const Location& location, Segment& segment) {
+    if (const auto it = mIndex.find(productId); it != mIndex.end()) {
+        unindex(it);
+    }
+    mIndex.emplace(productId, location);
+    segment.liveBytes += location.size;
+    segment.productIds.push_back(productId);
+    mLiveBytes += location.size;
+}
+
+void ProductLogStore::unindex(std::unordered_map<uint64_t, Location>::iterator it) {
+    if (const auto segment = mSegments.find(it->second.segmentId); segment != mSegments.end()) {
+        segment->second->liveBytes -= it->second.size;
+    }
+    mLiveBytes -= it->second.size;
+    mIndex.erase(it);
+}
+
+void ProductLogStore::dropOldestSegments() {
+    while (mDiskBytes > mOptions.maxBytes && mSegments.size() > 1) {
+        const auto oldest = mSegments.begin()->second;
+        size_t dropped = 0;
+        for (uint64_t productId : oldest->productIds) {
+            if (const auto it = mIndex.find(productId); it != mIndex.end() && it->second.segmentId == oldest->id) {
+                unindex(it);
+                ++dropped;
+            }
+        }
+        mDiskBytes -= oldest->size;
+        mSegments.erase(mSegments.begin());
+        mMetrics.evictions.increment(dropped);
+        LOG_WARNING(LogCategory::CACHE, "Dropped log segment {} with {} products.", oldest->id, dropped);
+    }
+}
+
+[[nodiscard]] std::shared_ptr<const Product> ProductLogStore::read(const Segment& segment, const Location& location) const {
+    std::vector<std::byte> record(location.size);
+    segment.file.read(location.offset, record);
+    return std::make_shared<const Product>(ProductSnapshot::decodeRecord(record));
+}
@@ -1,53 +1,505 @@
 #include "ProductService.h"
 #include "Logger.h"
-#include <shared_mutex>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
 
-ProductService::ProductService(std::shared_ptr<ICache<uint64_t, Product>> cache, std::shared_ptr<IDatabase> database)
+ProductService::ProductService(std::shared_ptr<ICache<uint64_t, Product>> cache, std::shared_ptr<IDatabase> database,
+	const ExecutorOptions& executorOptions)
 	: mCache(std::move(cache))
 	, mDatabase(std::move(database))
 {
 	if (!this->mCache || !this->mDatabase) {
-		Logger::log(LogLevel::ERROR, LogCategory::SERVICE, "ProductService initialization failed: Null cache or database provided.");
+		LOG_ERROR(LogCategory::SERVICE, "ProductService initialization failed: Null cache or database provided.");
 		throw std::invalid_argument("Cache and database must not be null.");
 	}
-	Logger::log(LogLevel::INFO, LogCategory::SERVICE, "ProductService initialized successfully.");
+	mExecutor = std::make_unique<TaskExecutor>(executorOptions);
+	mSubscriptionId = mDatabase->subscribe([this](std::span<const ProductChange> changes) { onDatabaseChanges(changes); });
+	LOG_INFO(LogCategory::SERVICE, "ProductService initialized successfully.");
+}
+
+ProductService::~ProductService() {
+	mDatabase->unsubscribe(mSubscriptionId);
 }
 
 std::optional<Product> ProductService::getProductDetails(uint64_t productId) const {
-	Logger::log(LogLevel::INFO, LogCategory::SERVICE,
-		"Fetching product details for Product ID: " + std::to_string(productId));
+	if (auto product = getProductDetailsShared(productId)) {
+		return *product;
+	}
+	return std::nullopt;
+}
+
+std::shared_ptr<const Product> ProductService::getProductDetailsShared(uint64_t productId) const {
+	ScopedLatency latency(mMetrics.requestLatency);
+	mMetrics.requests.increment();
+	LOG_INFO(LogCategory::SERVICE, "Fetching product details for Product ID: {}", productId);
+
+	const Prehashed<uint64_t> key(productId);
+	if (auto cachedProduct = lookupCached(key)) {
+		return cachedProduct;
+	}
+	// Rethrows the fetch's exception, if any
+	return fetchMiss(key).get();
+}
+
+std::shared_future<std::shared_ptr<const Product>> ProductService::getProductDetailsAsync(uint64_t productId) const {
+	mMetrics.requests.increment();
+	LOG_INFO(LogCategory::SERVICE, "Fetching product details asynchronously for Product ID: {}", productId);
+
+	const Prehashed<uint64_t> key(productId);
+	if (auto cachedProduct = lookupCached(key)) {
+		std::promise<std::shared_ptr<const Product>> ready;
+		ready.set_value(std::move(cachedProduct));
+		return ready.get_future().share();
+	}
+	return fetchMiss(key);
+}
+
+std::vector<std::shared_ptr<const Product>> ProductService::getMany(std::span<const uint64_t> productIds) const {
+	LOG_INFO(LogCategory::SERVICE, "Fetching product details for a batch of {} products", productIds.size());
+	mMetrics.requests.increment(productIds.size());
+
+	std::vector<std::shared_ptr<const Product>> products = mCache->getMany(productIds);
+
+	// Each missing ID is fetched once, even if the batch repeats it
+	std::unordered_map<uint64_t, std::vector<size_t>> missPositions;
+	std::vector<uint64_t> missingIds;
+	size_t missCount = 0;
+	for (size_t position = 0; position < products.size(); ++position) {
+		if (!products[position]) {
+			++missCount;
+			auto& positions = missPositions[productIds[position]];
+			if (positions.empty()) {
+				missingIds.push_back(productIds[position]);
+			}
+			positions.push_back(position);
+		}
+	}
+
+	mMetrics.cacheHits.increment(products.size() - missCount);
+	mMetrics.cacheMisses.increment(missCount);
+
+	if (missingIds.empty()) {
+		LOG_INFO(LogCategory::SERVICE, "All products of the batch found in cache.");
+		return products;
+	}
+
+	LOG_INFO(LogCategory::SERVICE, "{} products of the batch not found in cache. Fetching from database.", missingIds.size());
 
-	// Shared lock for reading from the cache
+	// Misses another caller is already fetching are joined, like in fetchMiss();
+	// the rest are registered in the in-flight table and fetched in one batch.
+	std::vector<uint64_t> batchIds;
+	std::vector<PendingFetch> batchFetches;
+	std::vector<std::pair<uint64_t, PendingFetch>> joinedFetches;
+	auto fetchPromises = std::make_shared<std::vector<std::promise<std::shared_ptr<const Product>>>>();
 	{
-		std::shared_lock<std::shared_mutex> readLock(mCacheMutex);
-		if (auto cachedProduct = mCache->get(productId); cachedProduct) {
-			Logger::log(LogLevel::INFO, LogCategory::SERVICE,
-				"Product ID: " + std::to_string(productId) + " found in cache.");
-			return cachedProduct;
+		std::scoped_lock lock(mInFlightMutex);
+		for (uint64_t productId : missingIds) {
+			const Prehashed<uint64_t> key(productId);
+			if (auto it = mInFlight.find(key); it != mInFlight.end()) {
+				joinedFetches.emplace_back(productId, it->second);
+				continue;
+			}
+			batchIds.push_back(productId);
+			batchFetches.push_back(fetchPromises->emplace_back().get_future().share());
+			mInFlight.emplace(productId, batchFetches.back());
+		}
+	}
+	mCoalescedFetches.fetch_add(joinedFetches.size(), std::memory_order_relaxed);
+
+	bool rejected = false;
+	if (!batchIds.empty()) {
+		const uint64_t epoch = mInvalidationEpoch.load();
+		if (mExecutor->submit([this, batchIds, fetchPromises, epoch] { completeBatch(batchIds, *fetchPromises, epoch); })) {
+			mMetrics.databaseFetches.increment(batchIds.size());
+		}
+		else {
+			// Hits are still returned; the misses stay empty, as counted rejections.
+			rejected = true;
+			mMetrics.rejectedFetches.increment(batchIds.size());
+			LOG_WARNING(LogCategory::SERVICE, "Database batch of {} products rejected by the executor.", batchIds.size());
+			{
+				std::scoped_lock lock(mInFlightMutex);
+				for (uint64_t productId : batchIds) {
+					mInFlight.erase(productId);
+				}
+			}
+			const auto failure = std::make_exception_ptr(std::runtime_error("Database executor is full."));
+			for (auto& fetchPromise : *fetchPromises) {
+				fetchPromise.set_exception(failure);
+			}
 		}
 	}
 
-	Logger::log(LogLevel::INFO, LogCategory::SERVICE,
-		"Product ID: " + std::to_string(productId) + " not found in cache. Fetching from database.");
+	const auto fill = [&products, &missPositions](uint64_t productId, const std::shared_ptr<const Product>& product) {
+		for (size_t position : missPositions[productId]) {
+			products[position] = product;
+		}
+	};
+	// Rethrows a fetch's exception, if any
+	for (size_t i = 0; i < batchIds.size() && !rejected; ++i) {
+		fill(batchIds[i], batchFetches[i].get());
+	}
+	for (const auto& [productId, pendingFetch] : joinedFetches) {
+		fill(productId, pendingFetch.get());
+	}
+
+	return products;
+}
+
+size_t ProductService::warmUp(std::span<const uint64_t> productIds, size_t batchSize) {
+	LOG_INFO(LogCategory::SERVICE, "Warming up the cache with {} products in batches of {}", productIds.size(), batchSize);
+	batchSize = std::max<size_t>(batchSize, 1);
+
+	std::vector<std::future<size_t>> batches;
+	batches.reserve((productIds.size() + batchSize - 1) / batchSize);
+	for (size_t first = 0; first < productIds.size(); first += batchSize) {
+		const auto batchIds = productIds.subspan(first, std::min(batchSize, productIds.size() - first));
+		auto batchFetch = std::make_shared<std::packaged_task<size_t()>>([this, batchIds] {
+			const uint64_t epoch = mInvalidationEpoch.load();
+			auto dbProducts = mDatabase->fetchProductDetailsBatch(batchIds);
+
+			size_t cached = 0;
+			for (size_t i = 0; i < batchIds.size() && i < dbProducts.size(); ++i) {
+				if (!dbProducts[i]) {
+					mMetrics.databaseNotFound.increment();
+					continue;
+				}
+				if (putIfCurrent(batchIds[i], std::make_shared<const Product>(std::move(*dbProducts[i])), epoch)) {
+					++cached;
+				}
+			}
+			return cached;
+			});
+
+		auto batchResult = batchFetch->get_future();
+		if (!mExecutor->submit([batchFetch] { (*batchFetch)(); })) {
+			mMetrics.rejectedFetches.increment(batchIds.size());
+			LOG_WARNING(LogCategory::SERVICE, "Warm-up batch of {} products rejected by the executor.", batchIds.size());
+			continue;
+		}
+		mMetrics.databaseFetches.increment(batchIds.size());
+		batches.push_back(std::move(batchResult));
+	}
+
+	// Every batch refers to productIds, so all of them are waited for even if one fails.
+	size_t cached = 0;
+	std::exception_ptr failure;
+	for (auto& batch : batches) {
+		try {
+			cached += batch.get();
+		}
+		catch (...) {
+			failure = std::current_exception();
+		}
+	}
+	if (failure) {
+		std::rethrow_exception(failure);
+	}
+
+	LOG_INFO(LogCategory::SERVICE, "Warm-up cached {} of {} products.", cached, productIds.size());
+	return cached;
+}
+
+size_t ProductService::getProductCountByCategory(uint32_t categoryId) const {
+	LOG_INFO(LogCategory::SERVICE, "Fetching product count for category ID: {}", categoryId);
+
+	if (auto count = mCategoryCounts.get(categoryId)) {
+		LOG_INFO(LogCategory::SERVICE, "Count of category ID: {} found in cache.", categoryId);
+		return *count;
+	}
+
+	auto countPromise = std::make_shared<std::promise<size_t>>();
+	PendingCount pendingCount;
+	bool isLeader = false;
+	{
+		std::scoped_lock lock(mInFlightMutex);
+		if (auto it = mCountsInFlight.find(categoryId); it != mCountsInFlight.end()) {
+			pendingCount = it->second;
+		}
+		else {
+			pendingCount = countPromise->get_future().share();
+			mCountsInFlight.emplace(categoryId, pendingCount);
+			isLeader = true;
+		}
+	}
+
+	if (!isLeader) {
+		LOG_INFO(LogCategory::SERVICE, "Count of category ID: {} already being computed. Waiting for it.", categoryId);
+		return pendingCount.get();
+	}
+
+	const uint64_t epoch = mInvalidationEpoch.load();
+	if (!mExecutor->submit([this, categoryId, countPromise, epoch] { completeCount(categoryId, *countPromise, epoch); })) {
+		mMetrics.rejectedFetches.increment();
+		{
+			std::scoped_lock lock(mInFlightMutex);
+			mCountsInFlight.erase(categoryId);
+		}
+		countPromise->set_exception(std::make_exception_ptr(std::runtime_error("Database executor is full.")));
+	}
+	return pendingCount.get();
+}
+
+void ProductService::setCategoryCountTimeToLive(std::chrono::milliseconds ttl) noexcept {
+	mCategoryCounts.setTimeToLive(ttl);
+}
+
+CacheMetricsSnapshot ProductService::getCategoryCountMetrics() const {
+	return mCategoryCounts.getMetrics();
+}
+
+uint64_t ProductService::getCoalescedFetchCount() const noexcept {
+	return mCoalescedFetches.load(std::memory_order_relaxed);
+}
+
+void ProductService::setStaleWhileRevalidate(std::chrono::milliseconds softTtl) noexcept {
+	mSoftTtl.store(softTtl, std::memory_order_relaxed);
+}
 
+ServiceMetricsSnapshot ProductService::getMetrics() const {
+	auto snapshot = mMetrics.snapshot();
+	snapshot.coalescedFetches = getCoalescedFetchCount();
+	return snapshot;
+}
+
+std::shared_ptr<const Product> ProductService::lookupCached(const Prehashed<uint64_t>& productId) const {
+	if (auto [cachedProduct, storedAt] = mCache->getTimed(productId); cachedProduct) {
+		mMetrics.cacheHits.increment();
+		LOG_INFO(LogCategory::SERVICE, "Product ID: {} found in cache.", productId.key);
+		const auto softTtl = mSoftTtl.load(std::memory_order_relaxed);
+		if (softTtl > std::chrono::milliseconds::zero() && CoarseClock::now() - storedAt >= softTtl) {
+			mMetrics.staleHits.increment();
+			scheduleRefresh(productId.key);
+		}
+		return cachedProduct;
+	}
+
+	mMetrics.cacheMisses.increment();
+	LOG_INFO(LogCategory::SERVICE, "Product ID: {} not found in cache. Fetching from database.", productId.key);
+	return nullptr;
+}
+
+ProductService::PendingFetch ProductService::fetchMiss(const Prehashed<uint64_t>& productId) const {
+	auto fetchPromise = std::make_shared<std::promise<std::shared_ptr<const Product>>>();
+	PendingFetch pendingFetch;
+	{
+		std::scoped_lock lock(mInFlightMutex);
+		if (auto it = mInFlight.find(productId); it != mInFlight.end()) {
+			mCoalescedFetches.fetch_add(1, std::memory_order_relaxed);
+			LOG_INFO(LogCategory::SERVICE, "Product ID: {} already being fetched. Joining the in-flight fetch.", productId.key);
+			return it->second;
+		}
+		pendingFetch = fetchPromise->get_future().share();
+		mInFlight.emplace(productId.key, pendingFetch);
+	}
+
+	if (!mExecutor->submit([this, productId, fetchPromise] { completeFetch(productId, *fetchPromise); })) {
+		mMetrics.rejectedFetches.increment();
+		{
+			std::scoped_lock lock(mInFlightMutex);
+			mInFlight.erase(productId.key);
+		}
+		fetchPromise->set_exception(std::make_exception_ptr(std::runtime_error("Database executor is full.")));
+	}
+	return pendingFetch;
+}
+
+void ProductService::completeFetch(const Prehashed<uint64_t>& productId, std::promise<std::shared_ptr<const Product>>& fetchPromise) const {
+	// The entry is removed only after the cache has been populated, so a later
+	// caller either hits the cache or joins this fetch.
+	try {
+		auto product = fetchAndCache(productId);
+		{
+			std::scoped_lock lock(mInFlightMutex);
+			mInFlight.erase(productId.key);
+		}
+		fetchPromise.set_value(std::move(product));
+	}
+	catch (...) {
+		{
+			std::scoped_lock lock(mInFlightMutex);
+			mInFlight.erase(productId.key);
+		}
+		fetchPromise.set_exception(std::current_exception());
+	}
+}
+
+void ProductService::completeBatch(std::span<const uint64_t> productIds,
+	std::span<std::promise<std::shared_ptr<const Product>>> fetchPromises, uint64_t epoch) const {
+	// As in completeFetch(), the entries are removed only after the cache has been populated.
+	const auto finishInFlight = [this, productIds] {
+		std::scoped_lock lock(mInFlightMutex);
+		for (uint64_t productId : productIds) {
+			mInFlight.erase(productId);
+		}
+	};
+	try {
+		auto dbProducts = mDatabase->fetchProductDetailsBatch(productIds);
+		std::vector<std::shared_ptr<const Product>> products(productIds.size());
+		for (size_t i = 0; i < productIds.size() && i < dbProducts.size(); ++i) {
+			if (!dbProducts[i]) {
+				mMetrics.databaseNotFound.increment();
+				continue;
+			}
+			products[i] = std::make_shared<const Product>(std::move(*dbProducts[i]));
+			putIfCurrent(productIds[i], products[i], epoch);
+		}
+		finishInFlight();
+		for (size_t i = 0; i < fetchPromises.size(); ++i) {
+			fetchPromises[i].set_value(std::move(products[i]));
+		}
+	}
+	catch (...) {
+		finishInFlight();
+		const auto failure = std::current_exception();
+		for (auto& fetchPromise : fetchPromises) {
+			fetchPromise.set_exception(failure);
+		}
+	}
+}
+
+void ProductService::completeCount(uint32_t categoryId, std::promise<size_t>& countPromise, uint64_t epoch) const {
+	try {
+		const size_t count = mDatabase->fetchProductCountByCategory(categoryId);
+		// Same rule as putIfCurrent(): a count that may predate a change is returned but not cached.
+		if (isCurrent(epoch)) {
+			mCategoryCounts.put(categoryId, count);
+			if (!isCurrent(epoch)) {
+				mCategoryCounts.invalidate(categoryId);
+			}
+		}
+		{
+			std::scoped_lock lock(mInFlightMutex);
+			mCountsInFlight.erase(categoryId);
+		}
+		countPromise.set_value(count);
+	}
+	catch (...) {
+		{
+			std::scoped_lock lock(mInFlightMutex);
+			mCountsInFlight.erase(categoryId);
+		}
+		countPromise.set_exception(std::current_exception());
+	}
+}
+
+std::shared_ptr<const Product> ProductService::fetchAndCache(const Prehashed<uint64_t>& productId) const {
+	mMetrics.databaseFetches.increment();
+	const uint64_t epoch = mInvalidationEpoch.load();
 	// Fetch from database outside of the lock
 	if (auto dbProduct = mDatabase->fetchProductDetails(productId); dbProduct) {
-		Logger::log(LogLevel::INFO, LogCategory::SERVICE,
-			"Product ID: " + std::to_string(productId) + " found in database.");
+		LOG_INFO(LogCategory::SERVICE, "Product ID: {} found in database.", productId.key);
 
-		// Unique lock for writing to the cache
-		{
-			std::unique_lock<std::shared_mutex> writeLock(mCacheMutex);
-			mCache->put(productId, *dbProduct);
-			Logger::log(LogLevel::INFO, LogCategory::SERVICE,
-				"Product ID: " + std::to_string(productId) + " added to cache.");
+		// The cache and the caller share this single copy of the product
+		auto product = std::make_shared<const Product>(std::move(*dbProduct));
+
+		putIfCurrent(productId.key, product, epoch);
+		return product;
+	}
+
+	mMetrics.databaseNotFound.increment();
+	LOG_WARNING(LogCategory::SERVICE, "Product ID: {} not found in cache or database.", productId.key);
+	return nullptr;
+}
+
+bool ProductService::putIfCurrent(uint64_t productId, std::shared_ptr<const Product> product, uint64_t epoch) const {
+	if (!isCurrent(epoch)) {
+		LOG_INFO(LogCategory::SERVICE, "Product ID: {} may have changed while it was fetched. Not caching it.", productId);
+		return false;
+	}
+	mCache->putShared(productId, std::move(product));
+	// Re-checked after the put: a notification that started meanwhile may have
+	// invalidated the ID before the copy landed.
+	if (!isCurrent(epoch)) {
+		mCache->invalidate(productId);
+		LOG_INFO(LogCategory::SERVICE, "Product ID: {} changed while it was cached. Dropped it again.", productId);
+		return false;
+	}
+	LOG_INFO(LogCategory::SERVICE, "Product ID: {} added to cache.", productId);
+	return true;
+}
+
+bool ProductService::isCurrent(uint64_t epoch) const noexcept {
+	// Read in this order: a notification bumps the epoch before it leaves, so
+	// it is seen either running or finished.
+	return mInvalidationsInFlight.load() == 0 && mInvalidationEpoch.load() == epoch;
+}
+
+void ProductService::onDatabaseChanges(std::span<const ProductChange> changes) {
+	std::vector<uint64_t> productIds;
+	std::vector<uint32_t> categoryIds;
+	productIds.reserve(changes.size());
+	for (const auto& change : changes) {
+		productIds.push_back(change.productId);
+		if (change.changesCategoryCounts()) {
+			categoryIds.push_back(change.categoryId);
+			categoryIds.push_back(change.previousCategoryId);
 		}
+	}
+	std::ranges::sort(categoryIds);
+	categoryIds.erase(std::ranges::unique(categoryIds).begin(), categoryIds.end());
 
-		return dbProduct;
+	// The cache locks internally, so readers only wait for the shards this batch
+	// touches. Fills that overlap the batch see it in flight; see putIfCurrent().
+	mInvalidationsInFlight.fetch_add(1);
+	const size_t removed = mCache->invalidateMany(productIds);
+	if (!categoryIds.empty()) {
+		mCategoryCounts.invalidateMany(categoryIds);
 	}
+	mInvalidationEpoch.fetch_add(1);
+	mInvalidationsInFlight.fetch_sub(1);
 
-	Logger::log(LogLevel::WARNING, LogCategory::SERVICE,
-		"Product ID: " + std::to_string(productId) + " not found in cache or database.");
-	return std::nullopt;
+	mMetrics.invalidations.increment(removed);
+	LOG_INFO(LogCategory::SERVICE, "Applied {} database changes: {} cached products invalidated.", changes.size(), removed);
+}
+
+void ProductService::scheduleRefresh(uint64_t productId) const {
+	{
+		std::scoped_lock lock(mRefreshMutex);
+		if (!mRefreshPending.insert(productId).second) {
+			return;
+		}
+	}
+
+	LOG_INFO(LogCategory::SERVICE, "Product ID: {} is stale. Scheduling a background refresh.", productId);
+	// Never blocks the reader: a refresh that does not fit is retried on a later stale hit.
+	const bool submitted = mExecutor->trySubmit([this, productId] {
+		refresh(productId);
+		std::scoped_lock lock(mRefreshMutex);
+		mRefreshPending.erase(productId);
+		});
+	if (!submitted) {
+		std::scoped_lock lock(mRefreshMutex);
+		mRefreshPending.erase(productId);
+	}
 }
 
+void ProductService::refresh(uint64_t productId) const {
+	// The stale copy keeps being served until the refetched one replaces it; on
+	// failure it is simply retried on the next stale hit. A product the database
+	// no longer has is dropped instead.
+	try {
+		mMetrics.databaseFetches.increment();
+		const uint64_t epoch = mInvalidationEpoch.load();
+		auto dbProduct = mDatabase->fetchProductDetails(productId);
+		if (!dbProduct) {
+			mMetrics.databaseNotFound.increment();
+			// A notification that ran meanwhile has already dealt with the cached copy.
+			if (isCurrent(epoch) && mCache->invalidate(productId)) {
+				mMetrics.invalidations.increment();
+			}
+			LOG_WARNING(LogCategory::SERVICE, "Product ID: {} no longer in database. Dropped the cached copy.", productId);
+			return;
+		}
+
+		// Counted before the cache write, so a reader that sees the new copy sees the count too.
+		mMetrics.backgroundRefreshes.increment();
+		auto product = std::make_shared<const Product>(std::move(*dbProduct));
+		putIfCurrent(productId, std::move(product), epoch);
+		LOG_INFO(LogCategory::SERVICE, "Product ID: {} refreshed in the background.", productId);
+	}
+	catch (const std::exception& e) {
+		LOG_ERROR(LogCategory::SERVICE, "Background refresh of Product ID: {} failed: {}", productId, e.what());
+	}
+}
\ No newline at end of file
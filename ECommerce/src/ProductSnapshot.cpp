@@ -0,0 +1,173 @@
+#include "ProductSnapshot.h"
+#include "MappedFile.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+    // Products per thread below which starting another thread costs more than it saves.
+    constexpr size_t MIN_PRODUCTS_PER_THREAD = 16 * 1024;
+
+    template<typename T>
+    T load(std::span<const std::byte> bytes, uint64_t offset) noexcept {
+        T value;
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+        return value;
+    }
+}
+
+[[nodiscard]] size_t ProductSnapshot::recordSize(const Product& product) noexcept {
+    return sizeof(RecordHeader) + product.getName().size() + product.getDescription().size() + product.getThumbnailBytes().size();
+}
+
+void ProductSnapshot::encodeRecord(const Product& product, std::vector<std::byte>& buffer) {
+    const auto name = product.getName();
+    const auto description = product.getDescription();
+    const auto thumbnail = product.getThumbnailBytes();
+    const RecordHeader record{
+        product.getId(),
+        product.getCategory(),
+        static_cast<uint32_t>(name.size()),
+        static_cast<uint32_t>(description.size()),
+        static_cast<uint32_t>(thumbnail.size())
+    };
+
+    const size_t start = buffer.size();
+    buffer.resize(start + recordSize(product));
+    auto* out = buffer.data() + start;
+    std::memcpy(out, &record, sizeof(record));
+    out += sizeof(record);
+    std::memcpy(out, name.data(), name.size());
+    out += name.size();
+    std::memcpy(out, description.data(), description.size());
+    out += description.size();
+    std::memcpy(out, thumbnail.data(), thumbnail.size());
+}
+
+[[nodiscard]] Product ProductSnapshot::decodeRecord(std::span<const std::byte> record) {
+    const auto header = record.size() >= sizeof(RecordHeader) ? load<RecordHeader>(record, 0) : RecordHeader{};
+    if (record.size() < sizeof(RecordHeader)
+        || record.size() - sizeof(RecordHeader) != uint64_t{ header.nameLength } + header.descriptionLength + header.thumbnailLength) {
+        throw std::runtime_error("Product record is corrupt.");
+    }
+
+    const auto* fields = record.data() + sizeof(RecordHeader);
+    return Product(
+        header.id,
+        header.category,
+        std::string_view(reinterpret_cast<const char*>(fields), header.nameLength),
+        std::string_view(reinterpret_cast<const char*>(fields + header.nameLength), header.descriptionLength),
+        std::span<const std::byte>(fields + header.nameLength + header.descriptionLength, header.thumbnailLength));
+}
+
+void ProductSnapshot::write(const std::filesystem::path& path, std::span<const std::shared_ptr<const Product>> products) {
+    auto temporaryPath = path;
+    temporaryPath += ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc | std::ios::binary);
+        if (!file.is_open()) {
+            LOG_ERROR(LogCategory::CACHE, "Failed to create snapshot {}.", temporaryPath.string());
+            throw std::ios_base::failure("Failed to open snapshot file.");
+        }
+
+        Header header{ MAGIC, VERSION, 0, products.size(), sizeof(Header) };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        std::vector<std::byte> buffer;
+        for (const auto& product : products) {
+            buffer.clear();
+            encodeRecord(*product, buffer);
+            file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            header.fileSize += buffer.size();
+        }
+
+        // The size goes in last, so a file cut short is never mistaken for a complete one.
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.close();
+        if (file.fail()) {
+            LOG_ERROR(LogCategory::CACHE, "Failed to write snapshot {}.", temporaryPath.string());
+            throw std::ios_base::failure("Failed to write snapshot file.");
+        }
+    }
+    std::filesystem::rename(temporaryPath, path);
+
+    LOG_INFO(LogCategory::CACHE, "Wrote a snapshot of {} products to {}.", products.size(), path.string());
+}
+
+[[nodiscard]] std::vector<std::shared_ptr<const Product>> ProductSnapshot::read(const std::filesystem::path& path,
+    size_t maxProducts,
+    size_t threadCount) {
+    const MappedFile file(path);
+    const auto bytes = file.getBytes();
+
+    if (bytes.size() < sizeof(Header)) {
+        LOG_ERROR(LogCategory::CACHE, "Snapshot {} is too small for a header.", path.string());
+        throw std::runtime_error("Snapshot is truncated.");
+    }
+    const auto header = load<Header>(bytes, 0);
+    if (header.magic != MAGIC || header.version != VERSION) {
+        LOG_ERROR(LogCategory::CACHE, "Snapshot {} has an unknown format.", path.string());
+        throw std::runtime_error("Snapshot has an unknown format.");
+    }
+    if (header.fileSize != bytes.size()) {
+        LOG_ERROR(LogCategory::CACHE, "Snapshot {} is truncated or corrupt.", path.string());
+        throw std::runtime_error("Snapshot is truncated or corrupt.");
+    }
+
+    // Records are variable-length, so their offsets are found in one sequential pass.
+    const size_t productCount = static_cast<size_t>(std::min<uint64_t>(header.productCount, maxProducts));
+    std::vector<uint64_t> offsets;
+    offsets.reserve(productCount);
+    uint64_t offset = sizeof(Header);
+    for (size_t position = 0; position < productCount; ++position) {
+        if (bytes.size() - offset < sizeof(RecordHeader)) {
+            LOG_ERROR(LogCategory::CACHE, "Snapshot {} ends inside record {}.", path.string(), position);
+            throw std::runtime_error("Snapshot is truncated or corrupt.");
+        }
+        const auto record = load<RecordHeader>(bytes, offset);
+        const uint64_t recordSize = sizeof(RecordHeader)
+            + uint64_t{ record.nameLength } + record.descriptionLength + record.thumbnailLength;
+        if (bytes.size() - offset < recordSize) {
+            LOG_ERROR(LogCategory::CACHE, "Snapshot {} ends inside record {}.", path.string(), position);
+            throw std::runtime_error("Snapshot is truncated or corrupt.");
+        }
+        offsets.push_back(offset);
+        offset += recordSize;
+    }
+
+    std::vector<std::shared_ptr<const Product>> products(productCount);
+    const auto buildRange = [&](size_t first, size_t last) {
+        for (size_t position = first; position < last; ++position) {
+            const uint64_t end = position + 1 < offsets.size() ? offsets[position + 1] : offset;
+            products[position] = std::make_shared<const Product>(
+                decodeRecord(bytes.subspan(offsets[position], end - offsets[position])));
+        }
+        };
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::clamp<size_t>(productCount / MIN_PRODUCTS_PER_THREAD, 1, threadCount);
+    {
+        // The calling thread builds the first range while the others build the rest.
+        std::vector<std::jthread> builders;
+        const size_t rangeSize = (productCount + threadCount - 1) / threadCount;
+        for (size_t thread = 1; thread < threadCount; ++thread) {
+            builders.emplace_back(buildRange, thread * rangeSize, std::min(productCount, (thread + 1) * rangeSize));
+        }
+        buildRange(0, std::min(productCount, rangeSize));
+    }
+
+    LOG_INFO(LogCategory::CACHE, "Read {} of {} products from snapshot {} on {} threads.",
+        productCount, header.productCount, path.string(), threadCount);
+    return products;
+}
@@ -0,0 +1,101 @@
+#include "ScratchFile.h"
+#include "Logger.h"
+#include <algorithm>
+#include <ios>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+ScratchFile::ScratchFile(const std::filesystem::path& path) {
+    mFile = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE) {
+        mFile = nullptr;
+        LOG_ERROR(LogCategory::CACHE, "Failed to create scratch file {}.", path.string());
+        throw std::runtime_error("Failed to create scratch file.");
+    }
+}
+
+ScratchFile::~ScratchFile() {
+    CloseHandle(mFile);
+}
+
+void ScratchFile::write(uint64_t offset, std::span<const std::byte> bytes) {
+    while (!bytes.empty()) {
+        OVERLAPPED position{};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD written = 0;
+        const auto chunk = static_cast<DWORD>(std::min<size_t>(bytes.size(), MAXDWORD));
+        if (!WriteFile(mFile, bytes.data(), chunk, &written, &position) || written == 0) {
+            throw std::ios_base::failure("Failed to write scratch file.");
+        }
+        bytes = bytes.subspan(written);
+        offset += written;
+    }
+}
+
+void ScratchFile::read(uint64_t offset, std::span<std::byte> bytes) const {
+    while (!bytes.empty()) {
+        OVERLAPPED position{};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD read = 0;
+        const auto chunk = static_cast<DWORD>(std::min<size_t>(bytes.size(), MAXDWORD));
+        if (!ReadFile(mFile, bytes.data(), chunk, &read, &position) || read == 0) {
+            throw std::ios_base::failure("Failed to read scratch file.");
+        }
+        bytes = bytes.subspan(read);
+        offset += read;
+    }
+}
+
+#else
+
+ScratchFile::ScratchFile(const std::filesystem::path& path) {
+    mFile = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (mFile < 0) {
+        LOG_ERROR(LogCategory::CACHE, "Failed to create scratch file {}.", path.string());
+        throw std::runtime_error("Failed to create scratch file.");
+    }
+    // The open descriptor keeps the data reachable; nothing is left behind on exit.
+    ::unlink(path.c_str());
+}
+
+ScratchFile::~ScratchFile() {
+    ::close(mFile);
+}
+
+void ScratchFile::write(uint64_t offset, std::span<const std::byte> bytes) {
+    while (!bytes.empty()) {
+        const ssize_t written = ::pwrite(mFile, bytes.data(), bytes.size(), static_cast<off_t>(offset));
+        if (written <= 0) {
+            throw std::ios_base::failure("Failed to write scratch file.");
+        }
+        bytes = bytes.subspan(static_cast<size_t>(written));
+        offset += static_cast<uint64_t>(written);
+    }
+}
+
+void ScratchFile::read(uint64_t offset, std::span<std::byte> bytes) const {
+    while (!bytes.empty()) {
+        const ssize_t read = ::pread(mFile, bytes.data(), bytes.size(), static_cast<off_t>(offset));
+        if (read <= 0) {
+            throw std::ios_base::failure("Failed to read scratch file.");
+        }
+        bytes = bytes.subspan(static_cast<size_t>(read));
+        offset += static_cast<uint64_t>(read);
+    }
+}
+
+#endif
@@ -0,0 +1,195 @@
+#include "ShardedProductCache.h"
+#include "ClockProductCache.h"
+#include "ProductCache.h"
+#include "TinyLfuProductCache.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <functional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+namespace {
+    // splitmix64 finalizer over std::hash<uint64_t>, which is the identity on
+    // some standard libraries: sequential product IDs must not all land in one shard.
+    constexpr uint64_t mixHash(uint64_t hash) noexcept {
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+        return hash;
+    }
+
+    constexpr std::string_view evictionModeToString(EvictionMode evictionMode) {
+        switch (evictionMode) {
+        case EvictionMode::LRU:   return "LRU";
+        case EvictionMode::CLOCK: return "CLOCK";
+        case EvictionMode::TINY_LFU: return "TINY_LFU";
+        default:                  return "UNKNOWN";
+        }
+    }
+}
+
+ShardedProductCache::ShardedProductCache(size_t capacity, size_t shardCount, EvictionMode evictionMode)
+    : mEvictionMode{ evictionMode }
+{
+    if (capacity == 0 || shardCount == 0) {
+        LOG_ERROR(LogCategory::CACHE, "ShardedProductCache initialized with zero capacity or zero shards.");
+        throw std::invalid_argument("Cache capacity and shard count must be greater than zero.");
+    }
+
+    shardCount = std::bit_floor(std::min(shardCount, capacity));
+    mCapacity = capacity;
+    mShardCapacity = (capacity + shardCount - 1) / shardCount;
+    mShardMask = shardCount - 1;
+
+    mShards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        // The first capacity % shardCount shards take one extra entry, so the shards add up to capacity.
+        const size_t shardCapacity = capacity / shardCount + (i < capacity % shardCount ? 1 : 0);
+        switch (mEvictionMode) {
+        case EvictionMode::CLOCK:
+            mShards.push_back(std::make_unique<ClockProductCache>(shardCapacity));
+            break;
+        case EvictionMode::TINY_LFU:
+            mShards.push_back(std::make_unique<TinyLfuProductCache>(shardCapacity));
+            break;
+        default:
+            mShards.push_back(std::make_unique<ProductCache>(shardCapacity));
+            break;
+        }
+    }
+
+    LOG_INFO(LogCategory::CACHE, "ShardedProductCache initialized with {} {} shards of capacity {}",
+        shardCount, evictionModeToString(mEvictionMode), mShardCapacity);
+}
+
+[[nodiscard]] std::optional<Product> ShardedProductCache::get(uint64_t productId) {
+    return shardFor(productId).get(productId);
+}
+
+void ShardedProductCache::put(uint64_t productId, const Product& product) {
+    shardFor(productId).put(productId, product);
+}
+
+void ShardedProductCache::put(uint64_t productId, Product&& product) {
+    shardFor(productId).put(productId, std::move(product));
+}
+
+[[nodiscard]] std::shared_ptr<const Product> ShardedProductCache::getShared(uint64_t productId) {
+    return shardFor(productId).getShared(productId);
+}
+
+void ShardedProductCache::putShared(uint64_t productId, std::shared_ptr<const Product> product) {
+    shardFor(productId).putShared(productId, std::move(product));
+}
+
+[[nodiscard]] TimedValue<Product> ShardedProductCache::getTimed(uint64_t productId) {
+    return shardFor(productId).getTimed(productId);
+}
+
+[[nodiscard]] TimedValue<Product> ShardedProductCache::getTimed(const Prehashed<uint64_t>& productId) {
+    return mShards[shardIndexOfHash(productId.hash)]->getTimed(productId);
+}
+
+[[nodiscard]] std::vector<std::shared_ptr<const Product>> ShardedProductCache::getMany(std::span<const uint64_t> productIds) {
+    // Group positions by shard so each shard is locked once for the whole batch.
+    std::vector<std::vector<size_t>> positionsByShard(mShards.size());
+    for (size_t position = 0; position < productIds.size(); ++position) {
+        positionsByShard[shardIndex(productIds[position])].push_back(position);
+    }
+
+    std::vector<std::shared_ptr<const Product>> products(productIds.size());
+    std::vector<uint64_t> shardIds;
+    for (size_t shard = 0; shard < mShards.size(); ++shard) {
+        const auto& positions = positionsByShard[shard];
+        if (positions.empty()) {
+            continue;
+        }
+
+        shardIds.clear();
+        for (size_t position : positions) {
+            shardIds.push_back(productIds[position]);
+        }
+
+        auto shardProducts = mShards[shard]->getMany(shardIds);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            products[positions[i]] = std::move(shardProducts[i]);
+        }
+    }
+    return products;
+}
+
+bool ShardedProductCache::invalidate(uint64_t productId) {
+    return shardFor(productId).invalidate(productId);
+}
+
+size_t ShardedProductCache::invalidateMany(std::span<const uint64_t> productIds) {
+    std::vector<std::vector<uint64_t>> idsByShard(mShards.size());
+    for (uint64_t productId : productIds) {
+        idsByShard[shardIndex(productId)].push_back(productId);
+    }
+
+    size_t removed = 0;
+    for (size_t shard = 0; shard < mShards.size(); ++shard) {
+        if (!idsByShard[shard].empty()) {
+            removed += mShards[shard]->invalidateMany(idsByShard[shard]);
+        }
+    }
+    return removed;
+}
+
+size_t ShardedProductCache::invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) {
+    // Shards are swept one at a time, so the rest of the cache keeps serving.
+    size_t removed = 0;
+    for (auto& shard : mShards) {
+        removed += shard->invalidateIf(predicate);
+    }
+    return removed;
+}
+
+[[nodiscard]] size_t ShardedProductCache::getShardCount() const noexcept { return mShards.size(); }
+[[nodiscard]] size_t ShardedProductCache::getCapacity() const noexcept { return mCapacity; }
+
+[[nodiscard]] size_t ShardedProductCache::getShardCapacity() const noexcept { return mShardCapacity; }
+[[nodiscard]] EvictionMode ShardedProductCache::getEvictionMode() const noexcept { return mEvictionMode; }
+
+[[nodiscard]] size_t ShardedProductCache::defaultShardCount() noexcept {
+    // Oversubscribe the cores so two hot keys rarely share a shard.
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    return std::bit_ceil(cores * 4);
+}
+
+[[nodiscard]] CacheMetricsSnapshot ShardedProductCache::getMetrics() const {
+    CacheMetricsSnapshot total;
+    for (const auto& shard : mShards) {
+        switch (mEvictionMode) {
+        case EvictionMode::CLOCK:
+            total += static_cast<const ClockProductCache&>(*shard).getMetrics();
+            break;
+        case EvictionMode::TINY_LFU:
+            total += static_cast<const TinyLfuProductCache&>(*shard).getMetrics();
+            break;
+        default:
+            total += static_cast<const ProductCache&>(*shard).getMetrics();
+            break;
+        }
+    }
+    return total;
+}
+
+[[nodiscard]] size_t ShardedProductCache::shardIndex(uint64_t productId) const noexcept {
+    return shardIndexOfHash(std::hash<uint64_t>{}(productId));
+}
+
+[[nodiscard]] size_t ShardedProductCache::shardIndexOfHash(size_t hash) const noexcept {
+    return mixHash(hash) & mShardMask;
+}
+
+[[nodiscard]] ShardedProductCache::Shard& ShardedProductCache::shardFor(uint64_t productId) noexcept {
+    return *mShards[shardIndex(productId)];
+}
@@ -0,0 +1,223 @@
+#include "SlabProductCache.h"
+#include "Logger.h"
+#include <stdexcept>
+#include <string>
+
+SlabProductCache::SlabProductCache(size_t capacity)
+    : mCapacity{ capacity }
+    , mIndex{ capacity }
+{
+    if (mCapacity == 0) {
+        LOG_ERROR(LogCategory::CACHE, "SlabProductCache initialized with zero capacity.");
+        throw std::invalid_argument("Cache capacity must be greater than zero.");
+    }
+    if (mCapacity >= NIL) {
+        LOG_ERROR(LogCategory::CACHE, "SlabProductCache capacity {} exceeds 32-bit node indexes.", mCapacity);
+        throw std::invalid_argument("Cache capacity must fit in 32-bit node indexes.");
+    }
+    mNodes.resize(mCapacity);
+    LOG_INFO(LogCategory::CACHE, "SlabProductCache initialized with capacity: {}", mCapacity);
+}
+
+[[nodiscard]] std::optional<Product> SlabProductCache::get(uint64_t productId) {
+    if (auto product = getShared(productId)) {
+        return *product;
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] std::shared_ptr<const Product> SlabProductCache::getShared(uint64_t productId) {
+    ScopedLatency latency(mMetrics.getLatency);
+    std::scoped_lock lock(mCacheMutex);
+
+    LOG_INFO(LogCategory::CACHE, "Getting Product ID: {}", productId);
+
+    if (auto product = lookup(productId)) {
+        mMetrics.hits.increment();
+        LOG_INFO(LogCategory::CACHE, "Product ID: {} found.", productId);
+        return product;
+    }
+
+    mMetrics.misses.increment();
+    LOG_INFO(LogCategory::CACHE, "Product ID: {} not found.", productId);
+    return nullptr;
+}
+
+[[nodiscard]] std::vector<std::shared_ptr<const Product>> SlabProductCache::getMany(std::span<const uint64_t> productIds) {
+    std::vector<std::shared_ptr<const Product>> products;
+    products.reserve(productIds.size());
+    size_t hits = 0;
+
+    std::scoped_lock lock(mCacheMutex);
+
+    for (uint64_t productId : productIds) {
+        products.push_back(lookup(productId));
+        if (products.back()) {
+            ++hits;
+        }
+    }
+
+    mMetrics.hits.increment(hits);
+    mMetrics.misses.increment(productIds.size() - hits);
+    LOG_INFO(LogCategory::CACHE, "Batch get of {} products: {} found.", productIds.size(), hits);
+    return products;
+}
+
+void SlabProductCache::put(uint64_t productId, const Product& product) {
+    putShared(productId, std::make_shared<const Product>(product));
+}
+
+void SlabProductCache::put(uint64_t productId, Product&& product) {
+    putShared(productId, std::make_shared<const Product>(std::move(product)));
+}
+
+void SlabProductCache::putShared(uint64_t productId, std::shared_ptr<const Product> product) {
+    std::scoped_lock lock(mCacheMutex);
+
+    LOG_INFO(LogCategory::CACHE, "Putting Product ID: {}", productId);
+    mMetrics.puts.increment();
+
+    if (const uint32_t node = mIndex.find(productId); node != NIL) {
+        mNodes[node].product = std::move(product);
+        unlink(node);
+        pushFront(node);
+        return;
+    }
+
+    uint32_t node = mSize;
+    if (mSize < mCapacity) {
+        ++mSize;
+    }
+    else {
+        node = mTail;
+        mMetrics.evictions.increment();
+        LOG_WARNING(LogCategory::CACHE, "Evicting Product ID: {}", mNodes[node].productId);
+        mIndex.erase(mNodes[node].productId);
+        unlink(node);
+    }
+
+    mNodes[node].productId = productId;
+    mNodes[node].product = std::move(product);
+    pushFront(node);
+    mIndex.insert(productId, node);
+}
+
+bool SlabProductCache::invalidate(uint64_t productId) {
+    return invalidateMany(std::span<const uint64_t>(&productId, 1)) != 0;
+}
+
+size_t SlabProductCache::invalidateMany(std::span<const uint64_t> productIds) {
+    size_t removed = 0;
+    std::scoped_lock lock(mCacheMutex);
+
+    for (uint64_t productId : productIds) {
+        if (const uint32_t node = mIndex.find(productId); node != NIL) {
+            release(node);
+            ++removed;
+        }
+    }
+
+    mMetrics.invalidations.increment(removed);
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} of {} products.", removed, productIds.size());
+    return removed;
+}
+
+size_t SlabProductCache::invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) {
+    size_t removed = 0;
+    std::scoped_lock lock(mCacheMutex);
+
+    // Walking down from the end means a node moved into a freed slot has already been visited.
+    for (uint32_t node = mSize; node > 0; --node) {
+        if (predicate(mNodes[node - 1].productId, *mNodes[node - 1].product)) {
+            release(node - 1);
+            ++removed;
+        }
+    }
+
+    mMetrics.invalidations.increment(removed);
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} products matching a predicate.", removed);
+    return removed;
+}
+
+[[nodiscard]] size_t SlabProductCache::getSize() const {
+    std::scoped_lock lock(mCacheMutex);
+    return mSize;
+}
+
+[[nodiscard]] CacheMetricsSnapshot SlabProductCache::getMetrics() const {
+    auto snapshot = mMetrics.snapshot();
+    std::scoped_lock lock(mCacheMutex);
+    snapshot.entries = mSize;
+    return snapshot;
+}
+
+[[nodiscard]] std::shared_ptr<const Product> SlabProductCache::lookup(uint64_t productId) noexcept {
+    const uint32_t node = mIndex.find(productId);
+    if (node == NIL) {
+        return nullptr;
+    }
+    if (node != mHead) {
+        unlink(node);
+        pushFront(node);
+    }
+    return mNodes[node].product;
+}
+
+void SlabProductCache::unlink(uint32_t node) noexcept {
+    auto& entry = mNodes[node];
+    if (entry.prev != NIL) {
+        mNodes[entry.prev].next = entry.next;
+    }
+    else {
+        mHead = entry.next;
+    }
+    if (entry.next != NIL) {
+        mNodes[entry.next].prev = entry.prev;
+    }
+    else {
+        mTail = entry.prev;
+    }
+    entry.prev = NIL;
+    entry.next = NIL;
+}
+
+void SlabProductCache::pushFront(uint32_t node) noexcept {
+    auto& entry = mNodes[node];
+    entry.prev = NIL;
+    entry.next = mHead;
+    if (mHead != NIL) {
+        mNodes[mHead].prev = node;
+    }
+    mHead = node;
+    if (mTail == NIL) {
+        mTail = node;
+    }
+}
+
+void SlabProductCache::release(uint32_t node) {
+    mIndex.erase(mNodes[node].productId);
+    unlink(node);
+
+    const uint32_t last = mSize - 1;
+    if (node != last) {
+        auto& moved = mNodes[last];
+        mIndex.erase(moved.productId);
+        mIndex.insert(moved.productId, node);
+        if (moved.prev != NIL) {
+            mNodes[moved.prev].next = node;
+        }
+        else {
+            mHead = node;
+        }
+        if (moved.next != NIL) {
+            mNodes[moved.next].prev = node;
+        }
+        else {
+            mTail = node;
+        }
+        mNodes[node] = std::move(moved);
+    }
+
+    mNodes[last] = Node{};
+    --mSize;
+}
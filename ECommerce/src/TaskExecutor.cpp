@@ -0,0 +1,150 @@
+#include "TaskExecutor.h"
+#include "Logger.h"
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Set on worker threads, so tasks they submit stay on their own queue.
+    thread_local const TaskExecutor* currentExecutor = nullptr;
+    thread_local size_t currentWorker = 0;
+}
+
+TaskExecutor::TaskExecutor(const ExecutorOptions& options)
+    : mMaxQueuedTasks{ options.maxQueuedTasks }
+    , mOverflowPolicy{ options.overflowPolicy }
+{
+    if (options.workerCount == 0 || options.maxQueuedTasks == 0) {
+        LOG_ERROR(LogCategory::GENERAL, "TaskExecutor initialized with zero workers or a zero queue limit.");
+        throw std::invalid_argument("Executor worker count and queue limit must be greater than zero.");
+    }
+
+    mQueues.reserve(options.workerCount);
+    for (size_t i = 0; i < options.workerCount; ++i) {
+        mQueues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    mWorkers.reserve(options.workerCount);
+    for (size_t i = 0; i < options.workerCount; ++i) {
+        mWorkers.emplace_back([this, i](std::stop_token stopToken) { run(i, stopToken); });
+    }
+
+    LOG_INFO(LogCategory::GENERAL, "TaskExecutor initialized with {} workers and a limit of {} queued tasks.",
+        options.workerCount, mMaxQueuedTasks);
+}
+
+[[nodiscard]] bool TaskExecutor::submit(Task task) {
+    if (mOverflowPolicy == ExecutorOverflowPolicy::REJECT) {
+        return trySubmit(std::move(task));
+    }
+
+    while (!tryReserve()) {
+        std::unique_lock lock(mWaitMutex);
+        mSpaceReady.wait(lock, [this] { return mQueued.load(std::memory_order_relaxed) < mMaxQueuedTasks; });
+    }
+    enqueue(std::move(task));
+    return true;
+}
+
+[[nodiscard]] bool TaskExecutor::trySubmit(Task task) {
+    if (!tryReserve()) {
+        mRejected.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARNING(LogCategory::GENERAL, "TaskExecutor queue is full ({} tasks). Rejecting a task.", mMaxQueuedTasks);
+        return false;
+    }
+    enqueue(std::move(task));
+    return true;
+}
+
+[[nodiscard]] size_t TaskExecutor::getWorkerCount() const noexcept {
+    return mWorkers.size();
+}
+
+[[nodiscard]] size_t TaskExecutor::getQueuedCount() const noexcept {
+    return mQueued.load(std::memory_order_relaxed);
+}
+
+[[nodiscard]] uint64_t TaskExecutor::getRejectedCount() const noexcept {
+    return mRejected.load(std::memory_order_relaxed);
+}
+
+[[nodiscard]] bool TaskExecutor::tryReserve() noexcept {
+    size_t queued = mQueued.load(std::memory_order_relaxed);
+    do {
+        if (queued >= mMaxQueuedTasks) {
+            return false;
+        }
+    } while (!mQueued.compare_exchange_weak(queued, queued + 1, std::memory_order_relaxed));
+    return true;
+}
+
+void TaskExecutor::enqueue(Task task) {
+    const size_t worker = currentExecutor == this
+        ? currentWorker
+        : mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+    {
+        std::scoped_lock lock(mQueues[worker]->mutex);
+        mQueues[worker]->tasks.push_back(std::move(task));
+    }
+
+    // A worker checks mQueued under mWaitMutex before sleeping; taking the lock
+    // here means it either saw the reservation or is already waiting.
+    { std::scoped_lock lock(mWaitMutex); }
+    mTaskReady.notify_one();
+}
+
+[[nodiscard]] bool TaskExecutor::tryPop(size_t worker, Task& task) {
+    {
+        auto& own = *mQueues[worker];
+        std::scoped_lock lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < mQueues.size(); ++offset) {
+        auto& victim = *mQueues[(worker + offset) % mQueues.size()];
+        std::scoped_lock lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskExecutor::run(size_t worker, std::stop_token stopToken) {
+    currentExecutor = this;
+    currentWorker = worker;
+
+    while (true) {
+        Task task;
+        if (tryPop(worker, task)) {
+            mQueued.fetch_sub(1, std::memory_order_relaxed);
+            if (mOverflowPolicy == ExecutorOverflowPolicy::BLOCK) {
+                { std::scoped_lock lock(mWaitMutex); }
+                mSpaceReady.notify_one();
+            }
+
+            try {
+                task();
+            }
+            catch (const std::exception& e) {
+                LOG_ERROR(LogCategory::GENERAL, "TaskExecutor task failed: {}", e.what());
+            }
+            catch (...) {
+                LOG_ERROR(LogCategory::GENERAL, "TaskExecutor task failed with an unknown exception.");
+            }
+            continue;
+        }
+
+        // A stop request only ends the loop once every queued task has run.
+        std::unique_lock lock(mWaitMutex);
+        if (!mTaskReady.wait(lock, stopToken, [this] { return mQueued.load(std::memory_order_relaxed) > 0; })) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,305 @@
+#include "TieredProductCache.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+TieredProductCache::TieredProductCache(std::unique_ptr<ProductCache> memoryTier,
+    const LogStoreOptions& diskTier,
+    size_t maxPendingDemotions)
+    : mMemoryTier{ std::move(memoryTier) }
+    , mDiskTier{ diskTier }
+    , mMaxPendingDemotions{ maxPendingDemotions }
+{
+    if (!mMemoryTier) {
+        LOG_ERROR(LogCategory::CACHE, "TieredProductCache initialized without a memory tier.");
+        throw std::invalid_argument("Memory tier must not be null.");
+    }
+    mMemoryTier->setEvictionListener([this](uint64_t productId, const std::shared_ptr<const Product>& product) {
+        onEviction(productId, product);
+        });
+    mDemotionThread = std::jthread([this](std::stop_token stopToken) { runDemotions(stopToken); });
+    LOG_INFO(LogCategory::CACHE, "TieredProductCache initialized with a disk tier in {}", diskTier.directory.string());
+}
+
+[[nodiscard]] std::optional<Product> TieredProductCache::get(uint64_t productId) {
+    if (auto product = getShared(productId)) {
+        return *product;
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] std::shared_ptr<const Product> TieredProductCache::getShared(uint64_t productId) {
+    return getTimed(productId).value;
+}
+
+[[nodiscard]] TimedValue<Product> TieredProductCache::getTimed(uint64_t productId) {
+    return getTimed(Prehashed<uint64_t>(productId));
+}
+
+[[nodiscard]] TimedValue<Product> TieredProductCache::getTimed(const Prehashed<uint64_t>& productId) {
+    ScopedLatency latency(mMetrics.getLatency);
+
+    if (auto cached = mMemoryTier->getTimed(productId); cached.value) {
+        mMetrics.hits.increment();
+        return cached;
+    }
+    return { lookupLowerTiers(productId.key), CoarseClock::now() };
+}
+
+[[nodiscard]] std::vector<std::shared_ptr<const Product>> TieredProductCache::getMany(std::span<const uint64_t> productIds) {
+    auto products = mMemoryTier->getMany(productIds);
+    const auto memoryHits = static_cast<uint64_t>(std::ranges::count_if(products, [](const auto& product) { return product != nullptr; }));
+    mMetrics.hits.increment(memoryHits);
+
+    for (size_t position = 0; position < products.size(); ++position) {
+        if (!products[position]) {
+            products[position] = lookupLowerTiers(productIds[position]);
+        }
+    }
+    return products;
+}
+
+void TieredProductCache::put(uint64_t productId, const Product& product) {
+    putShared(productId, std::make_shared<const Product>(product));
+}
+
+void TieredProductCache::put(uint64_t productId, Product&& product) {
+    putShared(productId, std::make_shared<const Product>(std::move(product)));
+}
+
+void TieredProductCache::putShared(uint64_t productId, std::shared_ptr<const Product> product) {
+    mMetrics.puts.increment();
+    dropLowerCopies(std::span<const uint64_t>(&productId, 1));
+    mMemoryTier->putShared(productId, std::move(product));
+}
+
+bool TieredProductCache::invalidate(uint64_t productId) {
+    return invalidateMany(std::span<const uint64_t>(&productId, 1)) != 0;
+}
+
+size_t TieredProductCache::invalidateMany(std::span<const uint64_t> productIds) {
+    // A product can be in several tiers at once; each is counted once.
+    std::unordered_set<uint64_t> removed;
+    dropLowerCopies(productIds, &removed);
+    for (uint64_t productId : productIds) {
+        if (mMemoryTier->invalidate(productId)) {
+            removed.insert(productId);
+        }
+    }
+    mMetrics.invalidations.increment(removed.size());
+    return removed.size();
+}
+
+size_t TieredProductCache::invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) {
+    // A product can be in several tiers at once; each is counted once.
+    std::unordered_set<uint64_t> removed;
+    const auto recordingPredicate = [&predicate, &removed](const uint64_t& productId, const Product& product) {
+        if (predicate(productId, product)) {
+            removed.insert(productId);
+            return true;
+        }
+        return false;
+    };
+    {
+        std::scoped_lock lock(mDemotionMutex);
+        std::erase_if(mPending, [&recordingPredicate](const auto& entry) { return recordingPredicate(entry.first, *entry.second); });
+    }
+    mDiskTier.eraseIf(recordingPredicate);
+    mGeneration.fetch_add(1, std::memory_order_release);
+    mMemoryTier->invalidateIf(recordingPredicate);
+
+    mMetrics.invalidations.increment(removed.size());
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} products matching a predicate across both tiers.", removed.size());
+    return removed.size();
+}
+
+void TieredProductCache::flush() {
+    std::unique_lock lock(mDemotionMutex);
+    mDemotionsDone.wait(lock, [this] { return mDemotionQueue.empty() && !mWritingBatch; });
+}
+
+[[nodiscard]] CacheMetricsSnapshot TieredProductCache::getMetrics() const {
+    auto snapshot = mMetrics.snapshot();
+    const auto memory = mMemoryTier->getMetrics();
+    snapshot.evictions = mDiskTier.getMetrics().evictions + getDroppedDemotionCount();
+    snapshot.entries = memory.entries;
+    snapshot.bytes = memory.bytes;
+    return snapshot;
+}
+
+[[nodiscard]] CacheMetricsSnapshot TieredProductCache::getMemoryTierMetrics() const {
+    return mMemoryTier->getMetrics();
+}
+
+[[nodiscard]] CacheMetricsSnapshot TieredProductCache::getDiskTierMetrics() const {
+    return mDiskTier.getMetrics();
+}
+
+[[nodiscard]] uint64_t TieredProductCache::getDemotionCount() const noexcept {
+    return mDemotions.load();
+}
+
+[[nodiscard]] uint64_t TieredProductCache::getDroppedDemotionCount() const noexcept {
+    return mDroppedDemotions.load();
+}
+
+[[nodiscard]] uint64_t TieredProductCache::getCompactionCount() const noexcept {
+    return mDiskTier.getCompactionCount();
+}
+
+void TieredProductCache::onEviction(uint64_t productId, const std::shared_ptr<const Product>& product) {
+    std::scoped_lock lock(mDemotionMutex);
+    if (mPending.size() >= mMaxPendingDemotions && !mPending.contains(productId)) {
+        mDroppedDemotions.increment();
+        return;
+    }
+    if (auto [it, inserted] = mPending.insert_or_assign(productId, product); inserted) {
+        mDemotionQueue.push_back(productId);
+        mDemotionReady.notify_one();
+    }
+}
+
+void TieredProductCache::runDemotions(std::stop_token stopToken) {
+    std::vector<uint64_t> batchIds;
+    std::vector<uint64_t> demotedIds;
+    std::vector<std::shared_ptr<const Product>> products;
+
+    while (!stopToken.stop_requested()) {
+        {
+            std::unique_lock lock(mDemotionMutex);
+            if (!mDemotionReady.wait(lock, stopToken, [this] { return !mDemotionQueue.empty(); })) {
+                return;
+            }
+            const size_t batchSize = std::min(mDemotionQueue.size(), DEMOTION_BATCH_SIZE);
+            batchIds.assign(mDemotionQueue.begin(), mDemotionQueue.begin() + static_cast<std::ptrdiff_t>(batchSize));
+            mDemotionQueue.erase(mDemotionQueue.begin(), mDemotionQueue.begin() + static_cast<std::ptrdiff_t>(batchSize));
+            mWritingBatch = true;
+        }
+
+        demotedIds.clear();
+        products.clear();
+        {
+            std::scoped_lock lock(mDemotionMutex);
+            for (uint64_t productId : batchIds) {
+                if (const auto it = mPending.find(productId); it != mPending.end()) {
+                    demotedIds.push_back(productId);
+                    products.push_back(it->second);
+                }
+            }
+        }
+
+        // A promoted product keeps its disk copy, which puts and
+        // invalidations would have removed had it changed.
+        std::vector<std::shared_ptr<const Product>> toWrite;
+        toWrite.reserve(products.size());
+        for (size_t i = 0; i < products.size(); ++i) {
+            if (!mDiskTier.contains(demotedIds[i])) {
+                toWrite.push_back(products[i]);
+            }
+        }
+
+        try {
+            // Puts and invalidations remove a product from mPending before its
+            // disk copy, so one that ran while the batch was being written is
+            // seen here and its record is left unindexed; one that runs later
+            // erases the indexed record.
+            mDiskTier.append(toWrite, [this](const std::shared_ptr<const Product>& product) {
+                std::scoped_lock lock(mDemotionMutex);
+                const auto it = mPending.find(product->getId());
+                return it != mPending.end() && it->second == product;
+                });
+            mDemotions.increment(toWrite.size());
+        }
+        catch (const std::exception& e) {
+            mDroppedDemotions.increment(toWrite.size());
+            LOG_ERROR(LogCategory::CACHE, "Failed to demote {} products to disk: {}", toWrite.size(), e.what());
+        }
+
+        {
+            std::scoped_lock lock(mDemotionMutex);
+            for (size_t i = 0; i < demotedIds.size(); ++i) {
+                // A newer eviction of the same product stays queued under its own entry.
+                if (const auto it = mPending.find(demotedIds[i]); it != mPending.end() && it->second == products[i]) {
+                    mPending.erase(it);
+                }
+            }
+        }
+
+        try {
+            mDiskTier.compact();
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR(LogCategory::CACHE, "Disk tier compaction failed: {}", e.what());
+        }
+
+        {
+            std::scoped_lock lock(mDemotionMutex);
+            mWritingBatch = false;
+        }
+        mDemotionsDone.notify_all();
+    }
+}
+
+[[nodiscard]] std::shared_ptr<const Product> TieredProductCache::lookupLowerTiers(uint64_t productId) {
+    const uint64_t generation = mGeneration.load(std::memory_order_acquire);
+
+    std::shared_ptr<const Product> product;
+    {
+        std::scoped_lock lock(mDemotionMutex);
+        if (const auto it = mPending.find(productId); it != mPending.end()) {
+            product = it->second;
+        }
+    }
+    // Checked second: a product leaves the queue only once it is on disk.
+    if (!product) {
+        try {
+            product = mDiskTier.get(productId);
+        }
+        catch (const std::exception& e) {
+            LOG_ERROR(LogCategory::CACHE, "Failed to read Product ID: {} from disk: {}", productId, e.what());
+        }
+    }
+
+    if (!product) {
+        mMetrics.misses.increment();
+        return nullptr;
+    }
+
+    mMetrics.hits.increment();
+    mMemoryTier->putShared(productId, product);
+    if (mGeneration.load(std::memory_order_acquire) != generation) {
+        // Removed from the lower tiers while being promoted: do not keep the old copy.
+        mMemoryTier->invalidate(productId);
+    }
+    return product;
+}
+
+void TieredProductCache::dropLowerCopies(std::span<const uint64_t> productIds, std::unordered_set<uint64_t>* removedIds) {
+    bool removed = false;
+    const auto record = [&removed, removedIds](uint64_t productId) {
+        removed = true;
+        if (removedIds) {
+            removedIds->insert(productId);
+        }
+    };
+    {
+        std::scoped_lock lock(mDemotionMutex);
+        for (uint64_t productId : productIds) {
+            if (mPending.erase(productId) != 0) {
+                record(productId);
+            }
+        }
+    }
+    // Erased after mPending, so a demotion still writing one of these
+    // products either sees it gone or has already indexed the record erased here.
+    for (uint64_t productId : productIds) {
+        if (mDiskTier.erase(productId)) {
+            record(productId);
+        }
+    }
+    if (removed) {
+        mGeneration.fetch_add(1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,214 @@
+#include "TinyLfuProductCache.h"
+#include "Logger.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+TinyLfuProductCache::TinyLfuProductCache(size_t capacity)
+    : mCapacity{ capacity }
+    , mWindowCapacity{ std::max<size_t>(1, capacity / 100) }
+    , mMainCapacity{ capacity - std::min(capacity, mWindowCapacity) }
+    , mProtectedCapacity{ mMainCapacity * 8 / 10 }
+    , mSketch{ capacity }
+{
+    if (mCapacity == 0) {
+        LOG_ERROR(LogCategory::CACHE, "TinyLfuProductCache initialized with zero capacity.");
+        throw std::invalid_argument("Cache capacity must be greater than zero.");
+    }
+    mIndex.reserve(mCapacity);
+    LOG_INFO(LogCategory::CACHE, "TinyLfuProductCache initialized with capacity: {} (window {}, protected {})",
+        mCapacity, mWindowCapacity, mProtectedCapacity);
+}
+
+[[nodiscard]] std::optional<Product> TinyLfuProductCache::get(uint64_t productId) {
+    if (auto product = getShared(productId)) {
+        return *product;
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] std::shared_ptr<const Product> TinyLfuProductCache::getShared(uint64_t productId) {
+    ScopedLatency latency(mMetrics.getLatency);
+    std::scoped_lock lock(mCacheMutex);
+
+    LOG_INFO(LogCategory::CACHE, "Getting Product ID: {}", productId);
+
+    if (auto product = lookup(productId)) {
+        mMetrics.hits.increment();
+        LOG_INFO(LogCategory::CACHE, "Product ID: {} found.", productId);
+        return product;
+    }
+
+    mMetrics.misses.increment();
+    LOG_INFO(LogCategory::CACHE, "Product ID: {} not found.", productId);
+    return nullptr;
+}
+
+[[nodiscard]] std::vector<std::shared_ptr<const Product>> TinyLfuProductCache::getMany(std::span<const uint64_t> productIds) {
+    std::vector<std::shared_ptr<const Product>> products;
+    products.reserve(productIds.size());
+    size_t hits = 0;
+
+    std::scoped_lock lock(mCacheMutex);
+
+    for (uint64_t productId : productIds) {
+        products.push_back(lookup(productId));
+        if (products.back()) {
+            ++hits;
+        }
+    }
+
+    mMetrics.hits.increment(hits);
+    mMetrics.misses.increment(productIds.size() - hits);
+    LOG_INFO(LogCategory::CACHE, "Batch get of {} products: {} found.", productIds.size(), hits);
+    return products;
+}
+
+void TinyLfuProductCache::put(uint64_t productId, const Product& product) {
+    putShared(productId, std::make_shared<const Product>(product));
+}
+
+void TinyLfuProductCache::put(uint64_t productId, Product&& product) {
+    putShared(productId, std::make_shared<const Product>(std::move(product)));
+}
+
+void TinyLfuProductCache::putShared(uint64_t productId, std::shared_ptr<const Product> product) {
+    std::scoped_lock lock(mCacheMutex);
+
+    LOG_INFO(LogCategory::CACHE, "Putting Product ID: {}", productId);
+    mMetrics.puts.increment();
+
+    if (auto it = mIndex.find(productId); it != mIndex.end()) {
+        it->second->product = std::move(product);
+        onHit(it->second);
+        return;
+    }
+
+    mWindow.push_front(Entry{ productId, std::move(product), Segment::WINDOW });
+    mIndex[productId] = mWindow.begin();
+
+    if (mWindow.size() > mWindowCapacity) {
+        evictFromWindow();
+    }
+}
+
+bool TinyLfuProductCache::invalidate(uint64_t productId) {
+    return invalidateMany(std::span<const uint64_t>(&productId, 1)) != 0;
+}
+
+size_t TinyLfuProductCache::invalidateMany(std::span<const uint64_t> productIds) {
+    size_t removed = 0;
+    std::scoped_lock lock(mCacheMutex);
+
+    // The sketch keeps the product's frequency, so a hot product refetched after
+    // an update is admitted again straight away.
+    for (uint64_t productId : productIds) {
+        if (auto it = mIndex.find(productId); it != mIndex.end()) {
+            listFor(it->second->segment).erase(it->second);
+            mIndex.erase(it);
+            ++removed;
+        }
+    }
+
+    mMetrics.invalidations.increment(removed);
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} of {} products.", removed, productIds.size());
+    return removed;
+}
+
+size_t TinyLfuProductCache::invalidateIf(const std::function<bool(const uint64_t&, const Product&)>& predicate) {
+    size_t removed = 0;
+    std::scoped_lock lock(mCacheMutex);
+
+    for (auto it = mIndex.begin(); it != mIndex.end();) {
+        auto current = it++;
+        if (predicate(current->first, *current->second->product)) {
+            listFor(current->second->segment).erase(current->second);
+            mIndex.erase(current);
+            ++removed;
+        }
+    }
+
+    mMetrics.invalidations.increment(removed);
+    LOG_INFO(LogCategory::CACHE, "Invalidated {} products matching a predicate.", removed);
+    return removed;
+}
+
+[[nodiscard]] CacheMetricsSnapshot TinyLfuProductCache::getMetrics() const {
+    auto snapshot = mMetrics.snapshot();
+    std::scoped_lock lock(mCacheMutex);
+    snapshot.entries = mIndex.size();
+    return snapshot;
+}
+
+[[nodiscard]] std::shared_ptr<const Product> TinyLfuProductCache::lookup(uint64_t productId) {
+    // Misses count too: a product requested repeatedly earns admission once it is fetched.
+    mSketch.increment(productId);
+
+    if (auto it = mIndex.find(productId); it != mIndex.end()) {
+        onHit(it->second);
+        return it->second->product;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] TinyLfuProductCache::EntryList& TinyLfuProductCache::listFor(Segment segment) noexcept {
+    switch (segment) {
+    case Segment::WINDOW:    return mWindow;
+    case Segment::PROBATION: return mProbation;
+    default:                 return mProtected;
+    }
+}
+
+void TinyLfuProductCache::onHit(EntryList::iterator entry) {
+    if (entry->segment != Segment::PROBATION) {
+        auto& list = listFor(entry->segment);
+        list.splice(list.begin(), list, entry);
+        return;
+    }
+
+    // A second hit while on probation proves the entry is hot; make room in the
+    // protected segment by demoting its least recent entry back to probation.
+    entry->segment = Segment::PROTECTED;
+    mProtected.splice(mProtected.begin(), mProbation, entry);
+    if (mProtected.size() > mProtectedCapacity) {
+        auto demoted = std::prev(mProtected.end());
+        demoted->segment = Segment::PROBATION;
+        mProbation.splice(mProbation.begin(), mProtected, demoted);
+    }
+}
+
+void TinyLfuProductCache::evictFromWindow() {
+    auto candidate = std::prev(mWindow.end());
+
+    if (mProbation.size() + mProtected.size() < mMainCapacity) {
+        candidate->segment = Segment::PROBATION;
+        mProbation.splice(mProbation.begin(), mWindow, candidate);
+        return;
+    }
+
+    if (mMainCapacity == 0) {
+        evict(mWindow, candidate);
+        return;
+    }
+
+    auto& victimList = mProbation.empty() ? mProtected : mProbation;
+    auto victim = std::prev(victimList.end());
+
+    // Admission: the window's oldest entry replaces the main area's victim only if
+    // it has been requested more often; otherwise it is the one that leaves.
+    if (mSketch.frequency(candidate->productId) > mSketch.frequency(victim->productId)) {
+        evict(victimList, victim);
+        candidate->segment = Segment::PROBATION;
+        mProbation.splice(mProbation.begin(), mWindow, candidate);
+    }
+    else {
+        evict(mWindow, candidate);
+    }
+}
+
+void TinyLfuProductCache::evict(EntryList& list, EntryList::iterator entry) {
+    mMetrics.evictions.increment();
+    LOG_WARNING(LogCategory::CACHE, "Evicting Product ID: {}", entry->productId);
+    mIndex.erase(entry->productId);
+    list.erase(entry);
+}
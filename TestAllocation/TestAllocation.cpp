@@ -0,0 +1,15 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "Logger.h"
+
+// AllocationTest replaces the global allocation functions, so it runs in its
+// own executable and every other test keeps the normal allocator.
+int main(int argc, char** argv)
+{
+    Logger::initialize("TestAllocationOutput.log");
+    Logger::setLogLevel(LogLevel::INFO);
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ::testing::InitGoogleMock(&argc, argv);
+    return RUN_ALL_TESTS();
+}
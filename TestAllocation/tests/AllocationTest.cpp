@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "FakeDatabase.h"
+#include "ProductService.h"
+#include "SlabProductCache.h"
+#include "Logger.h"
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Counts global operator new calls made by the current thread, so the tests
+// below can assert how many allocations a code path performs. Every
+// replaceable non-aligned overload is replaced, so no allocation from the
+// library's defaults is freed by these; over-aligned ones keep the default pair.
+namespace {
+	thread_local uint64_t tAllocations = 0;
+
+	void* countedAllocate(std::size_t size) {
+		++tAllocations;
+		if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+			return memory;
+		}
+		throw std::bad_alloc();
+	}
+
+	template <typename Function>
+	uint64_t countAllocations(Function&& function) {
+		const uint64_t before = tAllocations;
+		function();
+		return tAllocations - before;
+	}
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return countedAllocate(size);
+	}
+	catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+
+class AllocationTest : public ::testing::Test {
+protected:
+	// Formatting log messages allocates; keep it out of the counts.
+	void SetUp() override {
+		Logger::setLogLevel(LogLevel::ERROR);
+	}
+
+	void TearDown() override {
+		Logger::setLogLevel(LogLevel::INFO);
+	}
+
+	static Product makeLargeProduct(uint64_t productId) {
+		return Product(productId, 101, "Product", "Description", std::vector<std::byte>(4096));
+	}
+};
+
+// Test case to verify the thumbnail view does not copy
+TEST_F(AllocationTest, TestThumbnailBytesDoNotAllocate) {
+	const Product product = makeLargeProduct(1);
+
+	size_t size = 0;
+	EXPECT_EQ(countAllocations([&] { size = product.getThumbnailBytes().size(); }), 0);
+	EXPECT_EQ(size, 4096);
+	EXPECT_EQ(countAllocations([&] { size = product.getThumbnail().size(); }), 1);
+}
+
+// Test case to verify putting an rvalue moves the product's blob into the cache
+TEST_F(AllocationTest, TestRvaluePutMovesIntoCache) {
+	SlabProductCache cache(4);
+	ICache<uint64_t, Product>& cacheInterface = cache;
+
+	Product copied = makeLargeProduct(1);
+	Product moved = makeLargeProduct(2);
+	Product movedThroughInterface = makeLargeProduct(3);
+
+	// The shared handle is the only allocation left once the blob is moved.
+	EXPECT_EQ(countAllocations([&] { cache.put(1, copied); }), 2);
+	EXPECT_EQ(countAllocations([&] { cache.put(2, std::move(moved)); }), 1);
+	EXPECT_EQ(countAllocations([&] { cacheInterface.put(3, std::move(movedThroughInterface)); }), 1);
+	EXPECT_EQ(cache.getShared(2)->getThumbnailBytes().size(), 4096);
+}
+
+// Test case to verify a cached product reaches the client without allocating
+TEST_F(AllocationTest, TestDatabaseToCacheToClientPath) {
+	auto database = std::make_shared<FakeDatabase>();
+	auto cache = std::make_shared<SlabProductCache>(16);
+	ProductService service{ cache, database };
+
+	// Catalog products fit inline, so fetching one is a plain copy.
+	EXPECT_EQ(countAllocations([&] { EXPECT_TRUE(database->fetchProductDetails(7).has_value()); }), 0);
+
+	ASSERT_TRUE(service.getProductDetailsShared(7));
+
+	EXPECT_EQ(countAllocations([&] { EXPECT_TRUE(service.getProductDetailsShared(7)); }), 0);
+	EXPECT_EQ(countAllocations([&] { EXPECT_TRUE(service.getProductDetails(7).has_value()); }), 0);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "CategoryCountCache.h"
+#include "TestClock.h"
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+// Test case to verify zero capacity is rejected
+TEST(CategoryCountCacheTest, TestZeroCapacityThrows) {
+	EXPECT_THROW(CategoryCountCache(0, std::chrono::milliseconds(100)), std::invalid_argument);
+}
+
+// Test case to verify counts are evicted least recently used first
+TEST(CategoryCountCacheTest, TestLeastRecentlyUsedEviction) {
+	CategoryCountCache counts(2, std::chrono::milliseconds::zero());
+	counts.put(100, 10);
+	counts.put(101, 11);
+	ASSERT_EQ(counts.get(100), 10);
+
+	counts.put(102, 12);
+	EXPECT_EQ(counts.get(100), 10);
+	EXPECT_FALSE(counts.get(101).has_value());
+	EXPECT_EQ(counts.get(102), 12);
+	EXPECT_EQ(counts.getMetrics().evictions, 1);
+}
+
+// Test case to verify counts expire after the time to live and can be invalidated
+TEST(CategoryCountCacheTest, TestExpiryAndInvalidation) {
+	const ScopedManualClock manualClock;
+	CategoryCountCache counts(8, std::chrono::milliseconds(100));
+	counts.put(100, 10);
+	counts.put(101, 11);
+	counts.put(102, 12);
+
+	const std::vector<uint32_t> changed{ 101, 103 };
+	EXPECT_EQ(counts.invalidateMany(changed), 1);
+	EXPECT_FALSE(counts.get(101).has_value());
+
+	CoarseClock::advance(std::chrono::milliseconds(150));
+	EXPECT_FALSE(counts.get(100).has_value());
+	EXPECT_EQ(counts.getSize(), 1) << "Expired counts are dropped when looked up.";
+
+	auto metrics = counts.getMetrics();
+	EXPECT_EQ(metrics.invalidations, 1);
+	EXPECT_EQ(metrics.expirations, 1);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "ClockProductCache.h"
+#include "ShardedProductCache.h"
+#include "Logger.h"
+#include "TestProducts.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ClockProductCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		cache = std::make_shared<ClockProductCache>(3);
+	}
+
+	std::shared_ptr<ClockProductCache> cache;
+};
+
+// Test case to verify zero capacity is rejected
+TEST_F(ClockProductCacheTest, TestZeroCapacityThrows) {
+	EXPECT_THROW(ClockProductCache(0), std::invalid_argument);
+}
+
+// Test case to verify adding and fetching a product
+TEST_F(ClockProductCacheTest, TestPutAndGet) {
+	cache->put(1, makeProduct(1));
+
+	auto fetchedProduct = cache->get(1);
+	ASSERT_TRUE(fetchedProduct.has_value());
+	EXPECT_EQ(fetchedProduct->getId(), 1);
+	EXPECT_FALSE(cache->get(2).has_value());
+}
+
+// Test case to verify putting an existing ID replaces the product without evicting
+TEST_F(ClockProductCacheTest, TestPutOverwritesExisting) {
+	cache->put(1, makeProduct(1));
+	cache->put(2, makeProduct(2));
+	cache->put(1, Product(1, 102, "Renamed", "Updated", {}));
+	cache->put(3, makeProduct(3));
+
+	auto fetchedProduct = cache->get(1);
+	ASSERT_TRUE(fetchedProduct.has_value());
+	EXPECT_EQ(fetchedProduct->getName(), "Renamed");
+	EXPECT_TRUE(cache->get(2).has_value());
+	EXPECT_TRUE(cache->get(3).has_value());
+}
+
+// Test case to verify a referenced entry gets a second chance while an unreferenced one is evicted
+TEST_F(ClockProductCacheTest, TestReferencedEntrySurvivesEviction) {
+	cache->put(1, makeProduct(1));
+	cache->put(2, makeProduct(2));
+	cache->put(3, makeProduct(3));
+
+	ASSERT_TRUE(cache->get(1).has_value());
+	cache->put(4, makeProduct(4));
+
+	EXPECT_TRUE(cache->get(1).has_value()) << "Recently read product should survive the clock sweep.";
+	EXPECT_FALSE(cache->get(2).has_value()) << "Unreferenced product should have been evicted.";
+	EXPECT_TRUE(cache->get(4).has_value());
+}
+
+// Test case to verify the cache never holds more than its capacity
+TEST_F(ClockProductCacheTest, TestCacheCapacity) {
+	for (uint64_t i = 1; i <= 10; ++i) {
+		cache->put(i, makeProduct(i));
+	}
+
+	size_t cached = 0;
+	for (uint64_t i = 1; i <= 10; ++i) {
+		cached += cache->get(i).has_value() ? 1 : 0;
+	}
+	EXPECT_EQ(cached, 3);
+	EXPECT_TRUE(cache->get(10).has_value());
+}
+
+// Test case to verify concurrent readers and a writer using jthread
+TEST_F(ClockProductCacheTest, ThreadSafetyWithJThread) {
+	ClockProductCache shared(16);
+	for (uint64_t i = 0; i < 16; ++i) {
+		shared.put(i, makeProduct(i));
+	}
+
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < 4; ++t) {
+			threads.emplace_back([&shared] {
+				for (uint64_t i = 0; i < 200; ++i) {
+					if (auto product = shared.get(i % 32)) {
+						EXPECT_EQ(product->getId(), i % 32);
+					}
+				}
+				});
+		}
+		threads.emplace_back([&shared] {
+			for (uint64_t i = 16; i < 32; ++i) {
+				shared.put(i, makeProduct(i));
+			}
+			});
+	}
+
+	EXPECT_TRUE(shared.get(31).has_value());
+}
+
+// Test case to verify the sharded cache can be built from CLOCK shards
+TEST_F(ClockProductCacheTest, TestShardedClockMode) {
+	ShardedProductCache sharded(64, 4, EvictionMode::CLOCK);
+	EXPECT_EQ(sharded.getEvictionMode(), EvictionMode::CLOCK);
+
+	for (uint64_t i = 1; i <= 32; ++i) {
+		sharded.put(i, makeProduct(i));
+	}
+	for (uint64_t i = 1; i <= 32; ++i) {
+		auto product = sharded.get(i);
+		ASSERT_TRUE(product.has_value());
+		EXPECT_EQ(product->getId(), i);
+	}
+}
+
+// Test case to verify an invalidated slot is reused before the clock hand evicts anything
+TEST_F(ClockProductCacheTest, TestInvalidateFreesSlot) {
+	for (uint64_t i = 1; i <= 3; ++i) {
+		cache->put(i, makeProduct(i));
+	}
+
+	EXPECT_TRUE(cache->invalidate(2));
+	EXPECT_FALSE(cache->get(2).has_value());
+
+	cache->put(4, makeProduct(4));
+	EXPECT_TRUE(cache->get(1).has_value());
+	EXPECT_TRUE(cache->get(3).has_value());
+	EXPECT_TRUE(cache->get(4).has_value());
+
+	auto metrics = cache->getMetrics();
+	EXPECT_EQ(metrics.evictions, 0);
+	EXPECT_EQ(metrics.invalidations, 1);
+	EXPECT_EQ(metrics.entries, 3);
+}
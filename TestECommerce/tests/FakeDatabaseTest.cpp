@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <span>
+#include <vector>
 #include "FakeDatabase.h"
 #include "Logger.h"
 
@@ -32,6 +34,15 @@ TEST_F(FakeDatabaseTest, FetchProductDetails_InvalidId) {
         << "Product with ID " << invalidId << " should not exist.";
 }
 
+// Test case to verify a prehashed ID finds the same product as a plain one
+TEST_F(FakeDatabaseTest, FetchProductDetails_PrehashedId) {
+    const Prehashed<uint64_t> productId(42);
+    auto product = fakeDatabase->fetchProductDetails(productId);
+    ASSERT_TRUE(product.has_value());
+    EXPECT_EQ(product->getId(), 42);
+    EXPECT_FALSE(fakeDatabase->fetchProductDetails(Prehashed<uint64_t>(9999)).has_value());
+}
+
 // Test case to verify counting products by category (valid category)
 TEST_F(FakeDatabaseTest, FetchProductCountByCategory_ValidCategory) {
     constexpr uint32_t categoryId = 101;
@@ -45,3 +56,83 @@ TEST_F(FakeDatabaseTest, FetchProductCountByCategory_InvalidCategory) {
     auto count = fakeDatabase->fetchProductCountByCategory(invalidCategoryId);
     EXPECT_EQ(count, 0) << "Category " << invalidCategoryId << " should be empty.";
 }
+
+// Test case to verify a batch fetch returns one result per ID, in order
+TEST_F(FakeDatabaseTest, FetchProductDetailsBatch_MixedIds) {
+    const std::vector<uint64_t> productIds{ 3, 9999, 1, 3 };
+    auto products = fakeDatabase->fetchProductDetailsBatch(productIds);
+
+    ASSERT_EQ(products.size(), productIds.size());
+    ASSERT_TRUE(products[0].has_value());
+    EXPECT_EQ(products[0]->getId(), 3);
+    EXPECT_FALSE(products[1].has_value());
+    ASSERT_TRUE(products[2].has_value());
+    EXPECT_EQ(products[2]->getName(), "Product 1");
+    ASSERT_TRUE(products[3].has_value());
+    EXPECT_EQ(products[3]->getId(), 3);
+}
+
+// Test case to verify simulated writes change the catalog and notify listeners once per batch
+TEST_F(FakeDatabaseTest, ChangeListener_NotifiedPerBatch) {
+    std::vector<std::vector<ProductChange>> batches;
+    const uint64_t subscriptionId = fakeDatabase->subscribe([&batches](std::span<const ProductChange> changes) {
+        batches.emplace_back(changes.begin(), changes.end());
+        });
+
+    const std::vector<Product> updates{
+        Product(1, 101, "Renamed 1", "Description", {}),
+        Product(2, 102, "Renamed 2", "Description", {})
+    };
+    fakeDatabase->updateProducts(updates);
+    const std::vector<uint64_t> removed{ 3, 9999 };
+    fakeDatabase->removeProducts(removed);
+
+    EXPECT_EQ(fakeDatabase->fetchProductDetails(1)->getName(), "Renamed 1");
+    EXPECT_FALSE(fakeDatabase->fetchProductDetails(3).has_value());
+
+    ASSERT_EQ(batches.size(), 2);
+    ASSERT_EQ(batches[0].size(), 2);
+    EXPECT_EQ(batches[0][1].productId, 2);
+    EXPECT_EQ(batches[0][1].kind, ProductChange::Kind::UPDATED);
+    ASSERT_EQ(batches[1].size(), 1) << "Removing a missing product is not a change.";
+    EXPECT_EQ(batches[1][0].productId, 3);
+    EXPECT_EQ(batches[1][0].kind, ProductChange::Kind::REMOVED);
+
+    fakeDatabase->unsubscribe(subscriptionId);
+    fakeDatabase->removeProducts(std::vector<uint64_t>{ 4 });
+    EXPECT_EQ(batches.size(), 2);
+}
+
+// Test case to verify a category listing is paged in ascending ID order
+TEST_F(FakeDatabaseTest, FetchProductsByCategory_Paged) {
+    FakeDatabase smallDatabase(30);
+    EXPECT_EQ(smallDatabase.fetchProductCountByCategory(101), 10);
+
+    // Category 101 holds IDs 1, 4, 7, ...; the second page of four starts at 13.
+    auto page = smallDatabase.fetchProductsByCategory(101, 4, 4);
+    ASSERT_EQ(page.size(), 4);
+    EXPECT_EQ(page[0].getId(), 13);
+    EXPECT_EQ(page[3].getId(), 22);
+
+    EXPECT_EQ(smallDatabase.fetchProductsByCategory(101, 8, 4).size(), 2);
+    EXPECT_TRUE(smallDatabase.fetchProductsByCategory(101, 10, 4).empty());
+    EXPECT_TRUE(smallDatabase.fetchProductsByCategory(999, 0, 4).empty());
+}
+
+// Test case to verify the category index follows updates, category moves and removals
+TEST_F(FakeDatabaseTest, CategoryIndex_FollowsWrites) {
+    FakeDatabase smallDatabase(30);
+
+    // Product 1 moves from category 101 to 100, and product 31 is new in 101.
+    smallDatabase.updateProducts(std::vector{
+        Product(1, 100, "Moved", "Description", {}),
+        Product(31, 101, "New", "Description", {}) });
+    EXPECT_EQ(smallDatabase.fetchProductCountByCategory(100), 11);
+    EXPECT_EQ(smallDatabase.fetchProductCountByCategory(101), 10);
+    EXPECT_EQ(smallDatabase.fetchProductsByCategory(100, 0, 1)[0].getId(), 1);
+    EXPECT_EQ(smallDatabase.fetchProductsByCategory(101, 9, 1)[0].getId(), 31);
+
+    smallDatabase.removeProducts(std::vector<uint64_t>{ 1, 3 });
+    EXPECT_EQ(smallDatabase.fetchProductCountByCategory(100), 9);
+    EXPECT_EQ(smallDatabase.fetchProductsByCategory(100, 0, 1)[0].getId(), 6);
+}
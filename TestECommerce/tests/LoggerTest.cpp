@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "Logger.h"
+#include "LogRingBuffer.h"
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	LogRecord makeRecord(std::string_view message) {
+		LogRecord record{ std::chrono::system_clock::now(), LogLevel::INFO, LogCategory::GENERAL };
+		record.setMessage(message);
+		return record;
+	}
+
+	size_t countOccurrences(const std::string& contents, const std::string& marker) {
+		size_t occurrences = 0;
+		for (auto position = contents.find(marker); position != std::string::npos; position = contents.find(marker, position + marker.size())) {
+			++occurrences;
+		}
+		return occurrences;
+	}
+}
+
+// Test fixture for the async logger: each test writes to its own log file,
+// truncated first, so it only scans its own records.
+class AsyncLoggerTest : public ::testing::Test {
+protected:
+	static constexpr const char* logFileName = "AsyncLoggerTest.log";
+
+	void SetUp() override {
+		std::ofstream(logFileName, std::ios::trunc);
+		Logger::initialize(logFileName);
+	}
+
+	void TearDown() override {
+		Logger::shutdown();
+		// The file TestECommerce.cpp's main() logs to
+		Logger::initialize("TestOutput.log");
+	}
+
+	static std::string readLog() {
+		std::ifstream logFile(logFileName);
+		return { std::istreambuf_iterator<char>(logFile), std::istreambuf_iterator<char>() };
+	}
+};
+
+// Test case to verify records come out of the ring buffer in FIFO order
+TEST(LogRingBufferTest, TestPushPopOrder) {
+	LogRingBuffer queue(4);
+	ASSERT_TRUE(queue.tryPush(makeRecord("first")));
+	ASSERT_TRUE(queue.tryPush(makeRecord("second")));
+
+	LogRecord record{};
+	ASSERT_TRUE(queue.tryPop(record));
+	EXPECT_EQ(record.getMessage(), "first");
+	ASSERT_TRUE(queue.tryPop(record));
+	EXPECT_EQ(record.getMessage(), "second");
+	EXPECT_FALSE(queue.tryPop(record));
+}
+
+// Test case to verify a full ring buffer rejects pushes until a slot is freed
+TEST(LogRingBufferTest, TestFullQueueRejectsPush) {
+	LogRingBuffer queue(3);
+	ASSERT_EQ(queue.getCapacity(), 4);
+
+	for (int i = 0; i < 4; ++i) {
+		ASSERT_TRUE(queue.tryPush(makeRecord("record")));
+	}
+	EXPECT_FALSE(queue.tryPush(makeRecord("overflow")));
+
+	LogRecord record{};
+	ASSERT_TRUE(queue.tryPop(record));
+	EXPECT_TRUE(queue.tryPush(makeRecord("fits again")));
+}
+
+// Test case to verify long messages are truncated to the fixed record size
+TEST(LogRingBufferTest, TestLongMessageIsTruncated) {
+	auto record = makeRecord(std::string(1000, 'x'));
+	EXPECT_EQ(record.getMessage().size(), LogRecord::MAX_MESSAGE_LENGTH);
+}
+
+// Test case to verify the async logger writes every record from several threads before shutdown returns
+TEST_F(AsyncLoggerTest, TestAsyncLoggingDrainsOnShutdown) {
+	constexpr int threadCount = 4;
+	constexpr int messagesPerThread = 50;
+	const std::string marker = "async-drain-test";
+
+	Logger::enableAsync(1024, LogOverflowPolicy::BLOCK);
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&marker, t] {
+				for (int i = 0; i < messagesPerThread; ++i) {
+					Logger::log(LogLevel::INFO, LogCategory::GENERAL, marker + " " + std::to_string(t) + ":" + std::to_string(i));
+				}
+			});
+		}
+	}
+	Logger::shutdown();
+
+	const std::string contents = readLog();
+	EXPECT_EQ(countOccurrences(contents, marker), threadCount * messagesPerThread);
+}
+
+// Test case to verify records logged while shutdown runs, and after async logging is enabled again, are all written
+TEST_F(AsyncLoggerTest, TestShutdownRacingProducersLosesNothing) {
+	constexpr int threadCount = 4;
+	constexpr int messagesPerThread = 200;
+	const std::string marker = "async-race-test";
+
+	Logger::enableAsync(16, LogOverflowPolicy::BLOCK);
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&marker, t] {
+				for (int i = 0; i < messagesPerThread; ++i) {
+					Logger::log(LogLevel::INFO, LogCategory::GENERAL, marker + " " + std::to_string(t) + ":" + std::to_string(i));
+				}
+			});
+		}
+		Logger::shutdown();
+		Logger::enableAsync(16, LogOverflowPolicy::BLOCK);
+	}
+	Logger::shutdown();
+
+	const std::string contents = readLog();
+	EXPECT_EQ(countOccurrences(contents, marker), threadCount * messagesPerThread);
+}
+
+// Test case to verify a disabled LOG_* statement does not evaluate its format arguments
+TEST(LoggerTest, TestDisabledLevelSkipsArgumentEvaluation) {
+	int evaluations = 0;
+	auto expensiveArgument = [&evaluations] {
+		++evaluations;
+		return 42;
+	};
+
+	Logger::setLogLevel(LogLevel::ERROR);
+	LOG_INFO(LogCategory::GENERAL, "disabled statement {}", expensiveArgument());
+	LOG_WARNING(LogCategory::GENERAL, "disabled statement {}", expensiveArgument());
+	EXPECT_EQ(evaluations, 0);
+	EXPECT_FALSE(Logger::isEnabled(LogLevel::INFO));
+
+	LOG_ERROR(LogCategory::GENERAL, "enabled statement {}", expensiveArgument());
+	EXPECT_EQ(evaluations, 1);
+
+	Logger::setLogLevel(LogLevel::INFO);
+	EXPECT_TRUE(Logger::isEnabled(LogLevel::INFO));
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include "LruCache.h"
+#include "TestClock.h"
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Weighs a string value by its length.
+	struct StringLength {
+		size_t operator()(const std::string&, const std::string& value) const noexcept {
+			return value.size();
+		}
+	};
+}
+
+// Test case to verify a hit protects an entry from eviction under the LRU policy
+TEST(LruCacheTest, TestLruEvictsLeastRecentlyUsed) {
+	LruCache<uint64_t, int, std::hash<uint64_t>, LruEviction, NoLocking> cache(2);
+	cache.put(1, 10);
+	cache.put(2, 20);
+	EXPECT_EQ(cache.get(uint64_t{ 1 }), 10);
+	cache.put(3, 30);
+
+	EXPECT_TRUE(cache.get(uint64_t{ 1 }).has_value());
+	EXPECT_FALSE(cache.get(uint64_t{ 2 }).has_value());
+	EXPECT_TRUE(cache.get(uint64_t{ 3 }).has_value());
+	EXPECT_EQ(cache.getMetrics().evictions, 1);
+}
+
+// Test case to verify the FIFO policy evicts in insertion order regardless of hits
+TEST(LruCacheTest, TestFifoEvictsOldestInsert) {
+	LruCache<uint64_t, int, std::hash<uint64_t>, FifoEviction, NoLocking> cache(2);
+	cache.put(1, 10);
+	cache.put(2, 20);
+	EXPECT_EQ(cache.get(uint64_t{ 1 }), 10);
+	cache.put(3, 30);
+
+	EXPECT_FALSE(cache.get(uint64_t{ 1 }).has_value());
+	EXPECT_TRUE(cache.get(uint64_t{ 2 }).has_value());
+	EXPECT_TRUE(cache.get(uint64_t{ 3 }).has_value());
+}
+
+// Test case to verify string keys and a custom size function bound the total weight
+TEST(LruCacheTest, TestWeightLimitAndRejection) {
+	LruCache<std::string, std::string, std::hash<std::string>, LruEviction, MutexLocking, StringLength> cache(
+		LruLimits{ .maxWeight = 10, .maxEntryWeight = 8 });
+	cache.put("a", "aaaa");
+	cache.put("b", "bbbb");
+	cache.put("c", "cccc");
+
+	EXPECT_FALSE(cache.get("a").has_value());
+	EXPECT_EQ(cache.get("b"), "bbbb");
+	EXPECT_EQ(cache.getWeight(), 8);
+
+	// Too heavy to cache; the older copy is dropped rather than served stale.
+	EXPECT_FALSE(cache.put("b", std::string(9, 'x')));
+	EXPECT_FALSE(cache.get("b").has_value());
+	EXPECT_EQ(cache.getWeight(), 4);
+	EXPECT_EQ(cache.getMetrics().rejections, 1);
+}
+
+// Test case to verify entries expire after their time to live and make room for free
+TEST(LruCacheTest, TestTimeToLive) {
+	const ScopedManualClock manualClock;
+	LruCache<uint64_t, int> cache(2);
+	cache.put(1, 10, std::chrono::milliseconds(100));
+	cache.put(2, 20);
+
+	CoarseClock::advance(std::chrono::milliseconds(150));
+	cache.put(3, 30);
+	EXPECT_FALSE(cache.get(uint64_t{ 1 }).has_value());
+	EXPECT_TRUE(cache.get(uint64_t{ 2 }).has_value());
+	EXPECT_EQ(cache.getMetrics().expirations, 1);
+	EXPECT_EQ(cache.getMetrics().evictions, 0);
+
+	const auto timed = cache.getTimed(uint64_t{ 3 });
+	ASSERT_TRUE(timed.has_value());
+	EXPECT_EQ(timed->first, 30);
+	EXPECT_EQ(timed->second, CoarseClock::now());
+}
+
+// Test case to verify the eviction listener, predicate invalidation and batch gets
+TEST(LruCacheTest, TestListenerInvalidationAndBatchGet) {
+	LruCache<uint64_t, int> cache(3);
+	std::vector<std::pair<uint64_t, int>> evicted;
+	cache.setEvictionListener([&evicted](const uint64_t& key, const int& value) { evicted.emplace_back(key, value); });
+	for (uint64_t key = 1; key <= 5; ++key) {
+		cache.put(key, static_cast<int>(key) * 10);
+	}
+	EXPECT_EQ(evicted, (std::vector<std::pair<uint64_t, int>>{ { 1, 10 }, { 2, 20 } }));
+
+	EXPECT_EQ(cache.invalidateIf([](const uint64_t&, const int& value) { return value == 40; }), 1);
+	const std::vector<uint64_t> keys{ 3, 4, 5, 6 };
+	std::vector<int> values(keys.size());
+	EXPECT_EQ(cache.getMany(keys, [&values](size_t position, const int* value) { values[position] = value ? *value : -1; }), 2);
+	EXPECT_EQ(values, (std::vector<int>{ 30, -1, 50, -1 }));
+	EXPECT_EQ(evicted.size(), 2) << "Invalidated entries are not reported as evicted.";
+}
+
+// Test case to verify appended entries go behind the cached ones without evicting them
+TEST(LruCacheTest, TestAppendColdFillsRemainingRoom) {
+	LruCache<uint64_t, int> cache(3);
+	cache.put(1, 100);
+	const std::vector<int> values{ 10, 20, 30, 40 };
+
+	EXPECT_EQ(cache.appendCold(values, [](const int& value) { return static_cast<uint64_t>(value / 10); }), 2);
+	EXPECT_EQ(cache.getSize(), 3);
+	EXPECT_EQ(cache.get(uint64_t{ 1 }), 100);
+	EXPECT_FALSE(cache.get(uint64_t{ 4 }).has_value());
+
+	// Appended in order, so 3 is the coldest entry.
+	cache.put(5, 50);
+	EXPECT_FALSE(cache.get(uint64_t{ 3 }).has_value());
+	EXPECT_TRUE(cache.get(uint64_t{ 2 }).has_value());
+}
+
+// Test case to verify a value too heavy for the remaining room is skipped without dropping lighter ones after it
+TEST(LruCacheTest, TestAppendColdSkipsValueOverRemainingWeight) {
+	LruCache<std::string, std::string, std::hash<std::string>, LruEviction, NoLocking, StringLength> cache(LruLimits{ .maxWeight = 10 });
+	cache.put("aaaaaa", "aaaaaa");
+	const std::vector<std::string> values{ "bbbbbb", "cc", "dd", "eeeeeeeeeeee" };
+
+	EXPECT_EQ(cache.appendCold(values, [](const std::string& value) -> const std::string& { return value; }), 2);
+	EXPECT_FALSE(cache.get("bbbbbb").has_value());
+	EXPECT_TRUE(cache.get("cc").has_value());
+	EXPECT_TRUE(cache.get("dd").has_value());
+	EXPECT_EQ(cache.getWeight(), 10);
+}
+
+// Test case to verify sharded caches stay within their per-shard limits under concurrent puts
+TEST(LruCacheTest, TestShardedConcurrentPuts) {
+	LruCache<uint64_t, uint64_t, std::hash<uint64_t>, LruEviction, ShardedLocking<4>> cache(64);
+	std::vector<std::jthread> threads;
+	for (uint64_t threadIndex = 0; threadIndex < 4; ++threadIndex) {
+		threads.emplace_back([&cache, threadIndex] {
+			for (uint64_t key = threadIndex * 1000; key < (threadIndex + 1) * 1000; ++key) {
+				cache.put(key, key * 2);
+				// Another thread may already have evicted the key from its shard
+				if (auto value = cache.get(key)) {
+					EXPECT_EQ(*value, key * 2);
+				}
+			}
+			});
+	}
+	threads.clear();
+
+	EXPECT_LE(cache.getSize(), 64);
+	const auto metrics = cache.getMetrics();
+	EXPECT_EQ(metrics.puts, 4000);
+	EXPECT_EQ(metrics.evictions, 4000 - cache.getSize());
+}
+
+// Test case to verify a sharded batch get reports every key at its own position
+TEST(LruCacheTest, TestShardedBatchGet) {
+	LruCache<uint64_t, uint64_t, std::hash<uint64_t>, LruEviction, ShardedLocking<4>> cache(64);
+	for (uint64_t key = 0; key < 32; key += 2) {
+		cache.put(key, key * 10);
+	}
+
+	std::vector<uint64_t> keys(32);
+	std::iota(keys.begin(), keys.end(), uint64_t{ 0 });
+	std::vector<int64_t> values(keys.size(), -2);
+	EXPECT_EQ(cache.getMany(keys, [&values](size_t position, const uint64_t* value) {
+		values[position] = value ? static_cast<int64_t>(*value) : -1;
+		}), 16);
+	for (uint64_t key = 0; key < 32; ++key) {
+		EXPECT_EQ(values[key], key % 2 == 0 ? static_cast<int64_t>(key * 10) : -1) << "Key " << key;
+	}
+}
+
+// Test case to verify an entry heavier than a shard's share of the weight is rejected without evicting anything
+TEST(LruCacheTest, TestShardedRejectsEntryOverShardWeight) {
+	LruCache<std::string, std::string, std::hash<std::string>, LruEviction, ShardedLocking<4>, StringLength> cache(
+		LruLimits{ .maxWeight = 16 });
+	std::vector<std::string> evicted;
+	cache.setEvictionListener([&evicted](const std::string& key, const std::string&) { evicted.push_back(key); });
+	for (char key = 'a'; key <= 'h'; ++key) {
+		cache.put(std::string(1, key), "x");
+	}
+	const size_t size = cache.getSize();
+
+	// 5 fits the global limit of 16 but not a shard's 4.
+	EXPECT_FALSE(cache.put("heavy", "xxxxx"));
+	EXPECT_FALSE(cache.get("heavy").has_value());
+	EXPECT_EQ(cache.getSize(), size);
+	EXPECT_TRUE(evicted.empty());
+	EXPECT_EQ(cache.getMetrics().rejections, 1);
+	EXPECT_TRUE(cache.put("fits", "xxxx"));
+}
+
+// Test case to verify a string-keyed cache is probed by string_view and by a prehashed key
+TEST(LruCacheTest, TestHeterogeneousAndPrehashedLookup) {
+	LruCache<std::string, int, StringHash, LruEviction, ShardedLocking<4>> cache(8);
+	cache.put("SKU-1", 1);
+	cache.put("SKU-2", 2);
+
+	constexpr std::string_view sku = "SKU-1";
+	EXPECT_EQ(cache.get(sku), 1);
+	const auto prehashed = cache.prehash(std::string_view("SKU-2"));
+	EXPECT_EQ(prehashed.hash, StringHash{}("SKU-2"));
+	EXPECT_EQ(cache.get(prehashed), 2);
+	EXPECT_FALSE(cache.get(std::string_view("SKU-3")).has_value());
+
+	EXPECT_TRUE(cache.invalidate(prehashed));
+	EXPECT_FALSE(cache.getTimed(std::string_view("SKU-2")).has_value());
+	EXPECT_EQ(cache.getMetrics().invalidations, 1);
+}
+
+// Test case to verify zero limits are rejected
+TEST(LruCacheTest, TestZeroLimitsThrow) {
+	EXPECT_THROW((LruCache<uint64_t, int>(0)), std::invalid_argument);
+	EXPECT_THROW((LruCache<uint64_t, int>(LruLimits{ .maxWeight = 0 })), std::invalid_argument);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "FakeDatabase.h"
+#include "MappedProductDatabase.h"
+#include "MappedProductFormat.h"
+#include "MappedProductWriter.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class MappedProductDatabaseTest : public ::testing::Test {
+protected:
+	static constexpr size_t PRODUCT_COUNT = 300;
+
+	void SetUp() override {
+		path = std::filesystem::temp_directory_path() /
+			("MappedProductDatabaseTest_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".db");
+	}
+
+	void TearDown() override {
+		std::error_code error;
+		std::filesystem::remove(path, error);
+	}
+
+	void writeGeneratedStore(size_t productCount) {
+		MappedProductWriter writer(path);
+		FakeDatabase::generateProducts(productCount, [&writer](const FakeDatabase::GeneratedProduct& product) {
+			writer.add(product.id, product.category, product.name, product.description, product.thumbnail);
+			});
+		writer.finish();
+	}
+
+	std::filesystem::path path;
+};
+
+// Test case to verify every product reads back exactly as FakeDatabase generates it
+TEST_F(MappedProductDatabaseTest, TestRoundTripMatchesFakeDatabase) {
+	writeGeneratedStore(PRODUCT_COUNT);
+	FakeDatabase fakeDatabase(PRODUCT_COUNT);
+	MappedProductDatabase database(path);
+
+	ASSERT_EQ(database.getProductCount(), PRODUCT_COUNT);
+	for (uint64_t productId = 1; productId <= PRODUCT_COUNT; ++productId) {
+		auto expected = fakeDatabase.fetchProductDetails(productId);
+		auto product = database.fetchProductDetails(productId);
+		ASSERT_TRUE(product.has_value()) << "Product " << productId << " is missing.";
+		EXPECT_EQ(*product, *expected);
+	}
+	EXPECT_FALSE(database.fetchProductDetails(0).has_value());
+	EXPECT_FALSE(database.fetchProductDetails(PRODUCT_COUNT + 1).has_value());
+}
+
+// Test case to verify a batch fetch returns one result per ID, in order
+TEST_F(MappedProductDatabaseTest, TestBatchFetch) {
+	writeGeneratedStore(PRODUCT_COUNT);
+	MappedProductDatabase database(path);
+
+	const std::vector<uint64_t> productIds{ 3, 9999, 1, 3 };
+	auto products = database.fetchProductDetailsBatch(productIds);
+
+	ASSERT_EQ(products.size(), productIds.size());
+	ASSERT_TRUE(products[0].has_value());
+	EXPECT_EQ(products[0]->getId(), 3);
+	EXPECT_FALSE(products[1].has_value());
+	ASSERT_TRUE(products[2].has_value());
+	EXPECT_EQ(products[2]->getId(), 1);
+	ASSERT_TRUE(products[3].has_value());
+	EXPECT_EQ(products[3]->getId(), 3);
+}
+
+// Test case to verify category counts and pages match FakeDatabase
+TEST_F(MappedProductDatabaseTest, TestCategoryCountsAndPages) {
+	writeGeneratedStore(PRODUCT_COUNT);
+	FakeDatabase fakeDatabase(PRODUCT_COUNT);
+	MappedProductDatabase database(path);
+
+	for (uint32_t categoryId : { 99u, 100u, 101u, 102u, 103u }) {
+		EXPECT_EQ(database.fetchProductCountByCategory(categoryId), fakeDatabase.fetchProductCountByCategory(categoryId));
+	}
+	for (size_t offset : { size_t{ 0 }, size_t{ 37 }, size_t{ 95 }, size_t{ 100 }, size_t{ 500 } }) {
+		EXPECT_EQ(database.fetchProductsByCategory(101, offset, 10), fakeDatabase.fetchProductsByCategory(101, offset, 10))
+			<< "Page at offset " << offset << " differs.";
+	}
+	EXPECT_TRUE(database.fetchProductsByCategory(999, 0, 10).empty());
+}
+
+// Test case to verify sparse IDs, unordered categories and large fields are stored as given
+TEST_F(MappedProductDatabaseTest, TestSparseIdsAndLargeFields) {
+	const std::string description(10'000, 'd');
+	const std::vector<std::byte> thumbnail(5'000, std::byte{ 7 });
+	{
+		MappedProductWriter writer(path);
+		writer.add(Product(10, 7, "Ten", description, thumbnail));
+		writer.add(Product(1'000'000'000'000, 3, "Trillion", "", {}));
+		writer.add(Product(1'000'000'000'001, 7, "", "Next", thumbnail));
+		writer.finish();
+	}
+	MappedProductDatabase database(path);
+
+	auto product = database.fetchProductDetails(10);
+	ASSERT_TRUE(product.has_value());
+	EXPECT_EQ(product->getDescription(), description);
+	EXPECT_EQ(product->getThumbnail(), thumbnail);
+	ASSERT_TRUE(database.fetchProductDetails(1'000'000'000'000).has_value());
+	EXPECT_EQ(database.fetchProductDetails(1'000'000'000'000)->getName(), "Trillion");
+	EXPECT_FALSE(database.fetchProductDetails(11).has_value());
+
+	EXPECT_EQ(database.fetchProductCountByCategory(3), 1);
+	auto page = database.fetchProductsByCategory(7, 0, 10);
+	ASSERT_EQ(page.size(), 2);
+	EXPECT_EQ(page[0].getId(), 10);
+	EXPECT_EQ(page[1].getId(), 1'000'000'000'001);
+}
+
+// Test case to verify an empty store opens and answers every query with nothing
+TEST_F(MappedProductDatabaseTest, TestEmptyStore) {
+	writeGeneratedStore(0);
+	MappedProductDatabase database(path);
+
+	EXPECT_EQ(database.getProductCount(), 0);
+	EXPECT_FALSE(database.fetchProductDetails(1).has_value());
+	EXPECT_EQ(database.fetchProductCountByCategory(100), 0);
+	EXPECT_TRUE(database.fetchProductsByCategory(100, 0, 10).empty());
+}
+
+// Test case to verify the writer rejects IDs that are not strictly ascending
+TEST_F(MappedProductDatabaseTest, TestWriterRejectsUnorderedIds) {
+	MappedProductWriter writer(path);
+	writer.add(Product(5, 100, "Five", "", {}));
+	EXPECT_THROW(writer.add(Product(5, 100, "Five again", "", {})), std::invalid_argument);
+	EXPECT_THROW(writer.add(Product(4, 100, "Four", "", {})), std::invalid_argument);
+	writer.finish();
+	EXPECT_THROW(writer.add(Product(6, 100, "Six", "", {})), std::logic_error);
+}
+
+// Test case to verify unfinished, truncated and foreign files are rejected on open
+TEST_F(MappedProductDatabaseTest, TestRejectsInvalidFiles) {
+	EXPECT_THROW(MappedProductDatabase{ path }, std::runtime_error);
+
+	{
+		MappedProductWriter writer(path);
+		writer.add(Product(1, 100, "One", "", {}));
+		// Not finished: the header is still blank.
+	}
+	EXPECT_THROW(MappedProductDatabase{ path }, std::runtime_error);
+
+	writeGeneratedStore(PRODUCT_COUNT);
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+	EXPECT_THROW(MappedProductDatabase{ path }, std::runtime_error);
+
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a product store";
+	EXPECT_THROW(MappedProductDatabase{ path }, std::runtime_error);
+}
+
+// Test case to verify a category listing members past the members section is rejected on open,
+// and a lookup in an index without empty slots ends instead of probing forever
+TEST_F(MappedProductDatabaseTest, TestRejectsCorruptSections) {
+	using Format = MappedProductFormat;
+
+	auto readHeader = [this] {
+		Format::Header header{};
+		std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(&header), sizeof(header));
+		return header;
+	};
+	auto overwrite = [this](uint64_t offset, const auto& value) {
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekp(static_cast<std::streamoff>(offset));
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	};
+
+	writeGeneratedStore(PRODUCT_COUNT);
+	auto header = readHeader();
+	ASSERT_GT(header.categoryCount, 0u);
+	overwrite(header.categoryOffset + offsetof(Format::CategoryEntry, memberCount), uint64_t{ PRODUCT_COUNT + 1 });
+	EXPECT_THROW(MappedProductDatabase{ path }, std::runtime_error);
+
+	writeGeneratedStore(PRODUCT_COUNT);
+	header = readHeader();
+	const Format::IndexEntry occupied{ ~uint64_t{ 0 }, sizeof(Format::Header) };
+	for (uint64_t slot = 0; slot < (uint64_t{ 1 } << header.indexBits); ++slot) {
+		overwrite(header.indexOffset + slot * sizeof(Format::IndexEntry), occupied);
+	}
+	MappedProductDatabase database(path);
+	EXPECT_FALSE(database.fetchProductDetails(1).has_value());
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "Metrics.h"
+#include "ProductCache.h"
+#include "ShardedProductCache.h"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Test case to verify histogram buckets are contiguous and bound their values
+TEST(LatencyHistogramTest, TestBucketBoundsContainValues) {
+	for (uint64_t nanos : { 0ULL, 1ULL, 7ULL, 8ULL, 15ULL, 16ULL, 1'000ULL, 123'456'789ULL, ~0ULL }) {
+		auto index = LatencyHistogram::bucketIndex(nanos);
+		ASSERT_LT(index, LatencyHistogram::BUCKETS);
+		EXPECT_GE(LatencyHistogram::bucketUpperBound(index), nanos);
+		if (index > 0) {
+			EXPECT_LT(LatencyHistogram::bucketUpperBound(index - 1), nanos);
+		}
+	}
+}
+
+// Test case to verify percentiles are reported within the histogram's precision
+TEST(LatencyHistogramTest, TestPercentiles) {
+	LatencyHistogram histogram;
+	for (int i = 1; i <= 100; ++i) {
+		histogram.record(std::chrono::microseconds(i));
+	}
+
+	auto snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count, 100);
+	EXPECT_EQ(snapshot.sumNanos, 5050 * 1000);
+
+	auto p50 = snapshot.percentile(0.5);
+	EXPECT_GE(p50, 50'000);
+	EXPECT_LE(p50, 50'000 + 50'000 / LatencyHistogram::SUB_BUCKETS);
+	EXPECT_GE(snapshot.percentile(1.0), 100'000);
+}
+
+// Test case to verify striped counters sum increments from several threads
+TEST(ShardedCounterTest, TestConcurrentIncrements) {
+	ShardedCounter counter;
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < 8; ++t) {
+			threads.emplace_back([&counter] {
+				for (int i = 0; i < 1000; ++i) {
+					counter.increment();
+				}
+			});
+		}
+	}
+	EXPECT_EQ(counter.load(), 8000);
+}
+
+// Test case to verify the cache counts hits, misses, puts and evictions
+TEST(CacheMetricsTest, TestProductCacheCounters) {
+	Metrics::setLatencySampleRate(1);
+	ProductCache cache(2);
+	cache.put(1, Product(1, 100, "Product 1", "Description 1", {}));
+	cache.put(2, Product(2, 100, "Product 2", "Description 2", {}));
+	cache.put(3, Product(3, 100, "Product 3", "Description 3", {}));
+	(void)cache.get(3);
+	(void)cache.get(1);
+
+	auto metrics = cache.getMetrics();
+	EXPECT_EQ(metrics.puts, 3);
+	EXPECT_EQ(metrics.evictions, 1);
+	EXPECT_EQ(metrics.hits, 1);
+	EXPECT_EQ(metrics.misses, 1);
+	EXPECT_EQ(metrics.getLatency.count, 2);
+	Metrics::setLatencySampleRate(16);
+}
+
+// Test case to verify latency is sampled while counters stay exact
+TEST(CacheMetricsTest, TestLatencySampling) {
+	Metrics::setLatencySampleRate(4);
+	ProductCache cache(2);
+	for (int i = 0; i < 40; ++i) {
+		(void)cache.get(1);
+	}
+	Metrics::setLatencySampleRate(16);
+
+	auto metrics = cache.getMetrics();
+	EXPECT_EQ(metrics.misses, 40);
+	EXPECT_EQ(metrics.getLatency.count, 10);
+}
+
+// Test case to verify the sharded cache aggregates its shards' metrics
+TEST(CacheMetricsTest, TestShardedCacheAggregates) {
+	ShardedProductCache cache(64, 4);
+	for (uint64_t i = 1; i <= 10; ++i) {
+		cache.put(i, Product(i, 100, "Product " + std::to_string(i), "Description", {}));
+	}
+	for (uint64_t i = 1; i <= 20; ++i) {
+		(void)cache.get(i);
+	}
+
+	auto metrics = cache.getMetrics();
+	EXPECT_EQ(metrics.puts, 10);
+	EXPECT_EQ(metrics.hits, 10);
+	EXPECT_EQ(metrics.misses, 10);
+}
+
+// Test case to verify nothing is recorded while metrics are disabled
+TEST(CacheMetricsTest, TestDisabledMetricsRecordNothing) {
+	ProductCache cache(2);
+	Metrics::setEnabled(false);
+	cache.put(1, Product(1, 100, "Product 1", "Description 1", {}));
+	(void)cache.get(1);
+	Metrics::setEnabled(true);
+
+	auto metrics = cache.getMetrics();
+	EXPECT_EQ(metrics.puts, 0);
+	EXPECT_EQ(metrics.hits, 0);
+	EXPECT_EQ(metrics.getLatency.count, 0);
+}
+
+// Test case to verify the Prometheus exposition contains counters and a cumulative histogram
+TEST(PrometheusExporterTest, TestFormatCacheMetrics) {
+	CacheMetricsSnapshot metrics;
+	metrics.hits = 5;
+	metrics.misses = 2;
+	metrics.getLatency.count = 1;
+	metrics.getLatency.sumNanos = 300;
+	metrics.getLatency.buckets[LatencyHistogram::bucketIndex(300)] = 1;
+
+	auto text = PrometheusExporter::format("product_cache", metrics);
+	EXPECT_NE(text.find("# TYPE product_cache_hits_total counter"), std::string::npos);
+	EXPECT_NE(text.find("product_cache_hits_total 5\n"), std::string::npos);
+	EXPECT_NE(text.find("product_cache_misses_total 2\n"), std::string::npos);
+	EXPECT_NE(text.find("# TYPE product_cache_bytes gauge"), std::string::npos);
+	EXPECT_NE(text.find("product_cache_get_latency_seconds_bucket{le=\"2.5e-07\"} 0\n"), std::string::npos);
+	EXPECT_NE(text.find("product_cache_get_latency_seconds_bucket{le=\"5e-07\"} 1\n"), std::string::npos);
+	EXPECT_NE(text.find("product_cache_get_latency_seconds_count 1\n"), std::string::npos);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "NumaProductCache.h"
+#include "TestProducts.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class NumaProductCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		// Two nodes regardless of the machine; tests name the node explicitly.
+		cache = std::make_unique<NumaProductCache>(4, NumaTopology({ { 0 }, { 1 } }));
+	}
+
+	std::unique_ptr<NumaProductCache> cache;
+};
+
+// Test case to verify a hit on another node's replica is copied into the local one
+TEST_F(NumaProductCacheTest, TestRemoteHitCopiedToLocalNode) {
+	const auto product = makeSharedProduct(1);
+	cache->putSharedOnNode(0, 1, product);
+
+	auto remote = cache->getTimedOnNode(1, 1).value;
+	ASSERT_NE(remote, nullptr);
+	EXPECT_EQ(*remote, *product);
+	EXPECT_NE(remote, product) << "The local replica holds its own copy.";
+	EXPECT_EQ(cache->getRemoteHitCount(), 1);
+	EXPECT_EQ(cache->getNodeMetrics(1).entries, 1);
+
+	EXPECT_EQ(cache->getTimedOnNode(1, 1).value, remote);
+	EXPECT_EQ(cache->getRemoteHitCount(), 1);
+	const auto metrics = cache->getMetrics();
+	EXPECT_EQ(metrics.hits, 2);
+	EXPECT_EQ(metrics.entries, 2);
+	EXPECT_FALSE(cache->getTimedOnNode(1, 2).value);
+	EXPECT_EQ(cache->getMetrics().misses, 1);
+}
+
+// Test case to verify a put replaces every node's copy so no replica serves the old product
+TEST_F(NumaProductCacheTest, TestPutDropsOtherReplicas) {
+	cache->putSharedOnNode(0, 1, makeSharedProduct(1, "Old"));
+	ASSERT_NE(cache->getTimedOnNode(1, 1).value, nullptr);
+
+	cache->putSharedOnNode(1, 1, makeSharedProduct(1, "New"));
+	EXPECT_EQ(cache->getNodeMetrics(0).entries, 0);
+	auto product = cache->getTimedOnNode(0, 1).value;
+	ASSERT_NE(product, nullptr);
+	EXPECT_EQ(product->getName(), "New 1");
+}
+
+// Test case to verify invalidations reach every replica and count each product once
+TEST_F(NumaProductCacheTest, TestInvalidationAcrossReplicas) {
+	for (uint64_t productId = 1; productId <= 3; ++productId) {
+		cache->putSharedOnNode(0, productId, makeSharedProduct(productId));
+		ASSERT_NE(cache->getTimedOnNode(1, productId).value, nullptr);
+	}
+
+	EXPECT_TRUE(cache->invalidate(1));
+	EXPECT_FALSE(cache->getTimedOnNode(1, 1).value);
+	EXPECT_EQ(cache->invalidateIf([](const uint64_t& productId, const Product&) { return productId == 2; }), 1);
+	const std::vector<uint64_t> productIds{ 2, 3, 4 };
+	EXPECT_EQ(cache->invalidateMany(productIds), 1);
+	EXPECT_EQ(cache->getMetrics().entries, 0);
+	EXPECT_EQ(cache->getMetrics().invalidations, 3);
+}
+
+// Test case to verify remote copies racing puts and invalidations never leave an old product behind
+TEST_F(NumaProductCacheTest, TestRemoteCopyRacingUpdatesKeepsLatest) {
+	constexpr uint64_t productCount = 4;
+	constexpr int rounds = 500;
+
+	std::atomic<bool> done{ false };
+	{
+		// Reads on node 1 keep copying what the writer puts on node 0.
+		std::jthread reader([this, &done] {
+			while (!done.load()) {
+				for (uint64_t productId = 1; productId <= productCount; ++productId) {
+					(void)cache->getTimedOnNode(1, productId);
+				}
+			}
+		});
+
+		for (int round = 1; round <= rounds; ++round) {
+			for (uint64_t productId = 1; productId <= productCount; ++productId) {
+				cache->putSharedOnNode(0, productId, makeSharedProduct(productId, "Version" + std::to_string(round)));
+			}
+			for (uint64_t productId = 2; productId <= productCount; productId += 2) {
+				cache->invalidate(productId);
+			}
+		}
+		done.store(true);
+	}
+
+	for (size_t node = 0; node < 2; ++node) {
+		for (uint64_t productId = 1; productId <= productCount; ++productId) {
+			const auto product = cache->getTimedOnNode(node, productId).value;
+			if (productId % 2 == 0) {
+				EXPECT_EQ(product, nullptr) << "Product " << productId << " on node " << node;
+			}
+			else if (product) {
+				EXPECT_EQ(product->getName(), "Version" + std::to_string(rounds) + " " + std::to_string(productId));
+			}
+		}
+	}
+}
+
+// Test case to verify a single-node topology behaves as one plain cache
+TEST_F(NumaProductCacheTest, TestSingleNodeFallback) {
+	NumaProductCache singleNode(2, NumaTopology::singleNode());
+	singleNode.put(1, makeProduct(1));
+	singleNode.put(2, makeProduct(2));
+	singleNode.put(3, makeProduct(3));
+
+	EXPECT_FALSE(singleNode.get(1).has_value());
+	EXPECT_TRUE(singleNode.get(3).has_value());
+	const std::vector<uint64_t> productIds{ 2, 3 };
+	const auto products = singleNode.getMany(productIds);
+	EXPECT_NE(products[0], nullptr);
+	EXPECT_NE(products[1], nullptr);
+	EXPECT_EQ(singleNode.getRemoteHitCount(), 0);
+	EXPECT_EQ(singleNode.getMetrics().evictions, 1);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "NumaTopology.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class NumaTopologyTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		nodeDirectory = std::filesystem::temp_directory_path() /
+			("NumaTopologyTest_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+		std::filesystem::create_directories(nodeDirectory);
+	}
+
+	void TearDown() override {
+		std::error_code error;
+		std::filesystem::remove_all(nodeDirectory, error);
+	}
+
+	void writeFile(const std::filesystem::path& relativePath, const std::string& contents) {
+		std::filesystem::create_directories((nodeDirectory / relativePath).parent_path());
+		std::ofstream(nodeDirectory / relativePath) << contents;
+	}
+
+	std::filesystem::path nodeDirectory;
+};
+
+// Test case to verify kernel CPU lists are parsed, including ranges and the trailing newline
+TEST_F(NumaTopologyTest, TestParseCpuList) {
+	EXPECT_EQ(NumaTopology::parseCpuList("0-3,8,10-11\n"), (std::vector<uint32_t>{ 0, 1, 2, 3, 8, 10, 11 }));
+	EXPECT_TRUE(NumaTopology::parseCpuList("\n").empty());
+	EXPECT_THROW((void)NumaTopology::parseCpuList("3-1"), std::invalid_argument);
+	EXPECT_THROW((void)NumaTopology::parseCpuList("0,,2"), std::invalid_argument);
+	EXPECT_THROW((void)NumaTopology::parseCpuList("a-b"), std::invalid_argument);
+}
+
+// Test case to verify sparse node IDs are numbered densely and memory-only nodes are left out
+TEST_F(NumaTopologyTest, TestReadsSysfsNodes) {
+	writeFile("online", "0,2-3\n");
+	writeFile("node0/cpulist", "0-1,4-5\n");
+	writeFile("node2/cpulist", "\n");
+	writeFile("node3/cpulist", "2-3,6-7\n");
+
+	const auto topology = NumaTopology::fromSysfs(nodeDirectory);
+	ASSERT_EQ(topology.getNodeCount(), 2);
+	EXPECT_EQ(std::vector<uint32_t>(topology.getCpus(1).begin(), topology.getCpus(1).end()), (std::vector<uint32_t>{ 2, 3, 6, 7 }));
+	EXPECT_EQ(topology.getNodeOfCpu(5), 0);
+	EXPECT_EQ(topology.getNodeOfCpu(6), 1);
+	EXPECT_EQ(topology.getNodeOfCpu(64), 0) << "Unknown CPUs fall back to node 0.";
+}
+
+// Test case to verify an unreadable topology falls back to a single node holding every CPU
+TEST_F(NumaTopologyTest, TestFallsBackToSingleNode) {
+	writeFile("online", "0-1\n");
+	writeFile("node0/cpulist", "0\n");
+
+	const auto topology = NumaTopology::fromSysfs(nodeDirectory);
+	EXPECT_EQ(topology.getNodeCount(), 1);
+	EXPECT_FALSE(topology.getCpus(0).empty());
+	EXPECT_EQ(topology.getCurrentNode(), 0);
+	EXPECT_EQ(NumaTopology::detect().getNodeOfCpu(NumaTopology::getCurrentCpu()), NumaTopology::detect().getCurrentNode());
+}
@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 #include "ProductCache.h"
 #include "Logger.h"
+#include "TestClock.h"
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <string>
 #include <memory>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
@@ -112,4 +116,237 @@ TEST_F(ProductCacheTest, ThreadSafetyWithJThread) {
 			EXPECT_EQ(product->getId(), i);
 		}
 	}
-}
\ No newline at end of file
+}
+// Test case to verify shared hits hand out the cached product without copying it
+TEST_F(ProductCacheTest, TestGetSharedReturnsSameInstance) {
+	uint64_t productId = 1;
+	auto product = std::make_shared<const Product>(productId, 101, "Product 1", "Description 1", std::vector{ std::byte{ 'A' } });
+
+	cache->putShared(productId, product);
+
+	auto first = cache->getShared(productId);
+	auto second = cache->getShared(productId);
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(first.get(), product.get());
+	EXPECT_EQ(first.get(), second.get());
+	EXPECT_EQ(cache->getShared(2), nullptr);
+
+	auto copy = cache->get(productId);
+	ASSERT_TRUE(copy.has_value());
+	EXPECT_EQ(*copy, *product);
+}
+
+// Test case to verify a batch get resolves hits and misses in request order
+TEST_F(ProductCacheTest, TestGetManyMixedHitsAndMisses) {
+	for (uint64_t i = 1; i <= 2; ++i) {
+		cache->put(i, Product(i, 101, "Product " + std::to_string(i), "Description " + std::to_string(i), {}));
+	}
+
+	const std::vector<uint64_t> productIds{ 2, 5, 1 };
+	auto products = cache->getMany(productIds);
+
+	ASSERT_EQ(products.size(), 3);
+	ASSERT_NE(products[0], nullptr);
+	EXPECT_EQ(products[0]->getId(), 2);
+	EXPECT_EQ(products[1], nullptr);
+	ASSERT_NE(products[2], nullptr);
+	EXPECT_EQ(products[2]->getId(), 1);
+
+	// The batch refreshed recency: 1 and 2 were touched, so adding two more evicts 2 before 1
+	cache->put(3, Product(3, 101, "Product 3", "Description 3", {}));
+	cache->put(4, Product(4, 101, "Product 4", "Description 4", {}));
+	EXPECT_TRUE(cache->get(1).has_value());
+	EXPECT_FALSE(cache->get(2).has_value());
+}
+
+// Test case to verify a byte budget evicts until the charged bytes fit again
+TEST_F(ProductCacheTest, TestMemoryBudgetEviction) {
+	Product small(1, 101, "Product 1", "Description 1", std::vector<std::byte>(16));
+	Product large(2, 101, "Product 2", "Description 2", std::vector<std::byte>(4096));
+	const size_t smallCharge = ProductCache::entryCharge(small);
+
+	ProductCache budgeted(CacheMemoryBudget{ 4 * smallCharge + ProductCache::entryCharge(large) });
+	for (uint64_t i = 1; i <= 5; ++i) {
+		budgeted.put(i, Product(i, 101, "Product " + std::to_string(i), "Description " + std::to_string(i), std::vector<std::byte>(16)));
+	}
+	EXPECT_EQ(budgeted.getSize(), 5);
+	EXPECT_EQ(budgeted.getMemoryUsage(), 5 * smallCharge);
+
+	// The large product needs the room of at least one small one.
+	budgeted.put(100, large);
+	EXPECT_FALSE(budgeted.get(1).has_value());
+	EXPECT_TRUE(budgeted.get(100).has_value());
+	EXPECT_EQ(budgeted.getSize(), 5);
+	EXPECT_EQ(budgeted.getMemoryUsage(), 4 * smallCharge + ProductCache::entryCharge(large));
+
+	auto metrics = budgeted.getMetrics();
+	EXPECT_EQ(metrics.evictions, 1);
+	EXPECT_EQ(metrics.entries, 5);
+	EXPECT_EQ(metrics.bytes, budgeted.getMemoryUsage());
+}
+
+// Test case to verify products above the entry limit are rejected without evicting anything
+TEST_F(ProductCacheTest, TestMemoryBudgetRejectsOversized) {
+	Product small(1, 101, "Product 1", "Description 1", std::vector<std::byte>(16));
+	Product image(2, 101, "Product 2", "Description 2", std::vector<std::byte>(64 * 1024));
+
+	ProductCache budgeted(CacheMemoryBudget{ 256 * 1024, 16 * 1024 });
+	budgeted.put(1, small);
+	budgeted.put(2, small);
+	budgeted.put(2, image);
+
+	EXPECT_TRUE(budgeted.get(1).has_value());
+	EXPECT_FALSE(budgeted.get(2).has_value()) << "An oversized replacement must not leave the old copy behind.";
+	EXPECT_EQ(budgeted.getMemoryUsage(), ProductCache::entryCharge(small));
+	EXPECT_EQ(budgeted.getMetrics().rejections, 1);
+	EXPECT_EQ(budgeted.getMetrics().evictions, 0);
+}
+
+// Test case to verify a zero memory budget is rejected
+TEST_F(ProductCacheTest, TestZeroMemoryBudgetThrows) {
+	EXPECT_THROW(ProductCache(CacheMemoryBudget{ 0 }), std::invalid_argument);
+}
+
+// Test case to verify products expire after the default time to live
+TEST_F(ProductCacheTest, TestTimeToLiveExpiry) {
+	const ScopedManualClock manualClock;
+	ProductCache expiring(4);
+	expiring.setTimeToLive(std::chrono::milliseconds(100));
+	expiring.put(1, Product(1, 101, "Product 1", "Description 1", {}));
+
+	CoarseClock::advance(std::chrono::milliseconds(50));
+	EXPECT_TRUE(expiring.get(1).has_value());
+
+	CoarseClock::advance(std::chrono::milliseconds(60));
+	EXPECT_FALSE(expiring.get(1).has_value()) << "Hits must not extend the time to live.";
+	EXPECT_EQ(expiring.getSize(), 0);
+
+	auto metrics = expiring.getMetrics();
+	EXPECT_EQ(metrics.expirations, 1);
+	EXPECT_EQ(metrics.hits, 1);
+	EXPECT_EQ(metrics.misses, 1);
+	EXPECT_EQ(metrics.evictions, 0);
+}
+
+// Test case to verify a per-entry time to live overrides the default, and expired tail entries are dropped before evicting
+TEST_F(ProductCacheTest, TestPerEntryTimeToLive) {
+	const ScopedManualClock manualClock;
+	ProductCache expiring(2);
+	expiring.setTimeToLive(std::chrono::milliseconds(100));
+	expiring.putShared(1, std::make_shared<const Product>(1, 101, "Product 1", "Description 1", std::span<const std::byte>{}), std::chrono::milliseconds(10));
+	expiring.putShared(2, std::make_shared<const Product>(2, 101, "Product 2", "Description 2", std::span<const std::byte>{}), std::chrono::milliseconds::zero());
+
+	CoarseClock::advance(std::chrono::milliseconds(20));
+	auto timed = expiring.getTimed(2);
+	ASSERT_NE(timed.value, nullptr);
+	EXPECT_EQ(CoarseClock::now() - timed.storedAt, std::chrono::milliseconds(20));
+
+	// Product 1 is expired at the tail, so storing product 3 costs no eviction.
+	expiring.put(3, Product(3, 101, "Product 3", "Description 3", {}));
+	EXPECT_EQ(expiring.getSize(), 2);
+	EXPECT_EQ(expiring.getMetrics().expirations, 1);
+	EXPECT_EQ(expiring.getMetrics().evictions, 0);
+
+	CoarseClock::advance(std::chrono::hours(1));
+	EXPECT_TRUE(expiring.get(2).has_value()) << "A zero time to live never expires.";
+	EXPECT_FALSE(expiring.get(3).has_value());
+}
+
+// Test case to verify single, batch and predicate invalidation
+TEST_F(ProductCacheTest, TestInvalidate) {
+	cache->put(1, Product(1, 100, "Product 1", "Description 1", {}));
+	cache->put(2, Product(2, 101, "Product 2", "Description 2", {}));
+	cache->put(3, Product(3, 101, "Product 3", "Description 3", {}));
+
+	EXPECT_TRUE(cache->invalidate(1));
+	EXPECT_FALSE(cache->invalidate(1));
+	EXPECT_FALSE(cache->get(1).has_value());
+
+	EXPECT_EQ(cache->invalidateIf([](const uint64_t&, const Product& product) { return product.getCategory() == 101; }), 2);
+	EXPECT_EQ(cache->getSize(), 0);
+	EXPECT_EQ(cache->getMemoryUsage(), 0);
+
+	cache->put(4, Product(4, 100, "Product 4", "Description 4", {}));
+	cache->put(5, Product(5, 100, "Product 5", "Description 5", {}));
+	const std::vector<uint64_t> productIds{ 4, 5, 6 };
+	EXPECT_EQ(cache->invalidateMany(productIds), 2);
+	EXPECT_EQ(cache->getMetrics().invalidations, 5);
+	EXPECT_EQ(cache->getMetrics().evictions, 0);
+}
+
+// Test case to verify a snapshot restores the live products with their contents and recency order
+TEST_F(ProductCacheTest, TestSnapshotRoundTrip) {
+	const auto path = std::filesystem::temp_directory_path() / "ProductCacheTest_TestSnapshotRoundTrip.snapshot";
+	const std::vector<std::byte> thumbnail(300, std::byte{ 9 });
+	cache->put(1, Product(1, 100, "Product 1", "Description 1", thumbnail));
+	cache->put(2, Product(2, 101, "Product 2", "Description 2", {}));
+	cache->put(3, Product(3, 102, "Product 3", std::string(200, 'd'), {}));
+	ASSERT_TRUE(cache->get(1).has_value());
+	EXPECT_EQ(cache->saveSnapshot(path), 3);
+
+	ProductCache restored(3);
+	EXPECT_EQ(restored.loadSnapshot(path, 2), 3);
+	EXPECT_EQ(restored.getMemoryUsage(), cache->getMemoryUsage());
+
+	// Recency was 1, 3, 2 from most to least recent, so a new product evicts 2.
+	restored.put(4, Product(4, 100, "Product 4", "Description 4", {}));
+	EXPECT_FALSE(restored.get(2).has_value());
+	EXPECT_EQ(*restored.get(1), *cache->get(1));
+	EXPECT_EQ(*restored.get(3), *cache->get(3));
+	std::filesystem::remove(path);
+}
+
+// Test case to verify a snapshot fills only the room left behind products already cached
+TEST_F(ProductCacheTest, TestLoadSnapshotKeepsExistingProducts) {
+	const auto path = std::filesystem::temp_directory_path() / "ProductCacheTest_TestLoadSnapshotKeepsExistingProducts.snapshot";
+	cache->put(1, Product(1, 100, "Old 1", "Description 1", {}));
+	cache->put(2, Product(2, 100, "Old 2", "Description 2", {}));
+	cache->put(3, Product(3, 100, "Old 3", "Description 3", {}));
+	cache->saveSnapshot(path);
+
+	// The snapshot holds 3, 2, 1 from most to least recent; 2 is skipped and 1 does not fit.
+	ProductCache restored(3);
+	restored.put(2, Product(2, 100, "New 2", "Description 2", {}));
+	restored.put(5, Product(5, 100, "New 5", "Description 5", {}));
+	EXPECT_EQ(restored.loadSnapshot(path), 1);
+	EXPECT_EQ(restored.getSize(), 3);
+	EXPECT_EQ(restored.get(2)->getName(), "New 2");
+	EXPECT_TRUE(restored.get(3).has_value());
+	EXPECT_TRUE(restored.get(5).has_value());
+	EXPECT_FALSE(restored.get(1).has_value());
+	EXPECT_EQ(restored.getMetrics().evictions, 0);
+	EXPECT_EQ(restored.loadSnapshot(path), 0);
+	std::filesystem::remove(path);
+}
+
+// Test case to verify truncated or foreign snapshot files are rejected
+TEST_F(ProductCacheTest, TestLoadSnapshotRejectsCorruptFile) {
+	const auto path = std::filesystem::temp_directory_path() / "ProductCacheTest_TestLoadSnapshotRejectsCorruptFile.snapshot";
+	cache->put(1, Product(1, 100, "Product 1", "Description 1", {}));
+	cache->saveSnapshot(path);
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+	ProductCache restored(3);
+	EXPECT_THROW(restored.loadSnapshot(path), std::runtime_error);
+
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a snapshot";
+	EXPECT_THROW(restored.loadSnapshot(path), std::runtime_error);
+	EXPECT_EQ(restored.getSize(), 0);
+	std::filesystem::remove(path);
+}
+
+// Test case to verify the eviction listener sees products evicted for room but not invalidated ones
+TEST_F(ProductCacheTest, TestEvictionListenerReceivesEvictedProducts) {
+	std::vector<uint64_t> evicted;
+	cache->setEvictionListener([&evicted](uint64_t productId, const std::shared_ptr<const Product>& product) {
+		EXPECT_EQ(product->getId(), productId);
+		evicted.push_back(productId);
+		});
+
+	for (uint64_t productId = 1; productId <= 5; ++productId) {
+		cache->put(productId, Product(productId, 101, "Product " + std::to_string(productId), "Description", {}));
+	}
+	cache->invalidate(5);
+
+	EXPECT_EQ(evicted, (std::vector<uint64_t>{ 1, 2 }));
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "ProductLogStore.h"
+#include "TestProducts.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class ProductLogStoreTest : public ::testing::Test {
+protected:
+	static std::vector<std::shared_ptr<const Product>> makeProducts(uint64_t first, uint64_t last) {
+		std::vector<std::shared_ptr<const Product>> products;
+		for (uint64_t productId = first; productId <= last; ++productId) {
+			products.push_back(makeSharedProduct(productId));
+		}
+		return products;
+	}
+
+	// Small segments so a handful of products spans several of them.
+	LogStoreOptions options{ .segmentBytes = 256, .maxBytes = 64 * 1024 };
+};
+
+// Test case to verify appended products read back from disk unchanged
+TEST_F(ProductLogStoreTest, TestAppendAndGet) {
+	ProductLogStore store(options);
+	const auto products = makeProducts(1, 20);
+	store.append(products);
+
+	EXPECT_EQ(store.getSize(), 20);
+	for (const auto& product : products) {
+		auto stored = store.get(product->getId());
+		ASSERT_NE(stored, nullptr);
+		EXPECT_EQ(*stored, *product);
+	}
+	EXPECT_EQ(store.get(21), nullptr);
+
+	const auto metrics = store.getMetrics();
+	EXPECT_EQ(metrics.hits, 20);
+	EXPECT_EQ(metrics.misses, 1);
+	EXPECT_EQ(metrics.puts, 20);
+	EXPECT_EQ(metrics.entries, 20);
+}
+
+// Test case to verify products rejected by the index filter are written but not indexed
+TEST_F(ProductLogStoreTest, TestAppendSkipsFilteredProducts) {
+	ProductLogStore store(options);
+	store.append(makeProducts(1, 4), [](const std::shared_ptr<const Product>& product) { return product->getId() % 2 == 1; });
+
+	EXPECT_EQ(store.getSize(), 2);
+	EXPECT_NE(store.get(1), nullptr);
+	EXPECT_EQ(store.get(2), nullptr);
+	EXPECT_NE(store.get(3), nullptr);
+	EXPECT_FALSE(store.contains(4));
+}
+
+// Test case to verify appending a stored product replaces it and erase removes it
+TEST_F(ProductLogStoreTest, TestReplaceAndErase) {
+	ProductLogStore store(options);
+	store.append(makeProducts(1, 3));
+	const std::vector<std::shared_ptr<const Product>> replacement{ makeSharedProduct(2, "Renamed") };
+	store.append(replacement);
+
+	EXPECT_EQ(store.getSize(), 3);
+	EXPECT_EQ(store.get(2)->getName(), "Renamed 2");
+
+	EXPECT_TRUE(store.erase(2));
+	EXPECT_FALSE(store.erase(2));
+	EXPECT_FALSE(store.contains(2));
+	EXPECT_EQ(store.get(2), nullptr);
+	EXPECT_EQ(store.getSize(), 2);
+
+	EXPECT_EQ(store.eraseIf([](const uint64_t& productId, const Product&) { return productId == 3; }), 1);
+	EXPECT_TRUE(store.contains(1));
+	EXPECT_FALSE(store.contains(3));
+}
+
+// Test case to verify compaction reclaims dead records and keeps live ones readable
+TEST_F(ProductLogStoreTest, TestCompactionMovesLiveRecords) {
+	ProductLogStore store(options);
+	for (uint64_t productId = 1; productId <= 40; ++productId) {
+		store.append(std::vector{ makeSharedProduct(productId) });
+	}
+	for (uint64_t productId = 1; productId <= 40; ++productId) {
+		if (productId % 4 != 0) {
+			store.erase(productId);
+		}
+	}
+	const uint64_t diskBytes = store.getDiskBytes();
+
+	EXPECT_GT(store.compact(), 0);
+	EXPECT_LT(store.getDiskBytes(), diskBytes);
+	EXPECT_EQ(store.getSize(), 10);
+	for (uint64_t productId = 4; productId <= 40; productId += 4) {
+		auto stored = store.get(productId);
+		ASSERT_NE(stored, nullptr) << "Product " << productId << " was lost.";
+		EXPECT_EQ(*stored, *makeSharedProduct(productId));
+	}
+	EXPECT_EQ(store.compact(), 0);
+}
+
+// Test case to verify the oldest segment is dropped once the log outgrows its limit
+TEST_F(ProductLogStoreTest, TestOldestSegmentDroppedAtLimit) {
+	options.maxBytes = 1024;
+	ProductLogStore store(options);
+	for (uint64_t productId = 1; productId <= 60; ++productId) {
+		store.append(std::vector{ makeSharedProduct(productId) });
+	}
+
+	EXPECT_LE(store.getDiskBytes(), options.maxBytes);
+	EXPECT_FALSE(store.contains(1));
+	EXPECT_TRUE(store.contains(60));
+	EXPECT_EQ(store.getMetrics().evictions, 60 - store.getSize());
+}
+
+// Test case to verify options that cannot hold a segment are rejected
+TEST_F(ProductLogStoreTest, TestInvalidOptionsThrow) {
+	EXPECT_THROW(ProductLogStore(LogStoreOptions{ .segmentBytes = 0 }), std::invalid_argument);
+	EXPECT_THROW(ProductLogStore(LogStoreOptions{ .segmentBytes = 1024, .maxBytes = 512 }), std::invalid_argument);
+}
@@ -5,6 +5,12 @@
 #include "Product.h"
 #include "ICache.h"
 #include "IDatabase.h"
+#include "FakeDatabase.h"
+#include "TestClock.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 // Mock the ICache interface
@@ -12,6 +18,8 @@ class MockCache : public ICache<uint64_t, Product> {
 public:
     MOCK_METHOD(std::optional<Product>, get, (uint64_t productId), (override));
     MOCK_METHOD(void, put, (uint64_t productId, const Product& product), (override));
+    MOCK_METHOD(bool, invalidate, (uint64_t productId), (override));
+    MOCK_METHOD(size_t, invalidateIf, (const std::function<bool(const uint64_t&, const Product&)>& predicate), (override));
 };
 
 // Mock the IDatabase interface
@@ -19,6 +27,8 @@ class MockDatabase : public IDatabase {
 public:
     MOCK_METHOD(std::optional<Product>, fetchProductDetails, (uint64_t productId), (override));
     MOCK_METHOD(size_t, fetchProductCountByCategory, (uint32_t categoryId), (override));
+    MOCK_METHOD(std::vector<Product>, fetchProductsByCategory, (uint32_t categoryId, size_t offset, size_t limit), (override));
+    MOCK_METHOD(std::vector<std::optional<Product>>, fetchProductDetailsBatch, (std::span<const uint64_t> productIds), (override));
 };
 
 // Test fixture for ProductService
@@ -134,4 +144,475 @@ TEST_F(ProductServiceTest, TestCacheEviction) {
     auto result = cache.get(productId);
     ASSERT_TRUE(result.has_value());
     EXPECT_EQ(result->getId(), expectedProduct.getId());
-}
\ No newline at end of file
+}
+// Test case 7: Shared handle from a database hit is the one stored in the cache
+TEST_F(ProductServiceTest, TestSharedHandleIsCached) {
+    uint64_t productId = 7;
+    Product expectedProduct(productId, 101, "Product 7", "Description of Product 7", {});
+
+    auto cache = std::make_shared<ProductCache>(2);
+    ProductService service{ cache, mockDatabase };
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(productId))
+        .WillOnce(::testing::Return(expectedProduct));
+
+    auto fromDatabase = service.getProductDetailsShared(productId);
+    auto fromCache = service.getProductDetailsShared(productId);
+
+    ASSERT_NE(fromDatabase, nullptr);
+    EXPECT_EQ(fromDatabase.get(), fromCache.get());
+    EXPECT_EQ(*fromCache, expectedProduct);
+}
+
+
+// Fixture helper: blocks the leading database fetch until every other caller has coalesced onto it
+class CoalescingProductServiceTest : public ProductServiceTest {
+protected:
+    static constexpr int callerCount = 6;
+
+    std::shared_ptr<ProductCache> cache = std::make_shared<ProductCache>(4);
+    ProductService service{ cache, mockDatabase };
+
+    void waitForWaiters() const {
+        while (service.getCoalescedFetchCount() < callerCount - 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
+// Test case 8: Concurrent misses on the same product trigger a single database fetch
+TEST_F(CoalescingProductServiceTest, TestConcurrentMissesAreCoalesced) {
+    uint64_t productId = 8;
+    Product expectedProduct(productId, 102, "Product 8", "Description of Product 8", {});
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(productId))
+        .WillOnce([this, &expectedProduct](uint64_t) {
+            waitForWaiters();
+            return std::optional<Product>(expectedProduct);
+        });
+
+    std::vector<std::shared_ptr<const Product>> results(callerCount);
+    {
+        std::vector<std::jthread> threads;
+        for (int i = 0; i < callerCount; ++i) {
+            threads.emplace_back([this, &results, i, productId] {
+                results[i] = service.getProductDetailsShared(productId);
+            });
+        }
+    }
+
+    EXPECT_EQ(service.getCoalescedFetchCount(), callerCount - 1);
+    for (const auto& result : results) {
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result.get(), results.front().get()) << "All callers should share the leader's product.";
+    }
+}
+
+// Test case 9: A "not found" result is delivered to every waiting caller
+TEST_F(CoalescingProductServiceTest, TestCoalescedNotFound) {
+    uint64_t productId = 9;
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(productId))
+        .WillOnce([this](uint64_t) {
+            waitForWaiters();
+            return std::optional<Product>();
+        });
+
+    std::atomic<int> notFound{ 0 };
+    {
+        std::vector<std::jthread> threads;
+        for (int i = 0; i < callerCount; ++i) {
+            threads.emplace_back([this, &notFound, productId] {
+                if (!service.getProductDetailsShared(productId)) {
+                    ++notFound;
+                }
+            });
+        }
+    }
+
+    EXPECT_EQ(notFound.load(), callerCount);
+}
+
+// Test case 10: A database error is rethrown to every waiting caller
+TEST_F(CoalescingProductServiceTest, TestCoalescedErrorPropagates) {
+    uint64_t productId = 10;
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(productId))
+        .WillOnce([this](uint64_t) -> std::optional<Product> {
+            waitForWaiters();
+            throw std::runtime_error("database unavailable");
+        });
+
+    std::atomic<int> failures{ 0 };
+    {
+        std::vector<std::jthread> threads;
+        for (int i = 0; i < callerCount; ++i) {
+            threads.emplace_back([this, &failures, productId] {
+                try {
+                    (void)service.getProductDetailsShared(productId);
+                }
+                catch (const std::runtime_error&) {
+                    ++failures;
+                }
+            });
+        }
+    }
+
+    EXPECT_EQ(failures.load(), callerCount);
+}
+
+// Test case 11: Batch get sends all cache misses to the database in one batch
+TEST_F(ProductServiceTest, TestGetManyBatchesMisses) {
+    auto cache = std::make_shared<ProductCache>(8);
+    ProductService service{ cache, mockDatabase };
+    cache->put(1, Product(1, 100, "Product 1", "Description of Product 1", {}));
+
+    const std::vector<uint64_t> productIds{ 1, 2, 3, 2 };
+    const std::vector<uint64_t> expectedMisses{ 2, 3 };
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(::testing::_)).Times(0);
+    EXPECT_CALL(*mockDatabase, fetchProductDetailsBatch(::testing::ElementsAreArray(expectedMisses)))
+        .WillOnce(::testing::Return(std::vector<std::optional<Product>>{
+            Product(2, 101, "Product 2", "Description of Product 2", {}),
+            std::nullopt }));
+
+    auto products = service.getMany(productIds);
+
+    ASSERT_EQ(products.size(), productIds.size());
+    ASSERT_NE(products[0], nullptr);
+    EXPECT_EQ(products[0]->getId(), 1);
+    ASSERT_NE(products[1], nullptr);
+    EXPECT_EQ(products[1]->getId(), 2);
+    EXPECT_EQ(products[2], nullptr);
+    EXPECT_EQ(products[3].get(), products[1].get());
+    EXPECT_TRUE(cache->get(2).has_value()) << "Fetched products should be cached.";
+}
+
+// Test case 12: Service metrics count requests, cache hits and database outcomes
+TEST_F(ProductServiceTest, TestServiceMetrics) {
+    Metrics::setLatencySampleRate(1);
+    auto cache = std::make_shared<ProductCache>(4);
+    ProductService service{ cache, mockDatabase };
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(1))
+        .WillOnce(::testing::Return(Product(1, 100, "Product 1", "Description of Product 1", {})));
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(2))
+        .WillOnce(::testing::Return(std::nullopt));
+
+    (void)service.getProductDetailsShared(1);
+    (void)service.getProductDetailsShared(1);
+    (void)service.getProductDetailsShared(2);
+
+    auto metrics = service.getMetrics();
+    EXPECT_EQ(metrics.requests, 3);
+    EXPECT_EQ(metrics.cacheHits, 1);
+    EXPECT_EQ(metrics.cacheMisses, 2);
+    EXPECT_EQ(metrics.databaseFetches, 2);
+    EXPECT_EQ(metrics.databaseNotFound, 1);
+    EXPECT_EQ(metrics.requestLatency.count, 3);
+    Metrics::setLatencySampleRate(16);
+}
+
+// Test case 13: Stale-while-revalidate serves the stale product and refreshes it in the background
+TEST_F(ProductServiceTest, TestStaleWhileRevalidate) {
+    const ScopedManualClock manualClock;
+    auto cache = std::make_shared<ProductCache>(4);
+    ProductService service{ cache, mockDatabase };
+    service.setStaleWhileRevalidate(std::chrono::milliseconds(100));
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(1))
+        .WillOnce(::testing::Return(Product(1, 100, "Old name", "Description of Product 1", {})))
+        .WillOnce(::testing::Return(Product(1, 100, "New name", "Description of Product 1", {})));
+
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "Old name");
+    CoarseClock::advance(std::chrono::milliseconds(150));
+
+    // Repeated stale hits are served from the cache and share one refresh.
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "Old name");
+    (void)service.getProductDetailsShared(1);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (cache->getShared(1)->getName() != "New name" && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "New name");
+
+    auto metrics = service.getMetrics();
+    EXPECT_GE(metrics.staleHits, 1);
+    EXPECT_EQ(metrics.backgroundRefreshes, 1);
+    EXPECT_EQ(metrics.cacheMisses, 1);
+}
+
+// Test case 14: Database change notifications invalidate the cached copies
+TEST_F(ProductServiceTest, TestChangeFeedInvalidatesCache) {
+    auto cache = std::make_shared<ProductCache>(8);
+    auto database = std::make_shared<FakeDatabase>();
+    ProductService service{ cache, database };
+
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "Product 1");
+    EXPECT_EQ(service.getProductDetailsShared(2)->getName(), "Product 2");
+    ASSERT_EQ(cache->getSize(), 2);
+
+    database->updateProducts(std::vector{ Product(1, 101, "Renamed 1", "Description", {}) });
+    database->removeProducts(std::vector<uint64_t>{ 2 });
+
+    EXPECT_EQ(cache->getSize(), 0);
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "Renamed 1");
+    EXPECT_EQ(service.getProductDetailsShared(2), nullptr);
+    EXPECT_EQ(service.getMetrics().invalidations, 2);
+}
+
+// Test case 15: Async hits complete inline and misses complete on the executor
+TEST_F(ProductServiceTest, TestAsyncHitAndMiss) {
+    auto cache = std::make_shared<ProductCache>(4);
+    ProductService service{ cache, mockDatabase, ExecutorOptions{ 2, 16 } };
+    cache->put(1, Product(1, 100, "Product 1", "Description of Product 1", {}));
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(2))
+        .WillOnce(::testing::Return(Product(2, 101, "Product 2", "Description of Product 2", {})));
+
+    auto hit = service.getProductDetailsAsync(1);
+    EXPECT_EQ(hit.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(hit.get()->getId(), 1);
+
+    auto miss = service.getProductDetailsAsync(2);
+    ASSERT_NE(miss.get(), nullptr);
+    EXPECT_EQ(miss.get()->getName(), "Product 2");
+    EXPECT_TRUE(cache->get(2).has_value());
+}
+
+// Test case 16: A miss the executor cannot queue fails fast instead of blocking
+TEST_F(ProductServiceTest, TestAsyncBackPressure) {
+    auto cache = std::make_shared<ProductCache>(4);
+    ProductService service{ cache, mockDatabase, ExecutorOptions{ 1, 1, ExecutorOverflowPolicy::REJECT } };
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> started{ false };
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(::testing::_))
+        .WillRepeatedly([&started, released](uint64_t productId) {
+            started = true;
+            released.wait();
+            return std::optional<Product>(Product(productId, 100, "Product", "Description", {}));
+        });
+
+    // The first fetch occupies the only worker and the second fills the queue.
+    auto first = service.getProductDetailsAsync(1);
+    while (!started.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto second = service.getProductDetailsAsync(2);
+    auto rejected = service.getProductDetailsAsync(3);
+
+    EXPECT_THROW((void)rejected.get(), std::runtime_error);
+    EXPECT_EQ(service.getMetrics().rejectedFetches, 1);
+
+    release.set_value();
+    EXPECT_NE(first.get(), nullptr);
+    EXPECT_NE(second.get(), nullptr);
+}
+
+// Test case 17: Category counts are cached, and concurrent misses query the database once
+TEST_F(ProductServiceTest, TestCategoryCountIsCachedAndCoalesced) {
+    EXPECT_CALL(*mockDatabase, fetchProductCountByCategory(101))
+        .WillOnce([](uint32_t) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return size_t{ 42 };
+        });
+
+    {
+        std::vector<std::jthread> threads;
+        for (int i = 0; i < 6; ++i) {
+            threads.emplace_back([this] { EXPECT_EQ(productService.getProductCountByCategory(101), 42); });
+        }
+    }
+    EXPECT_EQ(productService.getProductCountByCategory(101), 42);
+    EXPECT_GE(productService.getCategoryCountMetrics().hits, 1);
+}
+
+// Test case 18: Counts are invalidated only by changes to category membership, with a TTL fallback
+TEST_F(ProductServiceTest, TestCategoryCountInvalidation) {
+    const ScopedManualClock manualClock;
+    auto database = std::make_shared<FakeDatabase>();
+    ProductService service{ std::make_shared<ProductCache>(8), database };
+    service.setCategoryCountTimeToLive(std::chrono::milliseconds(1000));
+
+    EXPECT_EQ(service.getProductCountByCategory(101), 1000);
+    EXPECT_EQ(service.getProductCountByCategory(102), 1000);
+
+    // A rename keeps both counts; moving product 1 from 101 to 102 changes both.
+    database->updateProducts(std::vector{ Product(2, 102, "Renamed 2", "Description", {}) });
+    EXPECT_EQ(service.getCategoryCountMetrics().invalidations, 0);
+    database->updateProducts(std::vector{ Product(1, 102, "Moved 1", "Description", {}) });
+    EXPECT_EQ(service.getCategoryCountMetrics().invalidations, 2);
+    EXPECT_EQ(service.getProductCountByCategory(101), 999);
+    EXPECT_EQ(service.getProductCountByCategory(102), 1001);
+
+    EXPECT_EQ(service.getProductCountByCategory(100), 1000);
+    CoarseClock::advance(std::chrono::milliseconds(1500));
+    EXPECT_EQ(service.getProductCountByCategory(100), 1000);
+    EXPECT_EQ(service.getCategoryCountMetrics().expirations, 1);
+}
+
+// Test case 19: Warm-up prefetches hot IDs in database batches before any request
+TEST_F(ProductServiceTest, TestWarmUpPrefetchesInBatches) {
+    auto database = std::make_shared<MockDatabase>();
+    auto cache = std::make_shared<ProductCache>(16);
+    ProductService service{ cache, database, ExecutorOptions{ 2, 16, ExecutorOverflowPolicy::BLOCK } };
+
+    EXPECT_CALL(*database, fetchProductDetailsBatch(::testing::_))
+        .Times(3)
+        .WillRepeatedly([](std::span<const uint64_t> productIds) {
+            std::vector<std::optional<Product>> products;
+            for (uint64_t productId : productIds) {
+                if (productId != 99) {
+                    products.emplace_back(Product(productId, 100, "Product", "Description", {}));
+                }
+                else {
+                    products.emplace_back(std::nullopt);
+                }
+            }
+            return products;
+        });
+    EXPECT_CALL(*database, fetchProductDetails(::testing::_)).Times(0);
+
+    const std::vector<uint64_t> hotIds{ 1, 2, 3, 4, 5, 6, 99 };
+    EXPECT_EQ(service.warmUp(hotIds, 3), 6);
+    EXPECT_EQ(cache->getSize(), 6);
+
+    EXPECT_NE(service.getProductDetailsShared(4), nullptr);
+    EXPECT_EQ(service.getMetrics().cacheHits, 1);
+    EXPECT_EQ(service.getMetrics().databaseNotFound, 1);
+}
+
+// Fixture helper: a database whose first fetch of a product is overtaken by an update to it
+class RacingUpdateDatabase : public FakeDatabase {
+public:
+    using FakeDatabase::fetchProductDetails;
+
+    std::optional<Product> fetchProductDetails(const Prehashed<uint64_t>& productId) override {
+        auto product = FakeDatabase::fetchProductDetails(productId);
+        if (product && !mUpdated.exchange(true)) {
+            updateProducts(std::vector{ Product(productId.key, 101, "Renamed", "Description", {}) });
+        }
+        return product;
+    }
+
+private:
+    std::atomic<bool> mUpdated{ false };
+};
+
+// Test case 20: A fetch overtaken by a change notification is returned but not cached
+TEST_F(ProductServiceTest, TestFetchRacingNotificationIsNotCached) {
+    auto cache = std::make_shared<ProductCache>(8);
+    auto database = std::make_shared<RacingUpdateDatabase>();
+    ProductService service{ cache, database };
+
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "Product 1");
+    EXPECT_EQ(cache->getSize(), 0);
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "Renamed");
+    EXPECT_EQ(cache->getSize(), 1);
+}
+
+// Test case 21: A background refresh that finds the product deleted drops the cached copy
+TEST_F(ProductServiceTest, TestRefreshOfDeletedProductInvalidates) {
+    const ScopedManualClock manualClock;
+    auto cache = std::make_shared<ProductCache>(4);
+    ProductService service{ cache, mockDatabase };
+    service.setStaleWhileRevalidate(std::chrono::milliseconds(100));
+
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(1))
+        .WillOnce(::testing::Return(Product(1, 100, "Product 1", "Description of Product 1", {})))
+        .WillRepeatedly(::testing::Return(std::nullopt));
+
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "Product 1");
+    CoarseClock::advance(std::chrono::milliseconds(150));
+    EXPECT_EQ(service.getProductDetailsShared(1)->getName(), "Product 1");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (cache->getShared(1) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(cache->getShared(1), nullptr);
+    EXPECT_EQ(service.getProductDetailsShared(1), nullptr);
+    EXPECT_EQ(service.getMetrics().invalidations, 1);
+}
+
+// Test case 22: A batch miss joins a single fetch already in flight for the same product
+TEST_F(ProductServiceTest, TestGetManyJoinsInFlightFetch) {
+    auto cache = std::make_shared<ProductCache>(8);
+    ProductService service{ cache, mockDatabase, ExecutorOptions{ 2, 16, ExecutorOverflowPolicy::BLOCK } };
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> started{ false };
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(1))
+        .WillOnce([&started, released](uint64_t productId) {
+            started = true;
+            released.wait();
+            return std::optional<Product>(Product(productId, 100, "Product 1", "Description", {}));
+        });
+    const std::vector<uint64_t> expectedBatch{ 2 };
+    EXPECT_CALL(*mockDatabase, fetchProductDetailsBatch(::testing::ElementsAreArray(expectedBatch)))
+        .WillOnce(::testing::Return(std::vector<std::optional<Product>>{ Product(2, 100, "Product 2", "Description", {}) }));
+
+    auto single = service.getProductDetailsAsync(1);
+    while (!started.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::vector<std::shared_ptr<const Product>> products;
+    std::jthread batch([&service, &products] {
+        const std::vector<uint64_t> productIds{ 1, 2 };
+        products = service.getMany(productIds);
+    });
+    while (service.getCoalescedFetchCount() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    release.set_value();
+    batch.join();
+
+    ASSERT_EQ(products.size(), 2);
+    EXPECT_EQ(products[0].get(), single.get().get());
+    ASSERT_NE(products[1], nullptr);
+    EXPECT_EQ(products[1]->getId(), 2);
+}
+
+// Test case 23: A batch the executor rejects still returns the cache hits
+TEST_F(ProductServiceTest, TestGetManyRejectedReturnsHits) {
+    auto cache = std::make_shared<ProductCache>(4);
+    ProductService service{ cache, mockDatabase, ExecutorOptions{ 1, 1, ExecutorOverflowPolicy::REJECT } };
+    cache->put(1, Product(1, 100, "Product 1", "Description", {}));
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> started{ false };
+    EXPECT_CALL(*mockDatabase, fetchProductDetails(::testing::_))
+        .WillRepeatedly([&started, released](uint64_t productId) {
+            started = true;
+            released.wait();
+            return std::optional<Product>(Product(productId, 100, "Product", "Description", {}));
+        });
+    EXPECT_CALL(*mockDatabase, fetchProductDetailsBatch(::testing::_)).Times(0);
+
+    // The first fetch occupies the only worker and the second fills the queue.
+    auto first = service.getProductDetailsAsync(5);
+    while (!started.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto second = service.getProductDetailsAsync(6);
+
+    const std::vector<uint64_t> productIds{ 1, 2, 3 };
+    std::vector<std::shared_ptr<const Product>> products;
+    EXPECT_NO_THROW(products = service.getMany(productIds));
+    ASSERT_EQ(products.size(), 3);
+    ASSERT_NE(products[0], nullptr);
+    EXPECT_EQ(products[0]->getId(), 1);
+    EXPECT_EQ(products[1], nullptr);
+    EXPECT_EQ(products[2], nullptr);
+    EXPECT_EQ(service.getMetrics().rejectedFetches, 2);
+
+    release.set_value();
+    EXPECT_NE(first.get(), nullptr);
+    EXPECT_NE(second.get(), nullptr);
+}
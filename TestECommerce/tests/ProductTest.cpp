@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "Product.h"
+#include "ProductArena.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	std::vector<std::byte> makeThumbnail(size_t size) {
+		std::vector<std::byte> thumbnail(size);
+		for (size_t i = 0; i < size; ++i) {
+			thumbnail[i] = static_cast<std::byte>(i % 251);
+		}
+		return thumbnail;
+	}
+}
+
+// Test case to verify a small product keeps its fields inline
+TEST(ProductTest, TestSmallProductIsInline) {
+	Product product(1, 101, "Product 1", "Description 1", makeThumbnail(3));
+
+	EXPECT_EQ(product.getName(), "Product 1");
+	EXPECT_EQ(product.getDescription(), "Description 1");
+	EXPECT_EQ(product.getThumbnail(), makeThumbnail(3));
+	EXPECT_EQ(product.getMemoryFootprint(), sizeof(Product));
+}
+
+// Test case to verify a large product stores one blob outside the object
+TEST(ProductTest, TestLargeProductUsesOneBlob) {
+	const std::string description(200, 'd');
+	Product product(2, 101, "Product 2", description, makeThumbnail(1024));
+
+	EXPECT_EQ(product.getName(), "Product 2");
+	EXPECT_EQ(product.getDescription(), description);
+	EXPECT_EQ(product.getThumbnail(), makeThumbnail(1024));
+	EXPECT_EQ(product.getMemoryFootprint(), sizeof(Product) + 9 + 200 + 1024);
+}
+
+// Test case to verify copies and moves preserve every field for both layouts
+TEST(ProductTest, TestCopyAndMove) {
+	for (size_t thumbnailSize : { size_t{ 3 }, size_t{ 4096 } }) {
+		const Product original(3, 102, "Product 3", "Description 3", makeThumbnail(thumbnailSize));
+
+		Product copy(original);
+		EXPECT_EQ(copy, original);
+
+		Product moved(std::move(copy));
+		EXPECT_EQ(moved, original);
+
+		Product assigned(4, 100, "Other", "Other", {});
+		assigned = moved;
+		EXPECT_EQ(assigned, original);
+		assigned = std::move(moved);
+		EXPECT_EQ(assigned, original);
+	}
+}
+
+// Test case to verify arena-backed products share chunks and copies own their fields
+TEST(ProductTest, TestArenaBackedProducts) {
+	ProductArena arena(4096);
+	const std::string description(100, 'x');
+	const auto thumbnail = makeThumbnail(16);
+
+	std::vector<Product> products;
+	for (uint64_t i = 0; i < 20; ++i) {
+		products.emplace_back(i, 100, "Product " + std::to_string(i), description, thumbnail, arena);
+	}
+
+	EXPECT_EQ(arena.getChunkCount(), 1);
+	EXPECT_GT(arena.getBytesUsed(), 20 * (description.size() + thumbnail.size()));
+
+	Product copy = products[5];
+	products.clear();
+	EXPECT_EQ(copy.getName(), "Product 5");
+	EXPECT_EQ(copy.getDescription(), description);
+	EXPECT_EQ(copy.getThumbnail(), thumbnail);
+}
+
+// Test case to verify a blob larger than a quarter chunk gets its own chunk
+TEST(ProductTest, TestArenaLargeBlobGetsOwnChunk) {
+	ProductArena arena(1024);
+	Product small(1, 100, "Product 1", std::string(100, 's'), {}, arena);
+	Product large(2, 100, "Product 2", "Description 2", makeThumbnail(2048), arena);
+	Product next(3, 100, "Product 3", std::string(100, 'n'), {}, arena);
+
+	EXPECT_EQ(arena.getChunkCount(), 2);
+	EXPECT_EQ(large.getThumbnail(), makeThumbnail(2048));
+	EXPECT_EQ(next.getDescription(), std::string(100, 'n'));
+}
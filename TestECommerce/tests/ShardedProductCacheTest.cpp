@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "ShardedProductCache.h"
+#include "Logger.h"
+#include "TestProducts.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ShardedProductCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		cache = std::make_shared<ShardedProductCache>(64, 4);
+	}
+
+	std::shared_ptr<ShardedProductCache> cache;
+};
+
+// Test case to verify shard count and per-shard capacity are derived from the total budget
+TEST_F(ShardedProductCacheTest, TestShardLayout) {
+	EXPECT_EQ(cache->getShardCount(), 4);
+	EXPECT_EQ(cache->getShardCapacity(), 16);
+
+	ShardedProductCache small(3, 8);
+	EXPECT_EQ(small.getShardCount(), 2) << "Shard count must not exceed capacity and must be a power of two.";
+	EXPECT_EQ(small.getShardCapacity(), 2);
+}
+
+// Test case to verify invalid construction is rejected
+TEST_F(ShardedProductCacheTest, TestZeroCapacityThrows) {
+	EXPECT_THROW(ShardedProductCache(0, 4), std::invalid_argument);
+	EXPECT_THROW(ShardedProductCache(4, 0), std::invalid_argument);
+}
+
+// Test case to verify products can be stored and fetched across shards
+TEST_F(ShardedProductCacheTest, TestPutAndGet) {
+	for (uint64_t i = 1; i <= 32; ++i) {
+		cache->put(i, makeProduct(i));
+	}
+
+	for (uint64_t i = 1; i <= 32; ++i) {
+		auto product = cache->get(i);
+		ASSERT_TRUE(product.has_value()) << "Product " << i << " should be cached.";
+		EXPECT_EQ(product->getId(), i);
+	}
+	EXPECT_FALSE(cache->get(999).has_value());
+}
+
+// Test case to verify a prehashed lookup picks the same shard as the plain ID
+TEST_F(ShardedProductCacheTest, TestPrehashedLookupFindsSameShard) {
+	for (uint64_t i = 1; i <= 32; ++i) {
+		cache->put(i, makeProduct(i));
+	}
+
+	for (uint64_t i = 1; i <= 33; ++i) {
+		const auto product = cache->getTimed(Prehashed<uint64_t>(i)).value;
+		if (i <= 32) {
+			ASSERT_NE(product, nullptr) << "Product " << i << " should be cached.";
+			EXPECT_EQ(product->getId(), i);
+		}
+		else {
+			EXPECT_EQ(product, nullptr);
+		}
+	}
+}
+
+// Test case to verify a single shard keeps LRU eviction semantics
+TEST_F(ShardedProductCacheTest, TestSingleShardEvictsLeastRecentlyUsed) {
+	ShardedProductCache single(3, 1);
+	single.put(1, makeProduct(1));
+	single.put(2, makeProduct(2));
+	single.put(3, makeProduct(3));
+
+	ASSERT_TRUE(single.get(1).has_value());
+	single.put(4, makeProduct(4));
+
+	EXPECT_TRUE(single.get(1).has_value());
+	EXPECT_FALSE(single.get(2).has_value()) << "Least recently used product should have been evicted.";
+}
+
+// Test case to verify the total number of cached products never exceeds the shard budgets
+TEST_F(ShardedProductCacheTest, TestCapacityIsBounded) {
+	for (uint64_t i = 1; i <= 1000; ++i) {
+		cache->put(i, makeProduct(i));
+	}
+
+	size_t cached = 0;
+	for (uint64_t i = 1; i <= 1000; ++i) {
+		cached += cache->get(i).has_value() ? 1 : 0;
+	}
+	EXPECT_LE(cached, cache->getShardCount() * cache->getShardCapacity());
+	EXPECT_GT(cached, 0);
+}
+
+// Test case to verify a capacity that does not divide evenly is not rounded up per shard
+TEST_F(ShardedProductCacheTest, TestUnevenCapacityIsExact) {
+	ShardedProductCache uneven(17, 16);
+	EXPECT_EQ(uneven.getCapacity(), 17);
+	for (uint64_t i = 1; i <= 1000; ++i) {
+		uneven.put(i, makeProduct(i));
+	}
+	EXPECT_EQ(uneven.getMetrics().entries, 17);
+}
+
+// Test case to verify concurrent readers and writers on different shards
+TEST_F(ShardedProductCacheTest, ThreadSafetyWithJThread) {
+	constexpr int threadCount = 8;
+	constexpr int productsPerThread = 8;
+
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < threadCount; ++t) {
+			threads.emplace_back([this, t] {
+				for (int i = 0; i < productsPerThread; ++i) {
+					uint64_t productId = t * productsPerThread + i;
+					cache->put(productId, makeProduct(productId));
+					if (auto product = cache->get(productId)) {
+						EXPECT_EQ(product->getId(), productId);
+					}
+				}
+				});
+		}
+	}
+
+	for (uint64_t i = 0; i < threadCount * productsPerThread; ++i) {
+		if (auto product = cache->get(i)) {
+			EXPECT_EQ(product->getId(), i);
+		}
+	}
+}
+
+// Test case to verify a batch spanning several shards keeps request order
+TEST_F(ShardedProductCacheTest, TestGetManyAcrossShards) {
+	std::vector<uint64_t> productIds;
+	for (uint64_t i = 1; i <= 20; ++i) {
+		if (i % 2 == 0) {
+			cache->put(i, makeProduct(i));
+		}
+		productIds.push_back(i);
+	}
+
+	auto products = cache->getMany(productIds);
+	ASSERT_EQ(products.size(), productIds.size());
+	for (size_t i = 0; i < productIds.size(); ++i) {
+		if (productIds[i] % 2 == 0) {
+			ASSERT_NE(products[i], nullptr);
+			EXPECT_EQ(products[i]->getId(), productIds[i]);
+		}
+		else {
+			EXPECT_EQ(products[i], nullptr);
+		}
+	}
+}
+
+// Test case to verify batch and predicate invalidation reach every shard
+TEST_F(ShardedProductCacheTest, TestInvalidateAcrossShards) {
+	ShardedProductCache sharded(256, 8);
+	for (uint64_t i = 1; i <= 16; ++i) {
+		sharded.put(i, Product(i, 100 + static_cast<uint32_t>(i % 2), "Product " + std::to_string(i), "Description", {}));
+	}
+
+	const std::vector<uint64_t> productIds{ 1, 2, 3, 99 };
+	EXPECT_EQ(sharded.invalidateMany(productIds), 3);
+	EXPECT_FALSE(sharded.get(2).has_value());
+
+	// Odd IDs are in category 101; 1 and 3 are already gone.
+	EXPECT_EQ(sharded.invalidateIf([](const uint64_t&, const Product& product) { return product.getCategory() == 101; }), 6);
+	EXPECT_EQ(sharded.getMetrics().entries, 7);
+	EXPECT_EQ(sharded.getMetrics().invalidations, 9);
+}
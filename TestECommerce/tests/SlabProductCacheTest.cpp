@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "FlatProductIndex.h"
+#include "SlabProductCache.h"
+#include "Logger.h"
+#include "TestProducts.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class SlabProductCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		cache = std::make_shared<SlabProductCache>(3);
+	}
+
+	std::shared_ptr<SlabProductCache> cache;
+};
+
+// Test case to verify keys can be inserted, found and erased
+TEST(FlatProductIndexTest, TestInsertFindErase) {
+	FlatProductIndex index(64);
+	for (uint32_t i = 0; i < 64; ++i) {
+		index.insert(i * 1000003ULL, i);
+	}
+	EXPECT_EQ(index.getSize(), 64);
+
+	for (uint32_t i = 0; i < 64; ++i) {
+		EXPECT_EQ(index.find(i * 1000003ULL), i);
+	}
+	EXPECT_EQ(index.find(7), FlatProductIndex::NOT_FOUND);
+
+	index.erase(1000003ULL);
+	EXPECT_EQ(index.find(1000003ULL), FlatProductIndex::NOT_FOUND);
+	EXPECT_EQ(index.find(2 * 1000003ULL), 2);
+	EXPECT_EQ(index.getSize(), 63);
+}
+
+// Test case to verify heavy churn reuses the table without losing live keys
+TEST(FlatProductIndexTest, TestChurnKeepsLiveKeys) {
+	FlatProductIndex index(32);
+	const size_t slotCount = index.getSlotCount();
+
+	// Keep a sliding window of 32 live keys while 10000 keys pass through.
+	for (uint64_t key = 0; key < 10000; ++key) {
+		if (key >= 32) {
+			index.erase(key - 32);
+		}
+		index.insert(key, static_cast<uint32_t>(key));
+	}
+
+	EXPECT_EQ(index.getSize(), 32);
+	EXPECT_EQ(index.getSlotCount(), slotCount);
+	for (uint64_t key = 10000 - 32; key < 10000; ++key) {
+		EXPECT_EQ(index.find(key), static_cast<uint32_t>(key));
+	}
+	EXPECT_EQ(index.find(10000 - 33), FlatProductIndex::NOT_FOUND);
+}
+
+// Test case to verify zero capacity is rejected
+TEST_F(SlabProductCacheTest, TestZeroCapacityThrows) {
+	EXPECT_THROW(SlabProductCache(0), std::invalid_argument);
+}
+
+// Test case to verify adding and fetching a product
+TEST_F(SlabProductCacheTest, TestPutAndGet) {
+	cache->put(1, makeProduct(1));
+
+	auto fetchedProduct = cache->get(1);
+	ASSERT_TRUE(fetchedProduct.has_value());
+	EXPECT_EQ(fetchedProduct->getId(), 1);
+	EXPECT_FALSE(cache->get(2).has_value());
+}
+
+// Test case to verify putting an existing ID replaces the product in place
+TEST_F(SlabProductCacheTest, TestPutOverwritesExisting) {
+	cache->put(1, makeProduct(1));
+	cache->put(1, Product(1, 102, "Renamed", "Updated", {}));
+
+	auto fetchedProduct = cache->get(1);
+	ASSERT_TRUE(fetchedProduct.has_value());
+	EXPECT_EQ(fetchedProduct->getName(), "Renamed");
+	EXPECT_EQ(cache->getSize(), 1);
+}
+
+// Test case to verify the least recently used product is evicted, with hits refreshing recency
+TEST_F(SlabProductCacheTest, TestLeastRecentlyUsedEviction) {
+	for (uint64_t i = 1; i <= 3; ++i) {
+		cache->put(i, makeProduct(i));
+	}
+	ASSERT_TRUE(cache->getShared(1));
+
+	cache->put(4, makeProduct(4));
+
+	EXPECT_TRUE(cache->getShared(1));
+	EXPECT_FALSE(cache->getShared(2));
+	EXPECT_TRUE(cache->getShared(3));
+	EXPECT_TRUE(cache->getShared(4));
+	EXPECT_EQ(cache->getSize(), 3);
+	EXPECT_EQ(cache->getMetrics().evictions, 1);
+}
+
+// Test case to verify a batch lookup returns hits and misses in request order
+TEST_F(SlabProductCacheTest, TestGetManyMixedHitsAndMisses) {
+	cache->put(1, makeProduct(1));
+	cache->put(3, makeProduct(3));
+
+	const std::array<uint64_t, 3> productIds{ 1, 2, 3 };
+	auto products = cache->getMany(productIds);
+
+	ASSERT_EQ(products.size(), 3);
+	ASSERT_TRUE(products[0]);
+	EXPECT_EQ(products[0]->getId(), 1);
+	EXPECT_FALSE(products[1]);
+	ASSERT_TRUE(products[2]);
+	EXPECT_EQ(products[2]->getId(), 3);
+}
+
+// Test case to verify concurrent readers and writers using jthread
+TEST_F(SlabProductCacheTest, ThreadSafetyWithJThread) {
+	SlabProductCache shared(16);
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < 4; ++t) {
+			threads.emplace_back([&shared] {
+				for (uint64_t i = 0; i < 200; ++i) {
+					if (auto product = shared.get(i % 32)) {
+						EXPECT_EQ(product->getId(), i % 32);
+					}
+					else {
+						shared.put(i % 32, makeProduct(i % 32));
+					}
+				}
+				});
+		}
+	}
+
+	auto metrics = shared.getMetrics();
+	EXPECT_EQ(metrics.hits + metrics.misses, 800);
+	EXPECT_EQ(shared.getSize(), 16);
+}
+
+// Test case to verify invalidating a node keeps the slab dense and the recency order intact
+TEST_F(SlabProductCacheTest, TestInvalidateKeepsRecencyOrder) {
+	for (uint64_t i = 1; i <= 3; ++i) {
+		cache->put(i, makeProduct(i));
+	}
+
+	// Frees the first node; product 3 moves into it.
+	EXPECT_TRUE(cache->invalidate(1));
+	EXPECT_FALSE(cache->invalidate(1));
+	EXPECT_EQ(cache->getSize(), 2);
+
+	cache->put(4, makeProduct(4));
+	EXPECT_EQ(cache->getMetrics().evictions, 0);
+
+	// Recency is now 4, 3, 2: the next insert must evict 2.
+	cache->put(5, makeProduct(5));
+	EXPECT_FALSE(cache->getShared(2));
+	EXPECT_TRUE(cache->getShared(3));
+	EXPECT_TRUE(cache->getShared(4));
+	EXPECT_TRUE(cache->getShared(5));
+
+	EXPECT_EQ(cache->invalidateIf([](const uint64_t& productId, const Product&) { return productId != 4; }), 2);
+	EXPECT_EQ(cache->getSize(), 1);
+	EXPECT_TRUE(cache->getShared(4));
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "StripedSharedMutex.h"
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+// Test case to verify readers on different threads share the lock and a writer excludes them all
+TEST(StripedSharedMutexTest, TestWriterExcludesReadersOnEveryStripe) {
+	StripedSharedMutex mutex;
+	{
+		std::shared_lock readLock(mutex);
+		std::jthread([&mutex] {
+			std::shared_lock otherRead(mutex, std::try_to_lock);
+			EXPECT_TRUE(otherRead.owns_lock());
+			EXPECT_FALSE(mutex.try_lock()) << "A writer must wait for the reader on another stripe.";
+		});
+	}
+
+	std::unique_lock writeLock(mutex);
+	std::vector<std::jthread> readers;
+	for (size_t reader = 0; reader < StripedSharedMutex::STRIPES + 1; ++reader) {
+		readers.emplace_back([&mutex] {
+			EXPECT_FALSE(mutex.try_lock_shared());
+		});
+	}
+}
+
+// Test case to verify writes under the exclusive lock are never observed half done by readers
+TEST(StripedSharedMutexTest, TestReadersSeeConsistentWrites) {
+	StripedSharedMutex mutex;
+	uint64_t first = 0;
+	uint64_t second = 0;
+
+	std::vector<std::jthread> threads;
+	threads.emplace_back([&] {
+		for (uint64_t value = 1; value <= 10'000; ++value) {
+			std::unique_lock writeLock(mutex);
+			first = value;
+			second = value;
+		}
+	});
+	for (int reader = 0; reader < 4; ++reader) {
+		threads.emplace_back([&] {
+			for (int i = 0; i < 10'000; ++i) {
+				std::shared_lock readLock(mutex);
+				ASSERT_EQ(first, second);
+			}
+		});
+	}
+}
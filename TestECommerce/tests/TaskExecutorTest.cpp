@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "TaskExecutor.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+
+// Test case to verify every submitted task runs before the executor is destroyed
+TEST(TaskExecutorTest, TestDestructionDrainsQueue) {
+	std::atomic<int> completed{ 0 };
+	{
+		TaskExecutor executor(ExecutorOptions{ 2, 1000 });
+		for (int i = 0; i < 500; ++i) {
+			ASSERT_TRUE(executor.submit([&completed] { ++completed; }));
+		}
+	}
+	EXPECT_EQ(completed.load(), 500);
+}
+
+// Test case to verify invalid options are rejected
+TEST(TaskExecutorTest, TestZeroWorkersThrows) {
+	EXPECT_THROW(TaskExecutor(ExecutorOptions{ 0, 16 }), std::invalid_argument);
+	EXPECT_THROW(TaskExecutor(ExecutorOptions{ 1, 0 }), std::invalid_argument);
+}
+
+// Test case to verify a full queue rejects new tasks under the REJECT policy
+TEST(TaskExecutorTest, TestRejectWhenFull) {
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	std::latch started(1);
+
+	TaskExecutor executor(ExecutorOptions{ 1, 2, ExecutorOverflowPolicy::REJECT });
+	ASSERT_TRUE(executor.submit([&started, released] { started.count_down(); released.wait(); }));
+	started.wait();
+
+	// The worker is busy, so these two fill the queue.
+	EXPECT_TRUE(executor.submit([] {}));
+	EXPECT_TRUE(executor.submit([] {}));
+	EXPECT_FALSE(executor.submit([] {}));
+	EXPECT_FALSE(executor.trySubmit([] {}));
+	EXPECT_EQ(executor.getQueuedCount(), 2);
+	EXPECT_EQ(executor.getRejectedCount(), 2);
+
+	release.set_value();
+}
+
+// Test case to verify the BLOCK policy makes the submitter wait for a free slot
+TEST(TaskExecutorTest, TestBlockWhenFull) {
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	std::latch started(1);
+
+	TaskExecutor executor(ExecutorOptions{ 1, 1, ExecutorOverflowPolicy::BLOCK });
+	ASSERT_TRUE(executor.submit([&started, released] { started.count_down(); released.wait(); }));
+	started.wait();
+	ASSERT_TRUE(executor.submit([] {}));
+	EXPECT_FALSE(executor.trySubmit([] {}));
+
+	std::atomic<bool> submitted{ false };
+	std::jthread submitter([&executor, &submitted] {
+		EXPECT_TRUE(executor.submit([] {}));
+		submitted = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	EXPECT_FALSE(submitted.load()) << "submit() must wait while the queue is full.";
+
+	release.set_value();
+	submitter.join();
+	EXPECT_TRUE(submitted.load());
+}
+
+// Test case to verify idle workers steal tasks queued on a busy worker
+TEST(TaskExecutorTest, TestIdleWorkersSteal) {
+	constexpr int workers = 4;
+	std::latch allRunning(workers);
+	std::promise<void> done;
+	auto finished = done.get_future();
+
+	TaskExecutor executor(ExecutorOptions{ workers, 64 });
+	// Tasks submitted from a worker land on its own queue; they can only all run
+	// at once, as the latch requires, if the other workers steal them.
+	ASSERT_TRUE(executor.submit([&executor, &allRunning, &done] {
+		for (int i = 0; i < workers - 1; ++i) {
+			EXPECT_TRUE(executor.submit([&allRunning] { allRunning.arrive_and_wait(); }));
+		}
+		allRunning.arrive_and_wait();
+		done.set_value();
+	}));
+
+	EXPECT_EQ(finished.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
@@ -0,0 +1,23 @@
+#ifndef TEST_CLOCK_H
+#define TEST_CLOCK_H
+
+#include "CoarseClock.h"
+
+// Pins CoarseClock::now() for the scope of a test, which moves it with
+// CoarseClock::advance(). The clock goes back to steady_clock when the guard is
+// destroyed, even if an ASSERT_* returned early, so later tests are unaffected.
+class ScopedManualClock {
+public:
+	explicit ScopedManualClock(CoarseClock::time_point start = CoarseClock::now()) {
+		CoarseClock::setTime(start);
+	}
+
+	~ScopedManualClock() {
+		CoarseClock::stop();
+	}
+
+	ScopedManualClock(const ScopedManualClock&) = delete;
+	ScopedManualClock& operator=(const ScopedManualClock&) = delete;
+};
+
+#endif // TEST_CLOCK_H
@@ -0,0 +1,22 @@
+#ifndef TEST_PRODUCTS_H
+#define TEST_PRODUCTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Product.h"
+
+// Small product whose fields all follow from its ID; odd IDs are in category
+// 101 and even ones in 100, for tests that invalidate by category.
+inline Product makeProduct(uint64_t productId, const std::string& name = "Product") {
+	return Product(productId, 100 + static_cast<uint32_t>(productId % 2), name + " " + std::to_string(productId),
+		"Description " + std::to_string(productId), std::vector{ std::byte{ 'A' }, std::byte{ 'B' }, std::byte{ 'C' } });
+}
+
+inline std::shared_ptr<const Product> makeSharedProduct(uint64_t productId, const std::string& name = "Product") {
+	return std::make_shared<const Product>(makeProduct(productId, name));
+}
+
+#endif // TEST_PRODUCTS_H
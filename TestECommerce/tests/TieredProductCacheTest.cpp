@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "TieredProductCache.h"
+#include "TestProducts.h"
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TieredProductCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		cache = std::make_unique<TieredProductCache>(std::make_unique<ProductCache>(2), LogStoreOptions{ .segmentBytes = 4096, .maxBytes = 1024 * 1024 });
+	}
+
+	std::unique_ptr<TieredProductCache> cache;
+};
+
+// Test case to verify products evicted from memory are demoted to disk and promoted back on a hit
+TEST_F(TieredProductCacheTest, TestEvictedProductsPromotedFromDisk) {
+	for (uint64_t productId = 1; productId <= 5; ++productId) {
+		cache->put(productId, makeProduct(productId));
+	}
+	cache->flush();
+
+	EXPECT_EQ(cache->getDemotionCount(), 3);
+	EXPECT_EQ(cache->getDiskTierMetrics().entries, 3);
+
+	auto product = cache->get(1);
+	ASSERT_TRUE(product.has_value());
+	EXPECT_EQ(*product, makeProduct(1));
+	EXPECT_EQ(cache->getDiskTierMetrics().hits, 1);
+	EXPECT_EQ(cache->getMemoryTierMetrics().entries, 2);
+	EXPECT_FALSE(cache->get(6).has_value());
+
+	const auto metrics = cache->getMetrics();
+	EXPECT_EQ(metrics.hits, 1);
+	EXPECT_EQ(metrics.misses, 1);
+}
+
+// Test case to verify a promoted product is not rewritten when it is evicted again
+TEST_F(TieredProductCacheTest, TestRepeatedEvictionKeepsDiskCopy) {
+	for (uint64_t productId = 1; productId <= 3; ++productId) {
+		cache->put(productId, makeProduct(productId));
+	}
+	cache->flush();
+	ASSERT_TRUE(cache->get(1).has_value());
+	cache->put(4, makeProduct(4));
+	cache->put(5, makeProduct(5));
+	cache->flush();
+
+	// 1, then 2 and 3 once each; 1's second eviction reuses its disk copy.
+	EXPECT_EQ(cache->getDemotionCount(), 3);
+	EXPECT_EQ(*cache->get(1), makeProduct(1));
+}
+
+// Test case to verify putting a product replaces its stale copy on disk
+TEST_F(TieredProductCacheTest, TestPutReplacesDiskCopy) {
+	cache->put(1, makeProduct(1, "Old"));
+	cache->put(2, makeProduct(2));
+	cache->put(3, makeProduct(3));
+	cache->flush();
+	ASSERT_EQ(cache->getDiskTierMetrics().entries, 1);
+
+	cache->put(1, makeProduct(1, "New"));
+	EXPECT_EQ(cache->getDiskTierMetrics().invalidations, 1);
+	cache->put(4, makeProduct(4));
+	cache->put(5, makeProduct(5));
+	cache->flush();
+
+	EXPECT_EQ(cache->get(1)->getName(), "New 1");
+}
+
+// Test case to verify invalidation removes products from both tiers
+TEST_F(TieredProductCacheTest, TestInvalidateAcrossTiers) {
+	for (uint64_t productId = 1; productId <= 6; ++productId) {
+		cache->put(productId, makeProduct(productId));
+	}
+	cache->flush();
+
+	EXPECT_TRUE(cache->invalidate(1));
+	EXPECT_TRUE(cache->invalidate(6));
+	EXPECT_FALSE(cache->invalidate(1));
+	EXPECT_FALSE(cache->get(1).has_value());
+	EXPECT_FALSE(cache->get(6).has_value());
+
+	// Odd IDs are in category 101: 3 on disk and 5 in memory.
+	EXPECT_EQ(cache->invalidateIf([](const uint64_t&, const Product& product) { return product.getCategory() == 101; }), 2);
+	EXPECT_FALSE(cache->get(3).has_value());
+	EXPECT_FALSE(cache->get(5).has_value());
+	EXPECT_TRUE(cache->get(2).has_value());
+	EXPECT_TRUE(cache->get(4).has_value());
+}
+
+// Test case to verify a product held in both tiers counts as one invalidation
+TEST_F(TieredProductCacheTest, TestInvalidationCountsEachProductOnce) {
+	const auto fillBothTiers = [this] {
+		for (uint64_t productId = 1; productId <= 3; ++productId) {
+			cache->put(productId, makeProduct(productId));
+		}
+		cache->flush();
+		// Promotes 1, which keeps its disk copy, and demotes 2: 1 is in both tiers
+		ASSERT_TRUE(cache->get(1).has_value());
+		cache->flush();
+		ASSERT_EQ(cache->getDiskTierMetrics().entries, 2);
+		ASSERT_EQ(cache->getMemoryTierMetrics().entries, 2);
+	};
+
+	fillBothTiers();
+	const std::vector<uint64_t> productIds{ 1, 2, 3, 4 };
+	EXPECT_EQ(cache->invalidateMany(productIds), 3);
+
+	fillBothTiers();
+	EXPECT_EQ(cache->invalidateIf([](const uint64_t&, const Product&) { return true; }), 3);
+	EXPECT_EQ(cache->getMetrics().invalidations, 6);
+}
+
+// Test case to verify a batch get combines memory and disk hits
+TEST_F(TieredProductCacheTest, TestGetManyAcrossTiers) {
+	for (uint64_t productId = 1; productId <= 4; ++productId) {
+		cache->put(productId, makeProduct(productId));
+	}
+	cache->flush();
+
+	const std::vector<uint64_t> productIds{ 4, 1, 9, 2 };
+	auto products = cache->getMany(productIds);
+	ASSERT_EQ(products.size(), 4);
+	EXPECT_EQ(*products[0], makeProduct(4));
+	EXPECT_EQ(*products[1], makeProduct(1));
+	EXPECT_EQ(products[2], nullptr);
+	EXPECT_EQ(*products[3], makeProduct(2));
+	EXPECT_EQ(cache->getMetrics().hits, 3);
+	EXPECT_EQ(cache->getMetrics().misses, 1);
+}
+
+// Test case to verify promotions racing puts and invalidations never leave an old copy behind
+TEST_F(TieredProductCacheTest, TestPromotionRacingUpdatesKeepsLatest) {
+	constexpr uint64_t productCount = 8;
+	constexpr int rounds = 200;
+
+	std::atomic<bool> done{ false };
+	{
+		// The memory tier holds two products, so these reads keep promoting from the lower tiers.
+		std::vector<std::jthread> readers;
+		for (int reader = 0; reader < 2; ++reader) {
+			readers.emplace_back([this, &done] {
+				while (!done.load()) {
+					for (uint64_t productId = 1; productId <= productCount; ++productId) {
+						(void)cache->getShared(productId);
+					}
+				}
+			});
+		}
+
+		for (int round = 1; round <= rounds; ++round) {
+			for (uint64_t productId = 1; productId <= productCount; ++productId) {
+				cache->put(productId, makeProduct(productId, "Version" + std::to_string(round)));
+			}
+			for (uint64_t productId = 2; productId <= productCount; productId += 2) {
+				cache->invalidate(productId);
+			}
+		}
+		done.store(true);
+	}
+	cache->flush();
+
+	for (uint64_t productId = 1; productId <= productCount; ++productId) {
+		const auto product = cache->get(productId);
+		if (productId % 2 == 0) {
+			EXPECT_FALSE(product.has_value()) << "Product " << productId;
+		}
+		else if (product) {
+			// An undone promotion may drop the latest copy, but never bring back an older one.
+			EXPECT_EQ(product->getName(), "Version" + std::to_string(rounds) + " " + std::to_string(productId));
+		}
+	}
+}
+
+// Test case to verify a tiered cache needs a memory tier
+TEST_F(TieredProductCacheTest, TestNullMemoryTierThrows) {
+	EXPECT_THROW(TieredProductCache(nullptr, LogStoreOptions{}), std::invalid_argument);
+}
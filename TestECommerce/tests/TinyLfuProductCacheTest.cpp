@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "FrequencySketch.h"
+#include "ShardedProductCache.h"
+#include "TinyLfuProductCache.h"
+#include "Logger.h"
+#include "TestProducts.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TinyLfuProductCacheTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		cache = std::make_shared<TinyLfuProductCache>(100);
+	}
+
+	// Read-through access, as ProductService drives the cache.
+	void access(uint64_t productId) {
+		if (!cache->get(productId)) {
+			cache->put(productId, makeProduct(productId));
+		}
+	}
+
+	std::shared_ptr<TinyLfuProductCache> cache;
+};
+
+// Test case to verify the sketch counts keys and saturates at its maximum
+TEST(FrequencySketchTest, TestIncrementAndSaturate) {
+	FrequencySketch sketch(1024);
+	EXPECT_EQ(sketch.frequency(7), 0);
+
+	for (int i = 0; i < 3; ++i) {
+		sketch.increment(7);
+	}
+	EXPECT_EQ(sketch.frequency(7), 3);
+
+	for (int i = 0; i < 100; ++i) {
+		sketch.increment(8);
+	}
+	EXPECT_EQ(sketch.frequency(8), FrequencySketch::MAX_FREQUENCY);
+}
+
+// Test case to verify counters are halved once the sample size is reached
+TEST(FrequencySketchTest, TestAging) {
+	FrequencySketch sketch(16);
+	for (int i = 0; i < 8; ++i) {
+		sketch.increment(1);
+	}
+	ASSERT_EQ(sketch.frequency(1), 8);
+
+	// Distinct keys push the sketch past its sample size. Collisions may raise the
+	// estimate before the reset, but it only falls below 8 when the counters are halved.
+	for (uint64_t key = 1000; sketch.frequency(1) >= 8 && key < 1000 + sketch.getSampleSize(); ++key) {
+		sketch.increment(key);
+	}
+	EXPECT_LT(sketch.frequency(1), 8);
+	EXPECT_GE(sketch.frequency(1), 4);
+}
+
+// Test case to verify zero capacity is rejected
+TEST_F(TinyLfuProductCacheTest, TestZeroCapacityThrows) {
+	EXPECT_THROW(TinyLfuProductCache(0), std::invalid_argument);
+}
+
+// Test case to verify adding and fetching a product
+TEST_F(TinyLfuProductCacheTest, TestPutAndGet) {
+	cache->put(1, makeProduct(1));
+
+	auto fetchedProduct = cache->get(1);
+	ASSERT_TRUE(fetchedProduct.has_value());
+	EXPECT_EQ(fetchedProduct->getId(), 1);
+	EXPECT_FALSE(cache->get(2).has_value());
+}
+
+// Test case to verify putting an existing ID replaces the product
+TEST_F(TinyLfuProductCacheTest, TestPutOverwritesExisting) {
+	cache->put(1, makeProduct(1));
+	cache->put(1, Product(1, 102, "Renamed", "Updated", {}));
+
+	auto fetchedProduct = cache->get(1);
+	ASSERT_TRUE(fetchedProduct.has_value());
+	EXPECT_EQ(fetchedProduct->getName(), "Renamed");
+}
+
+// Test case to verify the cache never holds more than its capacity
+TEST_F(TinyLfuProductCacheTest, TestCacheCapacity) {
+	for (uint64_t i = 1; i <= 500; ++i) {
+		cache->put(i, makeProduct(i));
+	}
+
+	size_t cached = 0;
+	for (uint64_t i = 1; i <= 500; ++i) {
+		cached += cache->getShared(i) ? 1 : 0;
+	}
+	EXPECT_EQ(cached, 100);
+	EXPECT_EQ(cache->getMetrics().evictions, 400);
+}
+
+// Test case to verify a one-off scan does not flush frequently requested products
+TEST_F(TinyLfuProductCacheTest, TestScanResistance) {
+	for (int round = 0; round < 5; ++round) {
+		for (uint64_t productId = 1; productId <= 50; ++productId) {
+			access(productId);
+		}
+	}
+	for (uint64_t productId = 1000; productId < 1500; ++productId) {
+		access(productId);
+	}
+
+	size_t hotSurvivors = 0;
+	for (uint64_t productId = 1; productId <= 50; ++productId) {
+		hotSurvivors += cache->getShared(productId) ? 1 : 0;
+	}
+	EXPECT_EQ(hotSurvivors, 50) << "Scanned products should not have been admitted over the hot set.";
+}
+
+// Test case to verify concurrent readers and a writer using jthread
+TEST_F(TinyLfuProductCacheTest, ThreadSafetyWithJThread) {
+	TinyLfuProductCache shared(16);
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < 4; ++t) {
+			threads.emplace_back([&shared] {
+				for (uint64_t i = 0; i < 200; ++i) {
+					if (auto product = shared.get(i % 32)) {
+						EXPECT_EQ(product->getId(), i % 32);
+					}
+					else {
+						shared.put(i % 32, makeProduct(i % 32));
+					}
+				}
+				});
+		}
+	}
+
+	auto metrics = shared.getMetrics();
+	EXPECT_EQ(metrics.hits + metrics.misses, 800);
+}
+
+// Test case to verify the sharded cache can be built from W-TinyLFU shards
+TEST_F(TinyLfuProductCacheTest, TestShardedTinyLfuMode) {
+	ShardedProductCache sharded(512, 4, EvictionMode::TINY_LFU);
+	EXPECT_EQ(sharded.getEvictionMode(), EvictionMode::TINY_LFU);
+
+	for (uint64_t i = 1; i <= 32; ++i) {
+		sharded.put(i, makeProduct(i));
+	}
+	for (uint64_t i = 1; i <= 32; ++i) {
+		auto product = sharded.get(i);
+		ASSERT_TRUE(product.has_value());
+		EXPECT_EQ(product->getId(), i);
+	}
+	EXPECT_EQ(sharded.getMetrics().hits, 32);
+}